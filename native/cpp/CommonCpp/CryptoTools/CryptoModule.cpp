@@ -2,6 +2,9 @@
 #include "PlatformSpecificTools.h"
 #include "olm/session.hh"
 
+#include <algorithm>
+#include <cctype>
+
 namespace comm {
 namespace crypto {
 
@@ -53,20 +56,26 @@ void CryptoModule::exposePublicIdentityKeys() {
 }
 
 void CryptoModule::generateOneTimeKeys(size_t oneTimeKeysAmount) {
-  size_t oneTimeKeysSize = ::olm_account_generate_one_time_keys_random_length(
-      this->account, oneTimeKeysAmount);
-  if (this->keys.oneTimeKeys.size() == oneTimeKeysSize) {
+  // olm discards the oldest keys once it holds more than the maximum
+  oneTimeKeysAmount = std::min(
+      oneTimeKeysAmount,
+      ::olm_account_max_number_of_one_time_keys(this->account));
+  if (this->unpublishedOneTimeKeys >= oneTimeKeysAmount) {
     return;
   }
+  size_t missingOneTimeKeys = oneTimeKeysAmount - this->unpublishedOneTimeKeys;
+  size_t oneTimeKeysSize = ::olm_account_generate_one_time_keys_random_length(
+      this->account, missingOneTimeKeys);
   OlmBuffer random;
   PlatformSpecificTools::generateSecureRandomBytes(random, oneTimeKeysSize);
 
   if (-1 ==
       ::olm_account_generate_one_time_keys(
-          this->account, oneTimeKeysAmount, random.data(), random.size())) {
+          this->account, missingOneTimeKeys, random.data(), random.size())) {
     throw std::runtime_error(
         "error generateOneTimeKeys => ::olm_account_generate_one_time_keys");
   }
+  this->unpublishedOneTimeKeys += missingOneTimeKeys;
 }
 
 // returns number of published keys
@@ -84,6 +93,80 @@ size_t CryptoModule::publishOneTimeKeys() {
   return ::olm_account_mark_keys_as_published(this->account);
 }
 
+size_t CryptoModule::countUnpublishedOneTimeKeys() {
+  OlmBuffer oneTimeKeys(::olm_account_one_time_keys_length(this->account));
+  if (-1 ==
+      ::olm_account_one_time_keys(
+          this->account, oneTimeKeys.data(), oneTimeKeys.size())) {
+    throw std::runtime_error(
+        "error countUnpublishedOneTimeKeys => ::olm_account_one_time_keys");
+  }
+  // olm lists the keys as {"curve25519":{"keyId":"key",...}}, both the ids
+  // and the keys are base64 so the strings never contain escapes
+  const std::string json(oneTimeKeys.begin(), oneTimeKeys.end());
+  size_t position = 0;
+  auto invalidJson = []() {
+    return std::runtime_error(
+        "error countUnpublishedOneTimeKeys => invalid one-time keys json");
+  };
+  auto peek = [&]() {
+    while (position < json.size() &&
+           std::isspace(static_cast<unsigned char>(json[position]))) {
+      ++position;
+    }
+    if (position == json.size()) {
+      throw invalidJson();
+    }
+    return json[position];
+  };
+  auto expect = [&](const char expected) {
+    if (peek() != expected) {
+      throw invalidJson();
+    }
+    ++position;
+  };
+  auto readString = [&]() {
+    expect('"');
+    const size_t end = json.find('"', position);
+    if (end == std::string::npos) {
+      throw invalidJson();
+    }
+    const std::string result = json.substr(position, end - position);
+    position = end + 1;
+    return result;
+  };
+
+  expect('{');
+  if (readString() != "curve25519") {
+    throw invalidJson();
+  }
+  expect(':');
+  expect('{');
+  size_t count = 0;
+  if (peek() == '}') {
+    ++position;
+  } else {
+    while (true) {
+      readString();
+      expect(':');
+      readString();
+      ++count;
+      if (peek() == '}') {
+        ++position;
+        break;
+      }
+      expect(',');
+    }
+  }
+  expect('}');
+  if (count > ::olm_account_max_number_of_one_time_keys(this->account)) {
+    throw std::runtime_error(
+        "error countUnpublishedOneTimeKeys => more keys than the account "
+        "holds");
+  }
+  return count;
+}
+
 Keys CryptoModule::keysFromStrings(
     const std::string &identityKeys,
     const std::string &oneTimeKeys) {
@@ -101,18 +184,34 @@ std::string CryptoModule::getIdentityKeys() {
 std::string CryptoModule::getOneTimeKeys(size_t oneTimeKeysAmount) {
   this->generateOneTimeKeys(oneTimeKeysAmount);
   size_t publishedOneTimeKeys = this->publishOneTimeKeys();
-  if (publishedOneTimeKeys != oneTimeKeysAmount) {
+  if (publishedOneTimeKeys != this->unpublishedOneTimeKeys) {
     throw std::runtime_error(
         "error generateKeys => invalid amount of one-time keys published. "
         "Expected " +
-        std::to_string(oneTimeKeysAmount) + ", got " +
+        std::to_string(this->unpublishedOneTimeKeys) + ", got " +
         std::to_string(publishedOneTimeKeys));
   }
+  this->unpublishedOneTimeKeys = 0;
 
   return std::string(
       this->keys.oneTimeKeys.begin(), this->keys.oneTimeKeys.end());
 }
 
+size_t CryptoModule::getUnpublishedOneTimeKeysCount() const {
+  return this->unpublishedOneTimeKeys;
+}
+
+bool CryptoModule::needsOneTimeKeysRefill() const {
+  return this->unpublishedOneTimeKeys < ONE_TIME_KEYS_LOW_WATER_MARK;
+}
+
+void CryptoModule::refillOneTimeKeys() {
+  if (!this->needsOneTimeKeysRefill()) {
+    return;
+  }
+  this->generateOneTimeKeys(ONE_TIME_KEYS_POOL_SIZE);
+}
+
 void CryptoModule::initializeInboundForReceivingSession(
     const std::string &targetUserId,
     const OlmBuffer &encryptedMessage,
@@ -162,27 +261,30 @@ CryptoModule::getSessionByUserId(const std::string &userId) {
 
 bool CryptoModule::matchesInboundSession(
     const std::string &targetUserId,
-    EncryptedData encryptedData,
+    const EncryptedDataView &encryptedData,
     const OlmBuffer &theirIdentityKey) const {
-  OlmSession *session = this->sessions.at(targetUserId)->getOlmSession();
+  const std::shared_ptr<Session> &session = this->sessions.at(targetUserId);
+  OlmSession *olmSession = session->getOlmSession();
   // Check that the inbound session matches the message it was created from.
-  OlmBuffer tmpEncryptedMessage(encryptedData.message);
   if (1 !=
       ::olm_matches_inbound_session(
-          session, tmpEncryptedMessage.data(), tmpEncryptedMessage.size())) {
+          olmSession,
+          session->copyToScratch(
+              encryptedData.message, encryptedData.messageSize),
+          encryptedData.messageSize)) {
     return false;
   }
 
   // Check that the inbound session matches the key this message is supposed
   // to be from.
-  tmpEncryptedMessage = OlmBuffer(encryptedData.message);
   if (1 !=
       ::olm_matches_inbound_session_from(
-          session,
+          olmSession,
           theirIdentityKey.data() + ID_KEYS_PREFIX_OFFSET,
           KEYSIZE,
-          tmpEncryptedMessage.data(),
-          tmpEncryptedMessage.size())) {
+          session->copyToScratch(
+              encryptedData.message, encryptedData.messageSize),
+          encryptedData.messageSize)) {
     return false;
   }
   return true;
@@ -208,6 +310,16 @@ Persist CryptoModule::storeAsB64(const std::string &secretKey) {
     OlmBuffer buffer = it->second->storeAsB64(secretKey);
     persist.sessions.insert(make_pair(it->first, buffer));
   }
+  for (auto &outboundGroupSession : this->outboundGroupSessions) {
+    persist.outboundGroupSessions.insert(make_pair(
+        outboundGroupSession.first,
+        outboundGroupSession.second->storeAsB64(secretKey)));
+  }
+  for (auto &inboundGroupSession : this->inboundGroupSessions) {
+    persist.inboundGroupSessions.insert(make_pair(
+        inboundGroupSession.first,
+        inboundGroupSession.second->storeAsB64(secretKey)));
+  }
 
   return persist;
 }
@@ -230,6 +342,7 @@ void CryptoModule::restoreFromB64(
     throw std::runtime_error(
         "error restoreFromB64 => ::olm_pickle_account_length");
   }
+  this->unpublishedOneTimeKeys = this->countUnpublishedOneTimeKeys();
 
   std::unordered_map<std::string, OlmBuffer>::iterator it;
   for (it = persist.sessions.begin(); it != persist.sessions.end(); ++it) {
@@ -237,6 +350,18 @@ void CryptoModule::restoreFromB64(
         this->account, this->keys.identityKeys.data(), secretKey, it->second);
     this->sessions.insert(make_pair(it->first, move(session)));
   }
+  for (auto &outboundGroupSession : persist.outboundGroupSessions) {
+    this->outboundGroupSessions.insert(make_pair(
+        outboundGroupSession.first,
+        OutboundGroupSession::restoreFromB64(
+            secretKey, outboundGroupSession.second)));
+  }
+  for (auto &inboundGroupSession : persist.inboundGroupSessions) {
+    this->inboundGroupSessions.insert(make_pair(
+        inboundGroupSession.first,
+        InboundGroupSession::restoreFromB64(
+            secretKey, inboundGroupSession.second)));
+  }
 }
 
 EncryptedData CryptoModule::encrypt(
@@ -268,14 +393,23 @@ EncryptedData CryptoModule::encrypt(
 
 std::string CryptoModule::decrypt(
     const std::string &targetUserId,
-    EncryptedData encryptedData,
+    const EncryptedDataView &encryptedData,
     const OlmBuffer &theirIdentityKey) {
+  size_t decryptedSize = this->decrypt(
+      targetUserId, encryptedData, theirIdentityKey, this->decryptedMessage);
+  return std::string((char *)this->decryptedMessage.data(), decryptedSize);
+}
+
+size_t CryptoModule::decrypt(
+    const std::string &targetUserId,
+    const EncryptedDataView &encryptedData,
+    const OlmBuffer &theirIdentityKey,
+    OlmBuffer &plaintext) {
   if (!this->hasSessionFor(targetUserId)) {
     throw std::runtime_error("error decrypt => uninitialized session");
   }
-  OlmSession *session = this->sessions.at(targetUserId)->getOlmSession();
-
-  OlmBuffer tmpEncryptedMessage(encryptedData.message);
+  const std::shared_ptr<Session> &session = this->sessions.at(targetUserId);
+  OlmSession *olmSession = session->getOlmSession();
 
   if (encryptedData.messageType == (size_t)olm::MessageType::PRE_KEY) {
     if (!this->matchesInboundSession(
@@ -285,22 +419,139 @@ std::string CryptoModule::decrypt(
   }
 
   size_t maxSize = ::olm_decrypt_max_plaintext_length(
-      session,
+      olmSession,
       encryptedData.messageType,
-      tmpEncryptedMessage.data(),
-      tmpEncryptedMessage.size());
-  OlmBuffer decryptedMessage(maxSize);
+      session->copyToScratch(encryptedData.message, encryptedData.messageSize),
+      encryptedData.messageSize);
+  if (maxSize == -1) {
+    throw std::runtime_error("error ::olm_decrypt_max_plaintext_length");
+  }
+  plaintext.resize(maxSize);
   size_t decryptedSize = ::olm_decrypt(
-      session,
+      olmSession,
       encryptedData.messageType,
-      encryptedData.message.data(),
-      encryptedData.message.size(),
-      decryptedMessage.data(),
-      decryptedMessage.size());
+      session->copyToScratch(encryptedData.message, encryptedData.messageSize),
+      encryptedData.messageSize,
+      plaintext.data(),
+      plaintext.size());
   if (decryptedSize == -1) {
     throw std::runtime_error("error ::olm_decrypt");
   }
-  return std::string((char *)decryptedMessage.data(), decryptedSize);
+  return decryptedSize;
+}
+
+std::string CryptoModule::getInboundGroupSessionKey(
+    const OlmBuffer &senderIdentityKeys,
+    const std::string &sessionId) {
+  if (senderIdentityKeys.size() < ID_KEYS_PREFIX_OFFSET + KEYSIZE) {
+    throw std::runtime_error(
+        "error getInboundGroupSessionKey => invalid identity keys");
+  }
+  // the base64 encoded keys and ids never contain the separator
+  return std::string(
+             senderIdentityKeys.begin() + ID_KEYS_PREFIX_OFFSET,
+             senderIdentityKeys.begin() + ID_KEYS_PREFIX_OFFSET + KEYSIZE) +
+      ":" + sessionId;
+}
+
+std::string
+CryptoModule::initializeOutboundGroupSession(const std::string &threadId) {
+  std::shared_ptr<OutboundGroupSession> session =
+      OutboundGroupSession::create();
+  this->outboundGroupSessions[threadId] = session;
+  if (this->outboundGroupSessionChanged) {
+    this->outboundGroupSessionChanged(threadId);
+  }
+  return session->getSessionKey();
+}
+
+bool CryptoModule::hasOutboundGroupSessionFor(const std::string &threadId) {
+  return (
+      this->outboundGroupSessions.find(threadId) !=
+      this->outboundGroupSessions.end());
+}
+
+std::string
+CryptoModule::getOutboundGroupSessionKey(const std::string &threadId) {
+  if (!this->hasOutboundGroupSessionFor(threadId)) {
+    throw std::runtime_error(
+        "error getOutboundGroupSessionKey => uninitialized group session");
+  }
+  // the key contains the current ratchet state so members that receive it
+  // can't decrypt messages sent before they got it
+  return this->outboundGroupSessions.at(threadId)->getSessionKey();
+}
+
+OlmBuffer CryptoModule::storeOutboundGroupSessionAsB64(
+    const std::string &threadId,
+    const std::string &secretKey) {
+  if (!this->hasOutboundGroupSessionFor(threadId)) {
+    throw std::runtime_error(
+        "error storeOutboundGroupSessionAsB64 => uninitialized group session");
+  }
+  return this->outboundGroupSessions.at(threadId)->storeAsB64(secretKey);
+}
+
+void CryptoModule::setOutboundGroupSessionChangedCallback(
+    std::function<void(const std::string &threadId)> callback) {
+  this->outboundGroupSessionChanged = std::move(callback);
+}
+
+std::string CryptoModule::initializeInboundGroupSession(
+    const OlmBuffer &senderIdentityKeys,
+    const std::string &sessionKey) {
+  std::shared_ptr<InboundGroupSession> session =
+      InboundGroupSession::create(sessionKey);
+  std::string sessionId = session->getSessionId();
+  std::shared_ptr<InboundGroupSession> &storedSession =
+      this->inboundGroupSessions[getInboundGroupSessionKey(
+          senderIdentityKeys, sessionId)];
+  // a key shared later holds a more advanced ratchet, it must not replace the
+  // session which can still decrypt the earlier messages
+  if (storedSession == nullptr ||
+      session->getFirstKnownIndex() < storedSession->getFirstKnownIndex()) {
+    storedSession = session;
+  }
+  return sessionId;
+}
+
+bool CryptoModule::hasInboundGroupSession(
+    const OlmBuffer &senderIdentityKeys,
+    const std::string &sessionId) {
+  return (
+      this->inboundGroupSessions.find(
+          getInboundGroupSessionKey(senderIdentityKeys, sessionId)) !=
+      this->inboundGroupSessions.end());
+}
+
+GroupEncryptedData CryptoModule::groupEncrypt(
+    const std::string &threadId,
+    const std::string &content) {
+  if (!this->hasOutboundGroupSessionFor(threadId)) {
+    throw std::runtime_error("error groupEncrypt => uninitialized session");
+  }
+  std::shared_ptr<OutboundGroupSession> &session =
+      this->outboundGroupSessions.at(threadId);
+  GroupEncryptedData encryptedData = {
+      session->encrypt(content), session->getSessionId()};
+  if (this->outboundGroupSessionChanged) {
+    this->outboundGroupSessionChanged(threadId);
+  }
+  return encryptedData;
+}
+
+std::string CryptoModule::groupDecrypt(
+    const GroupEncryptedData &encryptedData,
+    const OlmBuffer &senderIdentityKeys,
+    std::uint32_t &messageIndex) {
+  if (!this->hasInboundGroupSession(
+          senderIdentityKeys, encryptedData.sessionId)) {
+    throw std::runtime_error("error groupDecrypt => uninitialized session");
+  }
+  return this->inboundGroupSessions
+      .at(getInboundGroupSessionKey(
+          senderIdentityKeys, encryptedData.sessionId))
+      ->decrypt(encryptedData.message, messageIndex);
 }
 
 } // namespace crypto
@@ -1,11 +1,13 @@
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <unordered_map>
 
 #include "olm/olm.h"
 
+#include "GroupSession.h"
 #include "Persist.h"
 #include "Session.h"
 #include "Tools.h"
@@ -19,14 +21,36 @@ class CryptoModule {
   OlmBuffer accountBuffer;
 
   std::unordered_map<std::string, std::shared_ptr<Session>> sessions = {};
+  // one outbound group session per thread, inbound group sessions are kept
+  // by the sender's identity key and their session ids, see
+  // `getInboundGroupSessionKey`
+  std::unordered_map<std::string, std::shared_ptr<OutboundGroupSession>>
+      outboundGroupSessions = {};
+  std::unordered_map<std::string, std::shared_ptr<InboundGroupSession>>
+      inboundGroupSessions = {};
+
+  std::function<void(const std::string &threadId)>
+      outboundGroupSessionChanged;
 
   Keys keys;
+  // the plaintext of the string `decrypt`, kept so its capacity is reused
+  OlmBuffer decryptedMessage;
+
+  // generated keys that haven't been published yet, those are handed out by
+  // `getOneTimeKeys` without having to generate anything
+  size_t unpublishedOneTimeKeys = 0;
 
   void createAccount();
   void exposePublicIdentityKeys();
   void generateOneTimeKeys(size_t oneTimeKeysAmount);
   // returns number of published keys
   size_t publishOneTimeKeys();
+  size_t countUnpublishedOneTimeKeys();
+  // a session key can only be used for the messages of the sender whose
+  // pairwise session delivered it
+  static std::string getInboundGroupSessionKey(
+      const OlmBuffer &senderIdentityKeys,
+      const std::string &sessionId);
 
 public:
   const std::string id;
@@ -38,7 +62,15 @@ public:
       const std::string &oneTimeKeys);
 
   std::string getIdentityKeys();
-  std::string getOneTimeKeys(size_t oneTimeKeysAmount = 50);
+  // returns at least `oneTimeKeysAmount` keys, all the keys from the pool get
+  // published
+  std::string
+  getOneTimeKeys(size_t oneTimeKeysAmount = ONE_TIME_KEYS_POOL_SIZE);
+  size_t getUnpublishedOneTimeKeysCount() const;
+  bool needsOneTimeKeysRefill() const;
+  // tops the pool up to ONE_TIME_KEYS_POOL_SIZE, meant to be run in the
+  // background after the keys have been handed out
+  void refillOneTimeKeys();
 
   void initializeInboundForReceivingSession(
       const std::string &targetUserId,
@@ -54,7 +86,7 @@ public:
   std::shared_ptr<Session> getSessionByUserId(const std::string &userId);
   bool matchesInboundSession(
       const std::string &targetUserId,
-      EncryptedData encryptedData,
+      const EncryptedDataView &encryptedData,
       const OlmBuffer &theirIdentityKey) const;
 
   Persist storeAsB64(const std::string &secretKey);
@@ -62,10 +94,56 @@ public:
 
   EncryptedData
   encrypt(const std::string &targetUserId, const std::string &content);
+  // decrypts into a buffer kept by the module, only the returned string is
+  // allocated
   std::string decrypt(
       const std::string &targetUserId,
-      EncryptedData encryptedData,
+      const EncryptedDataView &encryptedData,
       const OlmBuffer &theirIdentityKey);
+  // writes the decrypted message to `plaintext` and returns its length,
+  // `plaintext` is only resized within its capacity when it is reused, so
+  // decrypting with the same buffer doesn't allocate
+  size_t decrypt(
+      const std::string &targetUserId,
+      const EncryptedDataView &encryptedData,
+      const OlmBuffer &theirIdentityKey,
+      OlmBuffer &plaintext);
+
+  // creates a new group session for the thread, replacing the previous one,
+  // and returns its session key which has to be sent to every member of the
+  // thread with `encrypt`
+  std::string initializeOutboundGroupSession(const std::string &threadId);
+  bool hasOutboundGroupSessionFor(const std::string &threadId);
+  std::string getOutboundGroupSessionKey(const std::string &threadId);
+  OlmBuffer storeOutboundGroupSessionAsB64(
+      const std::string &threadId,
+      const std::string &secretKey);
+  // called with the thread id whenever its outbound group session is created
+  // or its ratchet advances, before the session key or the message is
+  // returned, so the session can be persisted before anything is sent and a
+  // restart can't reuse a message index
+  void setOutboundGroupSessionChangedCallback(
+      std::function<void(const std::string &threadId)> callback);
+  // `senderIdentityKeys` are the identity keys of the member whose pairwise
+  // session delivered the session key, returns the id of the session. When the
+  // sender already shared the session the one which can decrypt the earlier
+  // messages is kept.
+  std::string initializeInboundGroupSession(
+      const OlmBuffer &senderIdentityKeys,
+      const std::string &sessionKey);
+  bool hasInboundGroupSession(
+      const OlmBuffer &senderIdentityKeys,
+      const std::string &sessionId);
+
+  GroupEncryptedData
+  groupEncrypt(const std::string &threadId, const std::string &content);
+  // sets `messageIndex` to the index of the message within the session,
+  // replays are only rejected until the module is restored, see
+  // `InboundGroupSession::decrypt`
+  std::string groupDecrypt(
+      const GroupEncryptedData &encryptedData,
+      const OlmBuffer &senderIdentityKeys,
+      std::uint32_t &messageIndex);
 };
 
 } // namespace crypto
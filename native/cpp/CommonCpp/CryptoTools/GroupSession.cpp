@@ -0,0 +1,212 @@
+#include "GroupSession.h"
+#include "PlatformSpecificTools.h"
+
+namespace comm {
+namespace crypto {
+
+std::unique_ptr<OutboundGroupSession> OutboundGroupSession::create() {
+  std::unique_ptr<OutboundGroupSession> session(new OutboundGroupSession());
+
+  session->olmSessionBuffer.resize(::olm_outbound_group_session_size());
+  session->olmSession =
+      ::olm_outbound_group_session(session->olmSessionBuffer.data());
+
+  OlmBuffer randomBuffer;
+  PlatformSpecificTools::generateSecureRandomBytes(
+      randomBuffer,
+      ::olm_init_outbound_group_session_random_length(session->olmSession));
+
+  if (-1 ==
+      ::olm_init_outbound_group_session(
+          session->olmSession, randomBuffer.data(), randomBuffer.size())) {
+    throw std::runtime_error(
+        "error createOutboundGroup => ::olm_init_outbound_group_session");
+  }
+  return session;
+}
+
+OlmBuffer OutboundGroupSession::encrypt(const std::string &content) {
+  OlmBuffer encryptedMessage(
+      ::olm_group_encrypt_message_length(this->olmSession, content.size()));
+  if (-1 ==
+      ::olm_group_encrypt(
+          this->olmSession,
+          (uint8_t *)content.data(),
+          content.size(),
+          encryptedMessage.data(),
+          encryptedMessage.size())) {
+    throw std::runtime_error("error groupEncrypt => ::olm_group_encrypt");
+  }
+  return encryptedMessage;
+}
+
+std::string OutboundGroupSession::getSessionId() {
+  OlmBuffer sessionId(::olm_outbound_group_session_id_length(this->olmSession));
+  if (-1 ==
+      ::olm_outbound_group_session_id(
+          this->olmSession, sessionId.data(), sessionId.size())) {
+    throw std::runtime_error(
+        "error getSessionId => ::olm_outbound_group_session_id");
+  }
+  return std::string(sessionId.begin(), sessionId.end());
+}
+
+std::string OutboundGroupSession::getSessionKey() {
+  OlmBuffer sessionKey(
+      ::olm_outbound_group_session_key_length(this->olmSession));
+  if (-1 ==
+      ::olm_outbound_group_session_key(
+          this->olmSession, sessionKey.data(), sessionKey.size())) {
+    throw std::runtime_error(
+        "error getSessionKey => ::olm_outbound_group_session_key");
+  }
+  return std::string(sessionKey.begin(), sessionKey.end());
+}
+
+std::uint32_t OutboundGroupSession::getMessageIndex() {
+  return ::olm_outbound_group_session_message_index(this->olmSession);
+}
+
+OlmBuffer OutboundGroupSession::storeAsB64(const std::string &secretKey) {
+  size_t pickleLength =
+      ::olm_pickle_outbound_group_session_length(this->olmSession);
+  OlmBuffer pickle(pickleLength);
+  size_t res = ::olm_pickle_outbound_group_session(
+      this->olmSession,
+      secretKey.data(),
+      secretKey.size(),
+      pickle.data(),
+      pickleLength);
+  if (pickleLength != res) {
+    throw std::runtime_error(
+        "error pickleOutboundGroupSession => "
+        "::olm_pickle_outbound_group_session");
+  }
+  return pickle;
+}
+
+std::unique_ptr<OutboundGroupSession> OutboundGroupSession::restoreFromB64(
+    const std::string &secretKey,
+    OlmBuffer &b64) {
+  std::unique_ptr<OutboundGroupSession> session(new OutboundGroupSession());
+
+  session->olmSessionBuffer.resize(::olm_outbound_group_session_size());
+  session->olmSession =
+      ::olm_outbound_group_session(session->olmSessionBuffer.data());
+  if (-1 ==
+      ::olm_unpickle_outbound_group_session(
+          session->olmSession,
+          secretKey.data(),
+          secretKey.size(),
+          b64.data(),
+          b64.size())) {
+    throw std::runtime_error(
+        "error pickleOutboundGroupSession => "
+        "::olm_unpickle_outbound_group_session");
+  }
+  return session;
+}
+
+std::unique_ptr<InboundGroupSession>
+InboundGroupSession::create(const std::string &sessionKey) {
+  std::unique_ptr<InboundGroupSession> session(new InboundGroupSession());
+
+  session->olmSessionBuffer.resize(::olm_inbound_group_session_size());
+  session->olmSession =
+      ::olm_inbound_group_session(session->olmSessionBuffer.data());
+  if (-1 ==
+      ::olm_init_inbound_group_session(
+          session->olmSession,
+          (uint8_t *)sessionKey.data(),
+          sessionKey.size())) {
+    throw std::runtime_error(
+        "error createInboundGroup => ::olm_init_inbound_group_session");
+  }
+  return session;
+}
+
+std::string InboundGroupSession::decrypt(
+    const OlmBuffer &encryptedMessage,
+    std::uint32_t &messageIndex) {
+  this->scratchBuffer.assign(encryptedMessage.begin(), encryptedMessage.end());
+  size_t maxSize = ::olm_group_decrypt_max_plaintext_length(
+      this->olmSession, this->scratchBuffer.data(), this->scratchBuffer.size());
+  if (maxSize == -1) {
+    throw std::runtime_error("error ::olm_group_decrypt_max_plaintext_length");
+  }
+
+  this->scratchBuffer.assign(encryptedMessage.begin(), encryptedMessage.end());
+  OlmBuffer decryptedMessage(maxSize);
+  size_t decryptedSize = ::olm_group_decrypt(
+      this->olmSession,
+      this->scratchBuffer.data(),
+      this->scratchBuffer.size(),
+      decryptedMessage.data(),
+      decryptedMessage.size(),
+      &messageIndex);
+  if (decryptedSize == -1) {
+    throw std::runtime_error("error ::olm_group_decrypt");
+  }
+  if (!this->decryptedIndexes.insert(messageIndex).second) {
+    throw std::runtime_error("error groupDecrypt => replayed message");
+  }
+  return std::string((char *)decryptedMessage.data(), decryptedSize);
+}
+
+std::string InboundGroupSession::getSessionId() {
+  OlmBuffer sessionId(::olm_inbound_group_session_id_length(this->olmSession));
+  if (-1 ==
+      ::olm_inbound_group_session_id(
+          this->olmSession, sessionId.data(), sessionId.size())) {
+    throw std::runtime_error(
+        "error getSessionId => ::olm_inbound_group_session_id");
+  }
+  return std::string(sessionId.begin(), sessionId.end());
+}
+
+std::uint32_t InboundGroupSession::getFirstKnownIndex() {
+  return ::olm_inbound_group_session_first_known_index(this->olmSession);
+}
+
+OlmBuffer InboundGroupSession::storeAsB64(const std::string &secretKey) {
+  size_t pickleLength =
+      ::olm_pickle_inbound_group_session_length(this->olmSession);
+  OlmBuffer pickle(pickleLength);
+  size_t res = ::olm_pickle_inbound_group_session(
+      this->olmSession,
+      secretKey.data(),
+      secretKey.size(),
+      pickle.data(),
+      pickleLength);
+  if (pickleLength != res) {
+    throw std::runtime_error(
+        "error pickleInboundGroupSession => "
+        "::olm_pickle_inbound_group_session");
+  }
+  return pickle;
+}
+
+std::unique_ptr<InboundGroupSession> InboundGroupSession::restoreFromB64(
+    const std::string &secretKey,
+    OlmBuffer &b64) {
+  std::unique_ptr<InboundGroupSession> session(new InboundGroupSession());
+
+  session->olmSessionBuffer.resize(::olm_inbound_group_session_size());
+  session->olmSession =
+      ::olm_inbound_group_session(session->olmSessionBuffer.data());
+  if (-1 ==
+      ::olm_unpickle_inbound_group_session(
+          session->olmSession,
+          secretKey.data(),
+          secretKey.size(),
+          b64.data(),
+          b64.size())) {
+    throw std::runtime_error(
+        "error pickleInboundGroupSession => "
+        "::olm_unpickle_inbound_group_session");
+  }
+  return session;
+}
+
+} // namespace crypto
+} // namespace comm
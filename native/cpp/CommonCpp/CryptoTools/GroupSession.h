@@ -0,0 +1,66 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_set>
+
+#include "Tools.h"
+
+namespace comm {
+namespace crypto {
+
+// megolm session used to send messages to a whole thread, every message is
+// encrypted once and only the session key has to be shared with the members
+// through their pairwise `Session`s
+class OutboundGroupSession {
+  OlmOutboundGroupSession *olmSession = nullptr;
+  OlmBuffer olmSessionBuffer;
+
+  OutboundGroupSession() {
+  }
+
+public:
+  static std::unique_ptr<OutboundGroupSession> create();
+  OlmBuffer encrypt(const std::string &content);
+  std::string getSessionId();
+  std::string getSessionKey();
+  std::uint32_t getMessageIndex();
+  OlmBuffer storeAsB64(const std::string &secretKey);
+  static std::unique_ptr<OutboundGroupSession>
+  restoreFromB64(const std::string &secretKey, OlmBuffer &b64);
+};
+
+// receiving side of an `OutboundGroupSession`, created from the session key
+// shared by the sender
+class InboundGroupSession {
+  OlmInboundGroupSession *olmSession = nullptr;
+  OlmBuffer olmSessionBuffer;
+  // olm overwrites the messages passed to it, see `Session::scratchBuffer`
+  OlmBuffer scratchBuffer;
+  // indexes of the messages decrypted since the session was created or
+  // restored, a message decrypted again is a replay. They aren't part of the
+  // pickle so a restart forgets them.
+  std::unordered_set<std::uint32_t> decryptedIndexes;
+
+  InboundGroupSession() {
+  }
+
+public:
+  static std::unique_ptr<InboundGroupSession>
+  create(const std::string &sessionKey);
+  // sets `messageIndex` to the index of the message in the sender's ratchet,
+  // a message whose index has already been decrypted by this instance is
+  // rejected. Replays across a restart aren't detected here, the messages
+  // have to be deduplicated by their ids.
+  std::string
+  decrypt(const OlmBuffer &encryptedMessage, std::uint32_t &messageIndex);
+  std::string getSessionId();
+  // the earliest message index this session can decrypt
+  std::uint32_t getFirstKnownIndex();
+  OlmBuffer storeAsB64(const std::string &secretKey);
+  static std::unique_ptr<InboundGroupSession>
+  restoreFromB64(const std::string &secretKey, OlmBuffer &b64);
+};
+
+} // namespace crypto
+} // namespace comm
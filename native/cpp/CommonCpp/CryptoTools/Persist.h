@@ -11,6 +11,11 @@ namespace crypto {
 struct Persist {
   OlmBuffer account;
   std::unordered_map<std::string, OlmBuffer> sessions;
+  // keyed by thread id
+  std::unordered_map<std::string, OlmBuffer> outboundGroupSessions;
+  // keyed by the sender's curve25519 identity key and the session id joined
+  // with a colon
+  std::unordered_map<std::string, OlmBuffer> inboundGroupSessions;
 
   bool isEmpty() const {
     return (this->account.size() == 0);
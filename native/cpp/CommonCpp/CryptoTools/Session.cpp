@@ -107,5 +107,12 @@ OlmSession *Session::getOlmSession() {
   return this->olmSession;
 }
 
+std::uint8_t *Session::copyToScratch(const std::uint8_t *data, size_t size) {
+  // `assign` keeps the capacity, so this only allocates when a message
+  // bigger than all of the previous ones arrives
+  this->scratchBuffer.assign(data, data + size);
+  return this->scratchBuffer.data();
+}
+
 } // namespace crypto
 } // namespace comm
@@ -14,6 +14,9 @@ class Session {
 
   OlmSession *olmSession = nullptr;
   OlmBuffer olmSessionBuffer;
+  // olm overwrites the messages passed to it, so they have to be copied
+  // before every call, this buffer is reused for all of those copies
+  OlmBuffer scratchBuffer;
 
   Session(OlmAccount *account, std::uint8_t *ownerIdentityKeys)
       : ownerUserAccount(account), ownerIdentityKeys(ownerIdentityKeys) {
@@ -38,6 +41,7 @@ public:
       const std::string &secretKey,
       OlmBuffer &b64);
   OlmSession *getOlmSession();
+  std::uint8_t *copyToScratch(const std::uint8_t *data, size_t size);
 };
 
 } // namespace crypto
@@ -1,6 +1,8 @@
 #include "Tools.h"
 #include "PlatformSpecificTools.h"
+#include "olm/base64.h"
 
+#include <stdexcept>
 #include <string>
 
 namespace comm {
@@ -19,5 +21,34 @@ std::string Tools::generateRandomString(size_t size) {
   return result;
 }
 
+void Tools::encodeBase64(
+    const std::uint8_t *data,
+    size_t size,
+    OlmBuffer &result) {
+  result.resize(::_olm_encode_base64_length(size));
+  ::_olm_encode_base64(data, size, result.data());
+}
+
+size_t Tools::getDecodedBase64Length(size_t b64Size) {
+  size_t decodedSize = ::_olm_decode_base64_length(b64Size);
+  if (decodedSize == -1) {
+    throw std::runtime_error(
+        "error getDecodedBase64Length => invalid base64 length");
+  }
+  return decodedSize;
+}
+
+size_t Tools::decodeBase64(
+    const std::uint8_t *b64,
+    size_t b64Size,
+    std::uint8_t *result) {
+  size_t decodedSize = ::_olm_decode_base64_length(b64Size);
+  if (decodedSize == -1) {
+    throw std::runtime_error("error decodeBase64 => invalid base64 length");
+  }
+  ::_olm_decode_base64(b64, b64Size, result);
+  return decodedSize;
+}
+
 } // namespace crypto
 } // namespace comm
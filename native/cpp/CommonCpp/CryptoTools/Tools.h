@@ -1,5 +1,6 @@
 #pragma once
 
+#include <string>
 #include <vector>
 
 #include "olm/olm.h"
@@ -9,6 +10,11 @@
 #define ONE_TIME_KEYS_PREFIX_OFFSET 25
 #define ONE_TIME_KEYS_MIDDLE_OFFSET 12
 
+// one-time keys are pre-generated up to ONE_TIME_KEYS_POOL_SIZE and the pool
+// gets topped up once fewer than ONE_TIME_KEYS_LOW_WATER_MARK keys are left
+#define ONE_TIME_KEYS_POOL_SIZE 50
+#define ONE_TIME_KEYS_LOW_WATER_MARK 25
+
 namespace comm {
 namespace crypto {
 
@@ -24,9 +30,45 @@ struct EncryptedData {
   size_t messageType;
 };
 
+struct GroupEncryptedData {
+  OlmBuffer message;
+  // id of the megolm session the message was encrypted with, the receiver
+  // picks its inbound session by it
+  std::string sessionId;
+};
+
+// non-owning view of an encrypted message, the memory it points to has to
+// outlive every call it is passed to
+struct EncryptedDataView {
+  const std::uint8_t *message;
+  size_t messageSize;
+  size_t messageType;
+
+  EncryptedDataView(
+      const std::uint8_t *message,
+      size_t messageSize,
+      size_t messageType)
+      : message(message), messageSize(messageSize), messageType(messageType) {
+  }
+  EncryptedDataView(const EncryptedData &encryptedData)
+      : message(encryptedData.message.data()),
+        messageSize(encryptedData.message.size()),
+        messageType(encryptedData.messageType) {
+  }
+};
+
 class Tools {
 public:
   static std::string generateRandomString(size_t size);
+  // olm pickles are base64 strings, they are persisted as the raw bytes they
+  // encode, these convert between the two forms
+  static void
+  encodeBase64(const std::uint8_t *data, size_t size, OlmBuffer &result);
+  // throws when no base64 string has the given length
+  static size_t getDecodedBase64Length(size_t b64Size);
+  // returns the number of bytes written to `result`
+  static size_t
+  decodeBase64(const std::uint8_t *b64, size_t b64Size, std::uint8_t *result);
 };
 
 } // namespace crypto
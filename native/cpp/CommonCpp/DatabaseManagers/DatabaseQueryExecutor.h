@@ -5,11 +5,11 @@
 #include "entities/Media.h"
 #include "entities/Message.h"
 #include "entities/OlmPersistAccount.h"
+#include "entities/OlmPersistInboundGroupSession.h"
+#include "entities/OlmPersistOutboundGroupSession.h"
 #include "entities/OlmPersistSession.h"
 #include "entities/Thread.h"
 
-#include <folly/Optional.h>
-
 #include <jsi/jsi.h>
 #include <string>
 
@@ -52,9 +52,11 @@ public:
   virtual void beginTransaction() const = 0;
   virtual void commitTransaction() const = 0;
   virtual void rollbackTransaction() const = 0;
-  virtual std::vector<OlmPersistSession> getOlmPersistSessionsData() const = 0;
-  virtual folly::Optional<std::string> getOlmPersistAccountData() const = 0;
-  virtual void storeOlmPersistData(crypto::Persist persist) const = 0;
+  virtual crypto::Persist getOlmPersistData() const = 0;
+  virtual void storeOlmPersistData(const crypto::Persist &persist) const = 0;
+  virtual void storeOlmOutboundGroupSession(
+      const std::string &threadId,
+      const crypto::OlmBuffer &session) const = 0;
 };
 
 } // namespace comm
@@ -2,6 +2,7 @@
 #include "Logger.h"
 #include "sqlite_orm.h"
 
+#include "../CryptoTools/Tools.h"
 #include "entities/Media.h"
 #include <sqlite3.h>
 #include <memory>
@@ -10,6 +11,7 @@
 #include <system_error>
 
 #define ACCOUNT_ID 1
+#define OLM_PERSIST_BUSY_TIMEOUT_MS 5000
 
 namespace comm {
 
@@ -237,6 +239,122 @@ bool enable_write_ahead_logging_mode(sqlite3 *db) {
   return false;
 }
 
+bool create_persist_outbound_group_sessions_table(sqlite3 *db) {
+  std::string query =
+      "CREATE TABLE IF NOT EXISTS olm_persist_outbound_group_sessions("
+      "thread_id TEXT UNIQUE PRIMARY KEY NOT NULL, "
+      "session_data BLOB NOT NULL);";
+  return create_table(db, query, "olm_persist_outbound_group_sessions");
+}
+
+bool create_persist_inbound_group_sessions_table(sqlite3 *db) {
+  std::string query =
+      "CREATE TABLE IF NOT EXISTS olm_persist_inbound_group_sessions("
+      "session_id TEXT UNIQUE PRIMARY KEY NOT NULL, "
+      "session_data BLOB NOT NULL);";
+  return create_table(db, query, "olm_persist_inbound_group_sessions");
+}
+
+bool convert_persist_table_to_blob(
+    sqlite3 *db,
+    std::string tableName,
+    std::string keyColumnDefinition,
+    std::string keyColumn,
+    std::string dataColumn) {
+  std::string blobTableName = tableName + "_blob";
+  std::string createQuery = "CREATE TABLE " + blobTableName + "(" +
+      keyColumnDefinition + ", " + dataColumn + " BLOB NOT NULL);";
+  if (!create_table(db, createQuery, blobTableName)) {
+    return false;
+  }
+
+  std::string selectQuery =
+      "SELECT " + keyColumn + ", " + dataColumn + " FROM " + tableName + ";";
+  std::string insertQuery = "INSERT INTO " + blobTableName + " (" +
+      keyColumn + ", " + dataColumn + ") VALUES (?, ?);";
+  sqlite3_stmt *select_stmt = nullptr;
+  sqlite3_stmt *insert_stmt = nullptr;
+  if (sqlite3_prepare_v2(
+          db, selectQuery.c_str(), -1, &select_stmt, nullptr) != SQLITE_OK ||
+      sqlite3_prepare_v2(
+          db, insertQuery.c_str(), -1, &insert_stmt, nullptr) != SQLITE_OK) {
+    std::ostringstream stringStream;
+    stringStream << "Error preparing '" << tableName
+                 << "' conversion: " << sqlite3_errmsg(db);
+    Logger::log(stringStream.str());
+    sqlite3_finalize(select_stmt);
+    sqlite3_finalize(insert_stmt);
+    return false;
+  }
+
+  bool success = true;
+  std::vector<std::uint8_t> decoded;
+  while (sqlite3_step(select_stmt) == SQLITE_ROW) {
+    const std::uint8_t *b64 = static_cast<const std::uint8_t *>(
+        sqlite3_column_blob(select_stmt, 1));
+    size_t b64Size = sqlite3_column_bytes(select_stmt, 1);
+    try {
+      decoded.resize(crypto::Tools::getDecodedBase64Length(b64Size));
+      decoded.resize(crypto::Tools::decodeBase64(b64, b64Size, decoded.data()));
+    } catch (std::runtime_error &e) {
+      std::ostringstream stringStream;
+      stringStream << "Error decoding '" << tableName << "' row: " << e.what();
+      Logger::log(stringStream.str());
+      success = false;
+      break;
+    }
+    sqlite3_bind_value(insert_stmt, 1, sqlite3_column_value(select_stmt, 0));
+    sqlite3_bind_blob(
+        insert_stmt, 2, decoded.data(), decoded.size(), SQLITE_STATIC);
+    if (sqlite3_step(insert_stmt) != SQLITE_DONE) {
+      std::ostringstream stringStream;
+      stringStream << "Error copying '" << tableName
+                   << "' row: " << sqlite3_errmsg(db);
+      Logger::log(stringStream.str());
+      success = false;
+      break;
+    }
+    sqlite3_reset(insert_stmt);
+  }
+  sqlite3_finalize(select_stmt);
+  sqlite3_finalize(insert_stmt);
+  if (!success) {
+    return false;
+  }
+
+  std::string swapQuery = "DROP TABLE " + tableName + "; ALTER TABLE " +
+      blobTableName + " RENAME TO " + tableName + ";";
+  char *error;
+  sqlite3_exec(db, swapQuery.c_str(), nullptr, nullptr, &error);
+  if (!error) {
+    return true;
+  }
+
+  std::ostringstream stringStream;
+  stringStream << "Error replacing '" << tableName
+               << "' table with its BLOB version: " << error;
+  Logger::log(stringStream.str());
+
+  sqlite3_free(error);
+  return false;
+}
+
+// the group session tables are created with BLOB columns already
+bool convert_olm_persist_data_to_blob(sqlite3 *db) {
+  return convert_persist_table_to_blob(
+             db,
+             "olm_persist_account",
+             "id INTEGER UNIQUE PRIMARY KEY NOT NULL",
+             "id",
+             "account_data") &&
+      convert_persist_table_to_blob(
+             db,
+             "olm_persist_sessions",
+             "target_user_id TEXT UNIQUE PRIMARY KEY NOT NULL",
+             "target_user_id",
+             "session_data");
+}
+
 typedef bool ShouldBeInTransaction;
 typedef std::pair<std::function<bool(sqlite3 *)>, ShouldBeInTransaction>
     SQLiteMigration;
@@ -252,7 +370,10 @@ std::vector<std::pair<uint, SQLiteMigration>> migrations{
      {19, {create_media_idx_container, true}},
      {20, {create_threads_table, true}},
      {21, {update_threadID_for_pending_threads_in_drafts, true}},
-     {22, {enable_write_ahead_logging_mode, false}}}};
+     {22, {enable_write_ahead_logging_mode, false}},
+     {23, {create_persist_outbound_group_sessions_table, true}},
+     {24, {create_persist_inbound_group_sessions_table, true}},
+     {25, {convert_olm_persist_data_to_blob, true}}}};
 
 void SQLiteQueryExecutor::migrate() {
   sqlite3 *db;
@@ -335,6 +456,18 @@ auto &SQLiteQueryExecutor::getStorage() {
           "olm_persist_sessions",
           make_column("target_user_id", &OlmPersistSession::target_user_id),
           make_column("session_data", &OlmPersistSession::session_data)),
+      make_table(
+          "olm_persist_outbound_group_sessions",
+          make_column(
+              "thread_id", &OlmPersistOutboundGroupSession::thread_id),
+          make_column(
+              "session_data", &OlmPersistOutboundGroupSession::session_data)),
+      make_table(
+          "olm_persist_inbound_group_sessions",
+          make_column(
+              "session_id", &OlmPersistInboundGroupSession::session_id),
+          make_column(
+              "session_data", &OlmPersistInboundGroupSession::session_data)),
       make_table(
           "media",
           make_column("id", &Media::id, unique(), primary_key()),
@@ -553,35 +686,164 @@ void SQLiteQueryExecutor::rollbackTransaction() const {
   SQLiteQueryExecutor::getStorage().rollback();
 }
 
-std::vector<OlmPersistSession>
-SQLiteQueryExecutor::getOlmPersistSessionsData() const {
-  return SQLiteQueryExecutor::getStorage().get_all<OlmPersistSession>();
+std::vector<char> decode_olm_persist_data(const crypto::OlmBuffer &b64) {
+  std::vector<char> result(crypto::Tools::getDecodedBase64Length(b64.size()));
+  result.resize(crypto::Tools::decodeBase64(
+      b64.data(), b64.size(), reinterpret_cast<std::uint8_t *>(result.data())));
+  return result;
+}
+
+// finalizes the statement and throws the error of its last step
+void throw_olm_persist_error(sqlite3 *db, sqlite3_stmt *stmt) {
+  std::string error = sqlite3_errmsg(db);
+  sqlite3_finalize(stmt);
+  throw std::system_error(ECANCELED, std::generic_category(), error);
 }
 
-folly::Optional<std::string>
-SQLiteQueryExecutor::getOlmPersistAccountData() const {
-  std::vector<OlmPersistAccount> result =
-      SQLiteQueryExecutor::getStorage().get_all<OlmPersistAccount>();
-  if (result.size() > 1) {
+// the pickles are BLOBs since migration 25, any other type means the
+// conversion didn't complete and the base64 text would be encoded again
+void check_olm_persist_blob(sqlite3_stmt *stmt, int column) {
+  if (sqlite3_column_type(stmt, column) != SQLITE_BLOB) {
+    sqlite3_finalize(stmt);
     throw std::system_error(
         ECANCELED,
         std::generic_category(),
-        "Multiple records found for the olm_persist_account table");
+        "olm persist data isn't stored as a BLOB");
+  }
+}
+
+void read_olm_persist_table(
+    sqlite3 *db,
+    std::string query,
+    std::unordered_map<std::string, crypto::OlmBuffer> &result) {
+  sqlite3_stmt *stmt;
+  if (sqlite3_prepare_v2(db, query.c_str(), -1, &stmt, nullptr) !=
+      SQLITE_OK) {
+    std::string error = sqlite3_errmsg(db);
+    throw std::system_error(ECANCELED, std::generic_category(), error);
+  }
+  int rc;
+  while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+    check_olm_persist_blob(stmt, 1);
+    std::string key(
+        reinterpret_cast<const char *>(sqlite3_column_text(stmt, 0)),
+        sqlite3_column_bytes(stmt, 0));
+    // pickles are read straight from the sqlite page memory, olm only accepts
+    // base64 so this is the single encoding step on the way to the module
+    crypto::Tools::encodeBase64(
+        static_cast<const std::uint8_t *>(sqlite3_column_blob(stmt, 1)),
+        sqlite3_column_bytes(stmt, 1),
+        result[key]);
+  }
+  // a partial read would be stored back over the complete data
+  if (rc != SQLITE_DONE) {
+    throw_olm_persist_error(db, stmt);
+  }
+  sqlite3_finalize(stmt);
+}
+
+crypto::Persist SQLiteQueryExecutor::getOlmPersistData() const {
+  crypto::Persist persist;
+  sqlite3 *db;
+  if (sqlite3_open(SQLiteQueryExecutor::sqliteFilePath.c_str(), &db) !=
+      SQLITE_OK) {
+    std::string error = sqlite3_errmsg(db);
+    sqlite3_close(db);
+    throw std::system_error(ECANCELED, std::generic_category(), error);
+  }
+  // the database is in WAL mode and written from the sqlite_orm storage
+  // concurrently, a busy database is waited for instead of failing the read
+  sqlite3_busy_timeout(db, OLM_PERSIST_BUSY_TIMEOUT_MS);
+
+  try {
+    sqlite3_stmt *account_stmt;
+    if (sqlite3_prepare_v2(
+            db,
+            "SELECT account_data FROM olm_persist_account;",
+            -1,
+            &account_stmt,
+            nullptr) != SQLITE_OK) {
+      std::string error = sqlite3_errmsg(db);
+      throw std::system_error(ECANCELED, std::generic_category(), error);
+    }
+    size_t accountRows = 0;
+    int rc;
+    while ((rc = sqlite3_step(account_stmt)) == SQLITE_ROW) {
+      if (++accountRows > 1) {
+        sqlite3_finalize(account_stmt);
+        throw std::system_error(
+            ECANCELED,
+            std::generic_category(),
+            "Multiple records found for the olm_persist_account table");
+      }
+      check_olm_persist_blob(account_stmt, 0);
+      crypto::Tools::encodeBase64(
+          static_cast<const std::uint8_t *>(
+              sqlite3_column_blob(account_stmt, 0)),
+          sqlite3_column_bytes(account_stmt, 0),
+          persist.account);
+    }
+    if (rc != SQLITE_DONE) {
+      throw_olm_persist_error(db, account_stmt);
+    }
+    sqlite3_finalize(account_stmt);
+    if (accountRows == 0) {
+      sqlite3_close(db);
+      return persist;
+    }
+
+    read_olm_persist_table(
+        db,
+        "SELECT target_user_id, session_data FROM olm_persist_sessions;",
+        persist.sessions);
+    read_olm_persist_table(
+        db,
+        "SELECT thread_id, session_data "
+        "FROM olm_persist_outbound_group_sessions;",
+        persist.outboundGroupSessions);
+    read_olm_persist_table(
+        db,
+        "SELECT session_id, session_data "
+        "FROM olm_persist_inbound_group_sessions;",
+        persist.inboundGroupSessions);
+  } catch (const std::system_error &) {
+    sqlite3_close(db);
+    throw;
   }
-  return (result.size() == 0)
-      ? folly::none
-      : folly::Optional<std::string>(result[0].account_data);
+  sqlite3_close(db);
+  return persist;
 }
 
-void SQLiteQueryExecutor::storeOlmPersistData(crypto::Persist persist) const {
+void SQLiteQueryExecutor::storeOlmPersistData(
+    const crypto::Persist &persist) const {
   OlmPersistAccount persistAccount = {
-      ACCOUNT_ID, std::string(persist.account.begin(), persist.account.end())};
+      ACCOUNT_ID, decode_olm_persist_data(persist.account)};
   SQLiteQueryExecutor::getStorage().replace(persistAccount);
-  for (auto it = persist.sessions.begin(); it != persist.sessions.end(); it++) {
+  for (auto &session : persist.sessions) {
     OlmPersistSession persistSession = {
-        it->first, std::string(it->second.begin(), it->second.end())};
+        session.first, decode_olm_persist_data(session.second)};
+    SQLiteQueryExecutor::getStorage().replace(persistSession);
+  }
+  for (auto &outboundGroupSession : persist.outboundGroupSessions) {
+    OlmPersistOutboundGroupSession persistSession = {
+        outboundGroupSession.first,
+        decode_olm_persist_data(outboundGroupSession.second)};
     SQLiteQueryExecutor::getStorage().replace(persistSession);
   }
+  for (auto &inboundGroupSession : persist.inboundGroupSessions) {
+    OlmPersistInboundGroupSession persistSession = {
+        inboundGroupSession.first,
+        decode_olm_persist_data(inboundGroupSession.second)};
+    SQLiteQueryExecutor::getStorage().replace(persistSession);
+  }
+}
+
+void SQLiteQueryExecutor::storeOlmOutboundGroupSession(
+    const std::string &threadId,
+    const crypto::OlmBuffer &session) const {
+  OlmPersistOutboundGroupSession persistSession = {
+      threadId, decode_olm_persist_data(session)};
+  SQLiteQueryExecutor::getStorage().replace(persistSession);
 }
 
 } // namespace comm
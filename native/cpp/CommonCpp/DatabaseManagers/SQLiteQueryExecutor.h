@@ -44,9 +44,11 @@ public:
   void beginTransaction() const override;
   void commitTransaction() const override;
   void rollbackTransaction() const override;
-  std::vector<OlmPersistSession> getOlmPersistSessionsData() const override;
-  folly::Optional<std::string> getOlmPersistAccountData() const override;
-  void storeOlmPersistData(crypto::Persist persist) const override;
+  crypto::Persist getOlmPersistData() const override;
+  void storeOlmPersistData(const crypto::Persist &persist) const override;
+  void storeOlmOutboundGroupSession(
+      const std::string &threadId,
+      const crypto::OlmBuffer &session) const override;
 };
 
 } // namespace comm
@@ -1,12 +1,12 @@
 #pragma once
 
-#include <string>
+#include <vector>
 
 namespace comm {
 
 struct OlmPersistAccount {
   int id;
-  std::string account_data;
+  std::vector<char> account_data;
 };
 
 } // namespace comm
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace comm {
+
+struct OlmPersistInboundGroupSession {
+  std::string session_id;
+  std::vector<char> session_data;
+};
+
+} // namespace comm
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace comm {
+
+struct OlmPersistOutboundGroupSession {
+  std::string thread_id;
+  std::vector<char> session_data;
+};
+
+} // namespace comm
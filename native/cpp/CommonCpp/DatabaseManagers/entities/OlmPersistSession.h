@@ -1,12 +1,13 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 namespace comm {
 
 struct OlmPersistSession {
   std::string target_user_id;
-  std::string session_data;
+  std::vector<char> session_data;
 };
 
 } // namespace comm
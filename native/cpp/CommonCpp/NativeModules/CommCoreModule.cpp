@@ -769,31 +769,26 @@ jsi::Value CommCoreModule::initializeCryptoAccount(
           crypto::Persist persist;
           std::string error;
           try {
-            folly::Optional<std::string> accountData =
-                DatabaseManager::getQueryExecutor().getOlmPersistAccountData();
-            if (accountData.hasValue()) {
-              persist.account =
-                  crypto::OlmBuffer(accountData->begin(), accountData->end());
-              // handle sessions data
-              std::vector<OlmPersistSession> sessionsData =
-                  DatabaseManager::getQueryExecutor()
-                      .getOlmPersistSessionsData();
-              for (OlmPersistSession &sessionsDataItem : sessionsData) {
-                crypto::OlmBuffer sessionDataBuffer(
-                    sessionsDataItem.session_data.begin(),
-                    sessionsDataItem.session_data.end());
-                persist.sessions.insert(std::make_pair(
-                    sessionsDataItem.target_user_id, sessionDataBuffer));
-              }
-            }
+            persist = DatabaseManager::getQueryExecutor().getOlmPersistData();
           } catch (std::system_error &e) {
             error = e.what();
           }
 
           this->cryptoThread->scheduleTask([=]() {
-            std::string error;
+            // a new account would be stored over the one which couldn't be
+            // read
+            if (error.size()) {
+              this->jsInvoker_->invokeAsync(
+                  [=]() { promise->reject(error); });
+              return;
+            }
             this->cryptoModule.reset(new crypto::CryptoModule(
                 userIdStr, storedSecretKey.value(), persist));
+            this->cryptoModuleSecretKey = storedSecretKey.value();
+            this->cryptoModule->setOutboundGroupSessionChangedCallback(
+                [this](const std::string &threadId) {
+                  this->persistOutboundGroupSession(threadId);
+                });
             if (persist.isEmpty()) {
               crypto::Persist newPersist =
                   this->cryptoModule->storeAsB64(storedSecretKey.value());
@@ -802,7 +797,7 @@ jsi::Value CommCoreModule::initializeCryptoAccount(
                 try {
                   DatabaseManager::getQueryExecutor().storeOlmPersistData(
                       newPersist);
-                } catch (std::system_error &e) {
+                } catch (std::runtime_error &e) {
                   error = e.what();
                 }
                 this->jsInvoker_->invokeAsync([=]() {
@@ -825,6 +820,7 @@ jsi::Value CommCoreModule::initializeCryptoAccount(
                 promise->resolve(jsi::Value::undefined());
               });
             }
+            this->scheduleOneTimeKeysRefill();
           });
         });
       });
@@ -883,9 +879,175 @@ jsi::Value CommCoreModule::getUserOneTimeKeys(jsi::Runtime &rt) {
           });
         };
         this->cryptoThread->scheduleTask(job);
+        this->scheduleOneTimeKeysRefill();
+      });
+}
+
+void CommCoreModule::scheduleOneTimeKeysRefill() {
+  this->cryptoThread->scheduleTask([=]() {
+    if (this->cryptoModule == nullptr ||
+        !this->cryptoModule->needsOneTimeKeysRefill()) {
+      return;
+    }
+    try {
+      this->cryptoModule->refillOneTimeKeys();
+    } catch (std::runtime_error &e) {
+      Logger::log("one-time keys refill error: " + std::string(e.what()));
+      return;
+    }
+    // the generated keys live in the account, they'd be lost on a restart
+    this->persistCryptoModule();
+  });
+}
+
+void CommCoreModule::persistCryptoModule() {
+  crypto::Persist persist;
+  try {
+    persist = this->cryptoModule->storeAsB64(this->cryptoModuleSecretKey);
+  } catch (std::runtime_error &e) {
+    Logger::log("olm account pickling error: " + std::string(e.what()));
+    return;
+  }
+  this->databaseThread->scheduleTask([=]() {
+    try {
+      DatabaseManager::getQueryExecutor().storeOlmPersistData(persist);
+    } catch (std::runtime_error &e) {
+      Logger::log("olm account storing error: " + std::string(e.what()));
+    }
+  });
+}
+
+void CommCoreModule::persistOutboundGroupSession(const std::string &threadId) {
+  crypto::OlmBuffer session =
+      this->cryptoModule->storeOutboundGroupSessionAsB64(
+          threadId, this->cryptoModuleSecretKey);
+  // the database thread runs its tasks in order so the session is stored
+  // before anything scheduled after the message is encrypted
+  this->databaseThread->scheduleTask([=, session = std::move(session)]() {
+    try {
+      DatabaseManager::getQueryExecutor().storeOlmOutboundGroupSession(
+          threadId, session);
+    } catch (std::runtime_error &e) {
+      Logger::log("group session storing error: " + std::string(e.what()));
+    }
+  });
+}
+
+jsi::Value CommCoreModule::runCryptoJob(
+    jsi::Runtime &rt,
+    std::function<std::string()> job) {
+  return createPromiseAsJSIValue(
+      rt, [=](jsi::Runtime &innerRt, std::shared_ptr<Promise> promise) {
+        this->cryptoThread->scheduleTask([=, &innerRt]() {
+          std::string error;
+          std::string result;
+          if (this->cryptoModule == nullptr) {
+            error = "user has not been initialized";
+          } else {
+            try {
+              result = job();
+            } catch (std::runtime_error &e) {
+              error = e.what();
+            }
+          }
+          this->jsInvoker_->invokeAsync([=, &innerRt]() {
+            if (error.size()) {
+              promise->reject(error);
+              return;
+            }
+            promise->resolve(jsi::String::createFromUtf8(innerRt, result));
+          });
+        });
+      });
+}
+
+jsi::Value CommCoreModule::initializeOutboundGroupSession(
+    jsi::Runtime &rt,
+    const jsi::String &threadID) {
+  std::string threadIdStr = threadID.utf8(rt);
+  return this->runCryptoJob(rt, [=]() {
+    return this->cryptoModule->initializeOutboundGroupSession(threadIdStr);
+  });
+}
+
+jsi::Value CommCoreModule::initializeInboundGroupSession(
+    jsi::Runtime &rt,
+    const jsi::String &senderIdentityKeys,
+    const jsi::String &sessionKey) {
+  std::string senderIdentityKeysStr = senderIdentityKeys.utf8(rt);
+  std::string sessionKeyStr = sessionKey.utf8(rt);
+  return this->runCryptoJob(rt, [=]() {
+    std::string sessionId = this->cryptoModule->initializeInboundGroupSession(
+        crypto::OlmBuffer(
+            senderIdentityKeysStr.begin(), senderIdentityKeysStr.end()),
+        sessionKeyStr);
+    this->persistCryptoModule();
+    return sessionId;
+  });
+}
+
+jsi::Value CommCoreModule::groupEncrypt(
+    jsi::Runtime &rt,
+    const jsi::String &threadID,
+    const jsi::String &content) {
+  std::string threadIdStr = threadID.utf8(rt);
+  std::string contentStr = content.utf8(rt);
+  return createPromiseAsJSIValue(
+      rt, [=](jsi::Runtime &innerRt, std::shared_ptr<Promise> promise) {
+        taskType job = [=, &innerRt]() {
+          std::string error;
+          crypto::GroupEncryptedData encryptedData;
+          if (this->cryptoModule == nullptr) {
+            error = "user has not been initialized";
+          } else {
+            try {
+              encryptedData =
+                  this->cryptoModule->groupEncrypt(threadIdStr, contentStr);
+            } catch (std::runtime_error &e) {
+              error = e.what();
+            }
+          }
+          this->jsInvoker_->invokeAsync([=, &innerRt]() {
+            if (error.size()) {
+              promise->reject(error);
+              return;
+            }
+            auto jsiEncryptedData = jsi::Object(innerRt);
+            jsiEncryptedData.setProperty(
+                innerRt, "sessionID", encryptedData.sessionId);
+            jsiEncryptedData.setProperty(
+                innerRt,
+                "message",
+                std::string(
+                    encryptedData.message.begin(),
+                    encryptedData.message.end()));
+            promise->resolve(std::move(jsiEncryptedData));
+          });
+        };
+        this->cryptoThread->scheduleTask(job);
       });
 }
 
+jsi::Value CommCoreModule::groupDecrypt(
+    jsi::Runtime &rt,
+    const jsi::Object &encryptedData,
+    const jsi::String &senderIdentityKeys) {
+  std::string sessionIdStr =
+      encryptedData.getProperty(rt, "sessionID").asString(rt).utf8(rt);
+  std::string messageStr =
+      encryptedData.getProperty(rt, "message").asString(rt).utf8(rt);
+  std::string senderIdentityKeysStr = senderIdentityKeys.utf8(rt);
+  return this->runCryptoJob(rt, [=]() {
+    std::uint32_t messageIndex;
+    return this->cryptoModule->groupDecrypt(
+        {crypto::OlmBuffer(messageStr.begin(), messageStr.end()),
+         sessionIdStr},
+        crypto::OlmBuffer(
+            senderIdentityKeysStr.begin(), senderIdentityKeysStr.end()),
+        messageIndex);
+  });
+}
+
 CommCoreModule::CommCoreModule(
     std::shared_ptr<facebook::react::CallInvoker> jsInvoker)
     : facebook::react::CommCoreModuleSchemaCxxSpecJSI(jsInvoker),
@@ -6,6 +6,7 @@
 #include "../_generated/NativeModules.h"
 #include "../grpc/Client.h"
 #include <jsi/jsi.h>
+#include <functional>
 #include <memory>
 
 namespace comm {
@@ -19,6 +20,8 @@ class CommCoreModule : public facebook::react::CommCoreModuleSchemaCxxSpecJSI {
   CommSecureStore secureStore;
   const std::string secureStoreAccountDataKey = "cryptoAccountDataKey";
   std::unique_ptr<crypto::CryptoModule> cryptoModule;
+  // the key the account is pickled with, set and read on the crypto thread
+  std::string cryptoModuleSecretKey;
 
   std::unique_ptr<network::Client> networkClient;
 
@@ -50,6 +53,36 @@ class CommCoreModule : public facebook::react::CommCoreModuleSchemaCxxSpecJSI {
   initializeCryptoAccount(jsi::Runtime &rt, const jsi::String &userId) override;
   jsi::Value getUserPublicKey(jsi::Runtime &rt) override;
   jsi::Value getUserOneTimeKeys(jsi::Runtime &rt) override;
+  jsi::Value initializeOutboundGroupSession(
+      jsi::Runtime &rt,
+      const jsi::String &threadID) override;
+  jsi::Value initializeInboundGroupSession(
+      jsi::Runtime &rt,
+      const jsi::String &senderIdentityKeys,
+      const jsi::String &sessionKey) override;
+  jsi::Value groupEncrypt(
+      jsi::Runtime &rt,
+      const jsi::String &threadID,
+      const jsi::String &content) override;
+  jsi::Value groupDecrypt(
+      jsi::Runtime &rt,
+      const jsi::Object &encryptedData,
+      const jsi::String &senderIdentityKeys) override;
+
+  // generates one-time keys on the crypto thread so the next
+  // `getUserOneTimeKeys` call doesn't have to
+  void scheduleOneTimeKeysRefill();
+  // pickles the account and the sessions and stores them on the database
+  // thread, it has to be called on the crypto thread after the olm state
+  // changes in a way which has to survive a restart
+  void persistCryptoModule();
+  // pickles the thread's outbound group session and stores it on the
+  // database thread, called on the crypto thread whenever the session is
+  // created or its ratchet advances, throws when it can't be pickled
+  void persistOutboundGroupSession(const std::string &threadId);
+  // runs the job on the crypto thread once the account is initialized and
+  // resolves the promise with the string it returns
+  jsi::Value runCryptoJob(jsi::Runtime &rt, std::function<std::string()> job);
 
 public:
   CommCoreModule(std::shared_ptr<facebook::react::CallInvoker> jsInvoker);
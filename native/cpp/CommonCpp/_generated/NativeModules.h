@@ -34,6 +34,10 @@ virtual bool processThreadStoreOperationsSync(jsi::Runtime &rt, const jsi::Array
 virtual jsi::Value initializeCryptoAccount(jsi::Runtime &rt, const jsi::String &userId) = 0;
 virtual jsi::Value getUserPublicKey(jsi::Runtime &rt) = 0;
 virtual jsi::Value getUserOneTimeKeys(jsi::Runtime &rt) = 0;
+virtual jsi::Value initializeOutboundGroupSession(jsi::Runtime &rt, const jsi::String &threadID) = 0;
+virtual jsi::Value initializeInboundGroupSession(jsi::Runtime &rt, const jsi::String &senderIdentityKeys, const jsi::String &sessionKey) = 0;
+virtual jsi::Value groupEncrypt(jsi::Runtime &rt, const jsi::String &threadID, const jsi::String &content) = 0;
+virtual jsi::Value groupDecrypt(jsi::Runtime &rt, const jsi::Object &encryptedData, const jsi::String &senderIdentityKeys) = 0;
 
 };
 
@@ -4,13 +4,17 @@
 namespace comm {
 namespace network {
 
+// has to match OWNER_METADATA of the tunnelbroker service
+const std::string TUNNELBROKER_OWNER_METADATA = "comm-tunnelbroker-owner";
+const size_t MAX_CHANNEL_REDIRECTS = 3;
+
 Client::Client(
     std::string hostname,
     std::string port,
     std::shared_ptr<grpc::ChannelCredentials> credentials,
     const std::string id,
     const std::string deviceToken)
-    : id(id), deviceToken(deviceToken) {
+    : credentials(credentials), id(id), deviceToken(deviceToken) {
   std::shared_ptr<Channel> channel =
       grpc::CreateChannel(hostname + ":" + port, credentials);
   this->stub_ = TunnelBrokerService::NewStub(channel);
@@ -62,5 +66,89 @@ void Client::sendPong() {
   }
 }
 
+grpc::Status Client::runDeviceChannel(
+    TunnelBrokerService::Stub &stub,
+    grpc::ClientContext &context) {
+  std::unique_ptr<grpc::ClientReaderWriter<
+      tunnelbroker::DeviceMessage,
+      tunnelbroker::ServerMessage>>
+      stream = stub.OpenDeviceChannel(&context);
+
+  tunnelbroker::DeviceMessage hello;
+  hello.mutable_hello()->set_userid(this->id);
+  hello.mutable_hello()->set_devicetoken(this->deviceToken);
+
+  tunnelbroker::DeviceMessage pong;
+  pong.mutable_pong();
+
+  tunnelbroker::ServerMessage message;
+  if (stream->Write(hello)) {
+    while (stream->Read(&message)) {
+      if (message.has_ping() && !stream->Write(pong)) {
+        break;
+      }
+    }
+  }
+  return stream->Finish();
+}
+
+void Client::openDeviceChannel() {
+  {
+    std::lock_guard<std::mutex> lock(this->channelMutex);
+    if (this->channelOpen) {
+      throw std::runtime_error("the device channel is already open");
+    }
+    this->channelOpen = true;
+    this->channelClosing = false;
+  }
+
+  std::unique_ptr<TunnelBrokerService::Stub> ownerStub;
+  TunnelBrokerService::Stub *stub = this->stub_.get();
+  grpc::Status status;
+  for (size_t redirects = 0;; ++redirects) {
+    grpc::ClientContext *context;
+    {
+      std::lock_guard<std::mutex> lock(this->channelMutex);
+      if (this->channelClosing) {
+        status = grpc::Status::CANCELLED;
+        break;
+      }
+      this->channelContext = std::make_unique<grpc::ClientContext>();
+      context = this->channelContext.get();
+    }
+    status = this->runDeviceChannel(*stub, *context);
+
+    // the instance sends its owner's address when it doesn't serve the user
+    const std::multimap<grpc::string_ref, grpc::string_ref> &metadata =
+        context->GetServerTrailingMetadata();
+    auto owner = metadata.find(TUNNELBROKER_OWNER_METADATA);
+    if (status.error_code() != grpc::StatusCode::UNAVAILABLE ||
+        owner == metadata.end() || redirects == MAX_CHANNEL_REDIRECTS) {
+      break;
+    }
+    ownerStub = TunnelBrokerService::NewStub(grpc::CreateChannel(
+        std::string(owner->second.data(), owner->second.size()),
+        this->credentials));
+    stub = ownerStub.get();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(this->channelMutex);
+    this->channelContext.reset();
+    this->channelOpen = false;
+  }
+  if (!status.ok() && status.error_code() != grpc::StatusCode::CANCELLED) {
+    throw std::runtime_error(status.error_message());
+  }
+}
+
+void Client::closeDeviceChannel() {
+  std::lock_guard<std::mutex> lock(this->channelMutex);
+  this->channelClosing = true;
+  if (this->channelContext != nullptr) {
+    this->channelContext->TryCancel();
+  }
+}
+
 } // namespace network
 } // namespace comm
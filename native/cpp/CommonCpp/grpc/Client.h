@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <string>
 
 #include <grpcpp/grpcpp.h>
@@ -17,9 +18,19 @@ using tunnelbroker::TunnelBrokerService;
 
 class Client {
   std::unique_ptr<TunnelBrokerService::Stub> stub_;
+  const std::shared_ptr<grpc::ChannelCredentials> credentials;
   const std::string id;
   const std::string deviceToken;
 
+  std::mutex channelMutex;
+  std::unique_ptr<grpc::ClientContext> channelContext;
+  bool channelOpen = false;
+  bool channelClosing = false;
+
+  grpc::Status runDeviceChannel(
+      TunnelBrokerService::Stub &stub,
+      grpc::ClientContext &context);
+
 public:
   Client(
       std::string hostname,
@@ -31,6 +42,11 @@ public:
   CheckResponseType checkIfPrimaryDeviceOnline();
   bool becomeNewPrimaryDevice();
   void sendPong();
+  // keeps the device channel open and answers the pings pushed through it,
+  // blocks until the channel is closed so it should run on its own thread,
+  // follows the redirects to the tunnelbroker instance serving the user
+  void openDeviceChannel();
+  void closeDeviceChannel();
 };
 
 } // namespace network
@@ -25,6 +25,7 @@ static const char* TunnelBrokerService_method_names[] = {
   "/tunnelbroker.TunnelBrokerService/CheckIfPrimaryDeviceOnline",
   "/tunnelbroker.TunnelBrokerService/BecomeNewPrimaryDevice",
   "/tunnelbroker.TunnelBrokerService/SendPong",
+  "/tunnelbroker.TunnelBrokerService/OpenDeviceChannel",
 };
 
 std::unique_ptr< TunnelBrokerService::Stub> TunnelBrokerService::NewStub(const std::shared_ptr< ::grpc::ChannelInterface>& channel, const ::grpc::StubOptions& options) {
@@ -37,6 +38,7 @@ TunnelBrokerService::Stub::Stub(const std::shared_ptr< ::grpc::ChannelInterface>
   : channel_(channel), rpcmethod_CheckIfPrimaryDeviceOnline_(TunnelBrokerService_method_names[0], options.suffix_for_stats(),::grpc::internal::RpcMethod::NORMAL_RPC, channel)
   , rpcmethod_BecomeNewPrimaryDevice_(TunnelBrokerService_method_names[1], options.suffix_for_stats(),::grpc::internal::RpcMethod::NORMAL_RPC, channel)
   , rpcmethod_SendPong_(TunnelBrokerService_method_names[2], options.suffix_for_stats(),::grpc::internal::RpcMethod::NORMAL_RPC, channel)
+  , rpcmethod_OpenDeviceChannel_(TunnelBrokerService_method_names[3], options.suffix_for_stats(),::grpc::internal::RpcMethod::BIDI_STREAMING, channel)
   {}
 
 ::grpc::Status TunnelBrokerService::Stub::CheckIfPrimaryDeviceOnline(::grpc::ClientContext* context, const ::tunnelbroker::CheckRequest& request, ::tunnelbroker::CheckResponse* response) {
@@ -108,6 +110,22 @@ void TunnelBrokerService::Stub::async::SendPong(::grpc::ClientContext* context,
   return result;
 }
 
+::grpc::ClientReaderWriter< ::tunnelbroker::DeviceMessage, ::tunnelbroker::ServerMessage>* TunnelBrokerService::Stub::OpenDeviceChannelRaw(::grpc::ClientContext* context) {
+  return ::grpc::internal::ClientReaderWriterFactory< ::tunnelbroker::DeviceMessage, ::tunnelbroker::ServerMessage>::Create(channel_.get(), rpcmethod_OpenDeviceChannel_, context);
+}
+
+void TunnelBrokerService::Stub::async::OpenDeviceChannel(::grpc::ClientContext* context, ::grpc::ClientBidiReactor< ::tunnelbroker::DeviceMessage,::tunnelbroker::ServerMessage>* reactor) {
+  ::grpc::internal::ClientCallbackReaderWriterFactory< ::tunnelbroker::DeviceMessage,::tunnelbroker::ServerMessage>::Create(stub_->channel_.get(), stub_->rpcmethod_OpenDeviceChannel_, context, reactor);
+}
+
+::grpc::ClientAsyncReaderWriter< ::tunnelbroker::DeviceMessage, ::tunnelbroker::ServerMessage>* TunnelBrokerService::Stub::AsyncOpenDeviceChannelRaw(::grpc::ClientContext* context, ::grpc::CompletionQueue* cq, void* tag) {
+  return ::grpc::internal::ClientAsyncReaderWriterFactory< ::tunnelbroker::DeviceMessage, ::tunnelbroker::ServerMessage>::Create(channel_.get(), cq, rpcmethod_OpenDeviceChannel_, context, true, tag);
+}
+
+::grpc::ClientAsyncReaderWriter< ::tunnelbroker::DeviceMessage, ::tunnelbroker::ServerMessage>* TunnelBrokerService::Stub::PrepareAsyncOpenDeviceChannelRaw(::grpc::ClientContext* context, ::grpc::CompletionQueue* cq) {
+  return ::grpc::internal::ClientAsyncReaderWriterFactory< ::tunnelbroker::DeviceMessage, ::tunnelbroker::ServerMessage>::Create(channel_.get(), cq, rpcmethod_OpenDeviceChannel_, context, false, nullptr);
+}
+
 TunnelBrokerService::Service::Service() {
   AddMethod(new ::grpc::internal::RpcServiceMethod(
       TunnelBrokerService_method_names[0],
@@ -139,6 +157,16 @@ TunnelBrokerService::Service::Service() {
              ::google::protobuf::Empty* resp) {
                return service->SendPong(ctx, req, resp);
              }, this)));
+  AddMethod(new ::grpc::internal::RpcServiceMethod(
+      TunnelBrokerService_method_names[3],
+      ::grpc::internal::RpcMethod::BIDI_STREAMING,
+      new ::grpc::internal::BidiStreamingHandler< TunnelBrokerService::Service, ::tunnelbroker::DeviceMessage, ::tunnelbroker::ServerMessage>(
+          [](TunnelBrokerService::Service* service,
+             ::grpc::ServerContext* ctx,
+             ::grpc::ServerReaderWriter<::tunnelbroker::ServerMessage,
+             ::tunnelbroker::DeviceMessage>* stream) {
+               return service->OpenDeviceChannel(ctx, stream);
+             }, this)));
 }
 
 TunnelBrokerService::Service::~Service() {
@@ -165,6 +193,12 @@ TunnelBrokerService::Service::~Service() {
   return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
 }
 
+::grpc::Status TunnelBrokerService::Service::OpenDeviceChannel(::grpc::ServerContext* context, ::grpc::ServerReaderWriter< ::tunnelbroker::ServerMessage, ::tunnelbroker::DeviceMessage>* stream) {
+  (void) context;
+  (void) stream;
+  return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+}
+
 
 }  // namespace tunnelbroker
 
@@ -56,6 +56,15 @@ class TunnelBrokerService final {
     std::unique_ptr< ::grpc::ClientAsyncResponseReaderInterface< ::google::protobuf::Empty>> PrepareAsyncSendPong(::grpc::ClientContext* context, const ::tunnelbroker::PongRequest& request, ::grpc::CompletionQueue* cq) {
       return std::unique_ptr< ::grpc::ClientAsyncResponseReaderInterface< ::google::protobuf::Empty>>(PrepareAsyncSendPongRaw(context, request, cq));
     }
+    std::unique_ptr< ::grpc::ClientReaderWriterInterface< ::tunnelbroker::DeviceMessage, ::tunnelbroker::ServerMessage>> OpenDeviceChannel(::grpc::ClientContext* context) {
+      return std::unique_ptr< ::grpc::ClientReaderWriterInterface< ::tunnelbroker::DeviceMessage, ::tunnelbroker::ServerMessage>>(OpenDeviceChannelRaw(context));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncReaderWriterInterface< ::tunnelbroker::DeviceMessage, ::tunnelbroker::ServerMessage>> AsyncOpenDeviceChannel(::grpc::ClientContext* context, ::grpc::CompletionQueue* cq, void* tag) {
+      return std::unique_ptr< ::grpc::ClientAsyncReaderWriterInterface< ::tunnelbroker::DeviceMessage, ::tunnelbroker::ServerMessage>>(AsyncOpenDeviceChannelRaw(context, cq, tag));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncReaderWriterInterface< ::tunnelbroker::DeviceMessage, ::tunnelbroker::ServerMessage>> PrepareAsyncOpenDeviceChannel(::grpc::ClientContext* context, ::grpc::CompletionQueue* cq) {
+      return std::unique_ptr< ::grpc::ClientAsyncReaderWriterInterface< ::tunnelbroker::DeviceMessage, ::tunnelbroker::ServerMessage>>(PrepareAsyncOpenDeviceChannelRaw(context, cq));
+    }
     class async_interface {
      public:
       virtual ~async_interface() {}
@@ -65,6 +74,7 @@ class TunnelBrokerService final {
       virtual void BecomeNewPrimaryDevice(::grpc::ClientContext* context, const ::tunnelbroker::NewPrimaryRequest* request, ::tunnelbroker::NewPrimaryResponse* response, ::grpc::ClientUnaryReactor* reactor) = 0;
       virtual void SendPong(::grpc::ClientContext* context, const ::tunnelbroker::PongRequest* request, ::google::protobuf::Empty* response, std::function<void(::grpc::Status)>) = 0;
       virtual void SendPong(::grpc::ClientContext* context, const ::tunnelbroker::PongRequest* request, ::google::protobuf::Empty* response, ::grpc::ClientUnaryReactor* reactor) = 0;
+      virtual void OpenDeviceChannel(::grpc::ClientContext* context, ::grpc::ClientBidiReactor< ::tunnelbroker::DeviceMessage,::tunnelbroker::ServerMessage>* reactor) = 0;
     };
     typedef class async_interface experimental_async_interface;
     virtual class async_interface* async() { return nullptr; }
@@ -76,6 +86,9 @@ class TunnelBrokerService final {
     virtual ::grpc::ClientAsyncResponseReaderInterface< ::tunnelbroker::NewPrimaryResponse>* PrepareAsyncBecomeNewPrimaryDeviceRaw(::grpc::ClientContext* context, const ::tunnelbroker::NewPrimaryRequest& request, ::grpc::CompletionQueue* cq) = 0;
     virtual ::grpc::ClientAsyncResponseReaderInterface< ::google::protobuf::Empty>* AsyncSendPongRaw(::grpc::ClientContext* context, const ::tunnelbroker::PongRequest& request, ::grpc::CompletionQueue* cq) = 0;
     virtual ::grpc::ClientAsyncResponseReaderInterface< ::google::protobuf::Empty>* PrepareAsyncSendPongRaw(::grpc::ClientContext* context, const ::tunnelbroker::PongRequest& request, ::grpc::CompletionQueue* cq) = 0;
+    virtual ::grpc::ClientReaderWriterInterface< ::tunnelbroker::DeviceMessage, ::tunnelbroker::ServerMessage>* OpenDeviceChannelRaw(::grpc::ClientContext* context) = 0;
+    virtual ::grpc::ClientAsyncReaderWriterInterface< ::tunnelbroker::DeviceMessage, ::tunnelbroker::ServerMessage>* AsyncOpenDeviceChannelRaw(::grpc::ClientContext* context, ::grpc::CompletionQueue* cq, void* tag) = 0;
+    virtual ::grpc::ClientAsyncReaderWriterInterface< ::tunnelbroker::DeviceMessage, ::tunnelbroker::ServerMessage>* PrepareAsyncOpenDeviceChannelRaw(::grpc::ClientContext* context, ::grpc::CompletionQueue* cq) = 0;
   };
   class Stub final : public StubInterface {
    public:
@@ -101,6 +114,15 @@ class TunnelBrokerService final {
     std::unique_ptr< ::grpc::ClientAsyncResponseReader< ::google::protobuf::Empty>> PrepareAsyncSendPong(::grpc::ClientContext* context, const ::tunnelbroker::PongRequest& request, ::grpc::CompletionQueue* cq) {
       return std::unique_ptr< ::grpc::ClientAsyncResponseReader< ::google::protobuf::Empty>>(PrepareAsyncSendPongRaw(context, request, cq));
     }
+    std::unique_ptr< ::grpc::ClientReaderWriter< ::tunnelbroker::DeviceMessage, ::tunnelbroker::ServerMessage>> OpenDeviceChannel(::grpc::ClientContext* context) {
+      return std::unique_ptr< ::grpc::ClientReaderWriter< ::tunnelbroker::DeviceMessage, ::tunnelbroker::ServerMessage>>(OpenDeviceChannelRaw(context));
+    }
+    std::unique_ptr<  ::grpc::ClientAsyncReaderWriter< ::tunnelbroker::DeviceMessage, ::tunnelbroker::ServerMessage>> AsyncOpenDeviceChannel(::grpc::ClientContext* context, ::grpc::CompletionQueue* cq, void* tag) {
+      return std::unique_ptr< ::grpc::ClientAsyncReaderWriter< ::tunnelbroker::DeviceMessage, ::tunnelbroker::ServerMessage>>(AsyncOpenDeviceChannelRaw(context, cq, tag));
+    }
+    std::unique_ptr<  ::grpc::ClientAsyncReaderWriter< ::tunnelbroker::DeviceMessage, ::tunnelbroker::ServerMessage>> PrepareAsyncOpenDeviceChannel(::grpc::ClientContext* context, ::grpc::CompletionQueue* cq) {
+      return std::unique_ptr< ::grpc::ClientAsyncReaderWriter< ::tunnelbroker::DeviceMessage, ::tunnelbroker::ServerMessage>>(PrepareAsyncOpenDeviceChannelRaw(context, cq));
+    }
     class async final :
       public StubInterface::async_interface {
      public:
@@ -110,6 +132,7 @@ class TunnelBrokerService final {
       void BecomeNewPrimaryDevice(::grpc::ClientContext* context, const ::tunnelbroker::NewPrimaryRequest* request, ::tunnelbroker::NewPrimaryResponse* response, ::grpc::ClientUnaryReactor* reactor) override;
       void SendPong(::grpc::ClientContext* context, const ::tunnelbroker::PongRequest* request, ::google::protobuf::Empty* response, std::function<void(::grpc::Status)>) override;
       void SendPong(::grpc::ClientContext* context, const ::tunnelbroker::PongRequest* request, ::google::protobuf::Empty* response, ::grpc::ClientUnaryReactor* reactor) override;
+      void OpenDeviceChannel(::grpc::ClientContext* context, ::grpc::ClientBidiReactor< ::tunnelbroker::DeviceMessage,::tunnelbroker::ServerMessage>* reactor) override;
      private:
       friend class Stub;
       explicit async(Stub* stub): stub_(stub) { }
@@ -127,9 +150,13 @@ class TunnelBrokerService final {
     ::grpc::ClientAsyncResponseReader< ::tunnelbroker::NewPrimaryResponse>* PrepareAsyncBecomeNewPrimaryDeviceRaw(::grpc::ClientContext* context, const ::tunnelbroker::NewPrimaryRequest& request, ::grpc::CompletionQueue* cq) override;
     ::grpc::ClientAsyncResponseReader< ::google::protobuf::Empty>* AsyncSendPongRaw(::grpc::ClientContext* context, const ::tunnelbroker::PongRequest& request, ::grpc::CompletionQueue* cq) override;
     ::grpc::ClientAsyncResponseReader< ::google::protobuf::Empty>* PrepareAsyncSendPongRaw(::grpc::ClientContext* context, const ::tunnelbroker::PongRequest& request, ::grpc::CompletionQueue* cq) override;
+    ::grpc::ClientReaderWriter< ::tunnelbroker::DeviceMessage, ::tunnelbroker::ServerMessage>* OpenDeviceChannelRaw(::grpc::ClientContext* context) override;
+    ::grpc::ClientAsyncReaderWriter< ::tunnelbroker::DeviceMessage, ::tunnelbroker::ServerMessage>* AsyncOpenDeviceChannelRaw(::grpc::ClientContext* context, ::grpc::CompletionQueue* cq, void* tag) override;
+    ::grpc::ClientAsyncReaderWriter< ::tunnelbroker::DeviceMessage, ::tunnelbroker::ServerMessage>* PrepareAsyncOpenDeviceChannelRaw(::grpc::ClientContext* context, ::grpc::CompletionQueue* cq) override;
     const ::grpc::internal::RpcMethod rpcmethod_CheckIfPrimaryDeviceOnline_;
     const ::grpc::internal::RpcMethod rpcmethod_BecomeNewPrimaryDevice_;
     const ::grpc::internal::RpcMethod rpcmethod_SendPong_;
+    const ::grpc::internal::RpcMethod rpcmethod_OpenDeviceChannel_;
   };
   static std::unique_ptr<Stub> NewStub(const std::shared_ptr< ::grpc::ChannelInterface>& channel, const ::grpc::StubOptions& options = ::grpc::StubOptions());
 
@@ -140,6 +167,7 @@ class TunnelBrokerService final {
     virtual ::grpc::Status CheckIfPrimaryDeviceOnline(::grpc::ServerContext* context, const ::tunnelbroker::CheckRequest* request, ::tunnelbroker::CheckResponse* response);
     virtual ::grpc::Status BecomeNewPrimaryDevice(::grpc::ServerContext* context, const ::tunnelbroker::NewPrimaryRequest* request, ::tunnelbroker::NewPrimaryResponse* response);
     virtual ::grpc::Status SendPong(::grpc::ServerContext* context, const ::tunnelbroker::PongRequest* request, ::google::protobuf::Empty* response);
+    virtual ::grpc::Status OpenDeviceChannel(::grpc::ServerContext* context, ::grpc::ServerReaderWriter< ::tunnelbroker::ServerMessage, ::tunnelbroker::DeviceMessage>* stream);
   };
   template <class BaseClass>
   class WithAsyncMethod_CheckIfPrimaryDeviceOnline : public BaseClass {
@@ -201,7 +229,27 @@ class TunnelBrokerService final {
       ::grpc::Service::RequestAsyncUnary(2, context, request, response, new_call_cq, notification_cq, tag);
     }
   };
-  typedef WithAsyncMethod_CheckIfPrimaryDeviceOnline<WithAsyncMethod_BecomeNewPrimaryDevice<WithAsyncMethod_SendPong<Service > > > AsyncService;
+  template <class BaseClass>
+  class WithAsyncMethod_OpenDeviceChannel : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithAsyncMethod_OpenDeviceChannel() {
+      ::grpc::Service::MarkMethodAsync(3);
+    }
+    ~WithAsyncMethod_OpenDeviceChannel() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status OpenDeviceChannel(::grpc::ServerContext* /*context*/, ::grpc::ServerReaderWriter< ::tunnelbroker::ServerMessage, ::tunnelbroker::DeviceMessage>* /*stream*/)  override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    void RequestOpenDeviceChannel(::grpc::ServerContext* context, ::grpc::ServerAsyncReaderWriter< ::tunnelbroker::ServerMessage, ::tunnelbroker::DeviceMessage>* stream, ::grpc::CompletionQueue* new_call_cq, ::grpc::ServerCompletionQueue* notification_cq, void *tag) {
+      ::grpc::Service::RequestAsyncBidiStreaming(3, context, stream, new_call_cq, notification_cq, tag);
+    }
+  };
+  typedef WithAsyncMethod_CheckIfPrimaryDeviceOnline<WithAsyncMethod_BecomeNewPrimaryDevice<WithAsyncMethod_SendPong<WithAsyncMethod_OpenDeviceChannel<Service > > > > AsyncService;
   template <class BaseClass>
   class WithCallbackMethod_CheckIfPrimaryDeviceOnline : public BaseClass {
    private:
@@ -283,7 +331,30 @@ class TunnelBrokerService final {
     virtual ::grpc::ServerUnaryReactor* SendPong(
       ::grpc::CallbackServerContext* /*context*/, const ::tunnelbroker::PongRequest* /*request*/, ::google::protobuf::Empty* /*response*/)  { return nullptr; }
   };
-  typedef WithCallbackMethod_CheckIfPrimaryDeviceOnline<WithCallbackMethod_BecomeNewPrimaryDevice<WithCallbackMethod_SendPong<Service > > > CallbackService;
+  template <class BaseClass>
+  class WithCallbackMethod_OpenDeviceChannel : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithCallbackMethod_OpenDeviceChannel() {
+      ::grpc::Service::MarkMethodCallback(3,
+          new ::grpc::internal::CallbackBidiHandler< ::tunnelbroker::DeviceMessage, ::tunnelbroker::ServerMessage>(
+            [this](
+                   ::grpc::CallbackServerContext* context) { return this->OpenDeviceChannel(context); }));
+    }
+    ~WithCallbackMethod_OpenDeviceChannel() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status OpenDeviceChannel(::grpc::ServerContext* /*context*/, ::grpc::ServerReaderWriter< ::tunnelbroker::ServerMessage, ::tunnelbroker::DeviceMessage>* /*stream*/)  override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    virtual ::grpc::ServerBidiReactor< ::tunnelbroker::DeviceMessage, ::tunnelbroker::ServerMessage>* OpenDeviceChannel(
+      ::grpc::CallbackServerContext* /*context*/)
+      { return nullptr; }
+  };
+  typedef WithCallbackMethod_CheckIfPrimaryDeviceOnline<WithCallbackMethod_BecomeNewPrimaryDevice<WithCallbackMethod_SendPong<WithCallbackMethod_OpenDeviceChannel<Service > > > > CallbackService;
   typedef CallbackService ExperimentalCallbackService;
   template <class BaseClass>
   class WithGenericMethod_CheckIfPrimaryDeviceOnline : public BaseClass {
@@ -337,6 +408,23 @@ class TunnelBrokerService final {
     }
   };
   template <class BaseClass>
+  class WithGenericMethod_OpenDeviceChannel : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithGenericMethod_OpenDeviceChannel() {
+      ::grpc::Service::MarkMethodGeneric(3);
+    }
+    ~WithGenericMethod_OpenDeviceChannel() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status OpenDeviceChannel(::grpc::ServerContext* /*context*/, ::grpc::ServerReaderWriter< ::tunnelbroker::ServerMessage, ::tunnelbroker::DeviceMessage>* /*stream*/)  override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+  };
+  template <class BaseClass>
   class WithRawMethod_CheckIfPrimaryDeviceOnline : public BaseClass {
    private:
     void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
@@ -397,6 +485,26 @@ class TunnelBrokerService final {
     }
   };
   template <class BaseClass>
+  class WithRawMethod_OpenDeviceChannel : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithRawMethod_OpenDeviceChannel() {
+      ::grpc::Service::MarkMethodRaw(3);
+    }
+    ~WithRawMethod_OpenDeviceChannel() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status OpenDeviceChannel(::grpc::ServerContext* /*context*/, ::grpc::ServerReaderWriter< ::tunnelbroker::ServerMessage, ::tunnelbroker::DeviceMessage>* /*stream*/)  override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    void RequestOpenDeviceChannel(::grpc::ServerContext* context, ::grpc::ServerAsyncReaderWriter< ::grpc::ByteBuffer, ::grpc::ByteBuffer>* stream, ::grpc::CompletionQueue* new_call_cq, ::grpc::ServerCompletionQueue* notification_cq, void *tag) {
+      ::grpc::Service::RequestAsyncBidiStreaming(3, context, stream, new_call_cq, notification_cq, tag);
+    }
+  };
+  template <class BaseClass>
   class WithRawCallbackMethod_CheckIfPrimaryDeviceOnline : public BaseClass {
    private:
     void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
@@ -463,6 +571,29 @@ class TunnelBrokerService final {
       ::grpc::CallbackServerContext* /*context*/, const ::grpc::ByteBuffer* /*request*/, ::grpc::ByteBuffer* /*response*/)  { return nullptr; }
   };
   template <class BaseClass>
+  class WithRawCallbackMethod_OpenDeviceChannel : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithRawCallbackMethod_OpenDeviceChannel() {
+      ::grpc::Service::MarkMethodRawCallback(3,
+          new ::grpc::internal::CallbackBidiHandler< ::grpc::ByteBuffer, ::grpc::ByteBuffer>(
+            [this](
+                   ::grpc::CallbackServerContext* context) { return this->OpenDeviceChannel(context); }));
+    }
+    ~WithRawCallbackMethod_OpenDeviceChannel() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status OpenDeviceChannel(::grpc::ServerContext* /*context*/, ::grpc::ServerReaderWriter< ::tunnelbroker::ServerMessage, ::tunnelbroker::DeviceMessage>* /*stream*/)  override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    virtual ::grpc::ServerBidiReactor< ::grpc::ByteBuffer, ::grpc::ByteBuffer>* OpenDeviceChannel(
+      ::grpc::CallbackServerContext* /*context*/)
+      { return nullptr; }
+  };
+  template <class BaseClass>
   class WithStreamedUnaryMethod_CheckIfPrimaryDeviceOnline : public BaseClass {
    private:
     void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
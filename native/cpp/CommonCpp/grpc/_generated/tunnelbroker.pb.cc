@@ -81,8 +81,67 @@ struct PongRequestDefaultTypeInternal {
   };
 };
 PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PongRequestDefaultTypeInternal _PongRequest_default_instance_;
+constexpr DeviceHello::DeviceHello(
+  ::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized)
+  : userid_(&::PROTOBUF_NAMESPACE_ID::internal::fixed_address_empty_string)
+  , devicetoken_(&::PROTOBUF_NAMESPACE_ID::internal::fixed_address_empty_string){}
+struct DeviceHelloDefaultTypeInternal {
+  constexpr DeviceHelloDefaultTypeInternal()
+    : _instance(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized{}) {}
+  ~DeviceHelloDefaultTypeInternal() {}
+  union {
+    DeviceHello _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT DeviceHelloDefaultTypeInternal _DeviceHello_default_instance_;
+constexpr DevicePong::DevicePong(
+  ::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized){}
+struct DevicePongDefaultTypeInternal {
+  constexpr DevicePongDefaultTypeInternal()
+    : _instance(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized{}) {}
+  ~DevicePongDefaultTypeInternal() {}
+  union {
+    DevicePong _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT DevicePongDefaultTypeInternal _DevicePong_default_instance_;
+constexpr DeviceMessage::DeviceMessage(
+  ::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized)
+  : _oneof_case_{}{}
+struct DeviceMessageDefaultTypeInternal {
+  constexpr DeviceMessageDefaultTypeInternal()
+    : _instance(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized{}) {}
+  ~DeviceMessageDefaultTypeInternal() {}
+  union {
+    DeviceMessage _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT DeviceMessageDefaultTypeInternal _DeviceMessage_default_instance_;
+constexpr ServerPing::ServerPing(
+  ::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized){}
+struct ServerPingDefaultTypeInternal {
+  constexpr ServerPingDefaultTypeInternal()
+    : _instance(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized{}) {}
+  ~ServerPingDefaultTypeInternal() {}
+  union {
+    ServerPing _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT ServerPingDefaultTypeInternal _ServerPing_default_instance_;
+constexpr ServerMessage::ServerMessage(
+  ::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized)
+  : _oneof_case_{}{}
+struct ServerMessageDefaultTypeInternal {
+  constexpr ServerMessageDefaultTypeInternal()
+    : _instance(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized{}) {}
+  ~ServerMessageDefaultTypeInternal() {}
+  union {
+    ServerMessage _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT ServerMessageDefaultTypeInternal _ServerMessage_default_instance_;
 }  // namespace tunnelbroker
-static ::PROTOBUF_NAMESPACE_ID::Metadata file_level_metadata_tunnelbroker_2eproto[5];
+static ::PROTOBUF_NAMESPACE_ID::Metadata file_level_metadata_tunnelbroker_2eproto[10];
 static const ::PROTOBUF_NAMESPACE_ID::EnumDescriptor* file_level_enum_descriptors_tunnelbroker_2eproto[1];
 static constexpr ::PROTOBUF_NAMESPACE_ID::ServiceDescriptor const** file_level_service_descriptors_tunnelbroker_2eproto = nullptr;
 
@@ -120,6 +179,38 @@ const ::PROTOBUF_NAMESPACE_ID::uint32 TableStruct_tunnelbroker_2eproto::offsets[
   ~0u,  // no _weak_field_map_
   PROTOBUF_FIELD_OFFSET(::tunnelbroker::PongRequest, userid_),
   PROTOBUF_FIELD_OFFSET(::tunnelbroker::PongRequest, devicetoken_),
+  ~0u,  // no _has_bits_
+  PROTOBUF_FIELD_OFFSET(::tunnelbroker::DeviceHello, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  PROTOBUF_FIELD_OFFSET(::tunnelbroker::DeviceHello, userid_),
+  PROTOBUF_FIELD_OFFSET(::tunnelbroker::DeviceHello, devicetoken_),
+  ~0u,  // no _has_bits_
+  PROTOBUF_FIELD_OFFSET(::tunnelbroker::DevicePong, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _has_bits_
+  PROTOBUF_FIELD_OFFSET(::tunnelbroker::DeviceMessage, _internal_metadata_),
+  ~0u,  // no _extensions_
+  PROTOBUF_FIELD_OFFSET(::tunnelbroker::DeviceMessage, _oneof_case_[0]),
+  ~0u,  // no _weak_field_map_
+  ::PROTOBUF_NAMESPACE_ID::internal::kInvalidFieldOffsetTag,
+  ::PROTOBUF_NAMESPACE_ID::internal::kInvalidFieldOffsetTag,
+  PROTOBUF_FIELD_OFFSET(::tunnelbroker::DeviceMessage, data_),
+  ~0u,  // no _has_bits_
+  PROTOBUF_FIELD_OFFSET(::tunnelbroker::ServerPing, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _has_bits_
+  PROTOBUF_FIELD_OFFSET(::tunnelbroker::ServerMessage, _internal_metadata_),
+  ~0u,  // no _extensions_
+  PROTOBUF_FIELD_OFFSET(::tunnelbroker::ServerMessage, _oneof_case_[0]),
+  ~0u,  // no _weak_field_map_
+  ::PROTOBUF_NAMESPACE_ID::internal::kInvalidFieldOffsetTag,
+  PROTOBUF_FIELD_OFFSET(::tunnelbroker::ServerMessage, data_),
 };
 static const ::PROTOBUF_NAMESPACE_ID::internal::MigrationSchema schemas[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
   { 0, -1, sizeof(::tunnelbroker::CheckRequest)},
@@ -127,6 +218,11 @@ static const ::PROTOBUF_NAMESPACE_ID::internal::MigrationSchema schemas[] PROTOB
   { 13, -1, sizeof(::tunnelbroker::NewPrimaryRequest)},
   { 20, -1, sizeof(::tunnelbroker::NewPrimaryResponse)},
   { 26, -1, sizeof(::tunnelbroker::PongRequest)},
+  { 33, -1, sizeof(::tunnelbroker::DeviceHello)},
+  { 40, -1, sizeof(::tunnelbroker::DevicePong)},
+  { 45, -1, sizeof(::tunnelbroker::DeviceMessage)},
+  { 53, -1, sizeof(::tunnelbroker::ServerPing)},
+  { 58, -1, sizeof(::tunnelbroker::ServerMessage)},
 };
 
 static ::PROTOBUF_NAMESPACE_ID::Message const * const file_default_instances[] = {
@@ -135,6 +231,11 @@ static ::PROTOBUF_NAMESPACE_ID::Message const * const file_default_instances[] =
   reinterpret_cast<const ::PROTOBUF_NAMESPACE_ID::Message*>(&::tunnelbroker::_NewPrimaryRequest_default_instance_),
   reinterpret_cast<const ::PROTOBUF_NAMESPACE_ID::Message*>(&::tunnelbroker::_NewPrimaryResponse_default_instance_),
   reinterpret_cast<const ::PROTOBUF_NAMESPACE_ID::Message*>(&::tunnelbroker::_PongRequest_default_instance_),
+  reinterpret_cast<const ::PROTOBUF_NAMESPACE_ID::Message*>(&::tunnelbroker::_DeviceHello_default_instance_),
+  reinterpret_cast<const ::PROTOBUF_NAMESPACE_ID::Message*>(&::tunnelbroker::_DevicePong_default_instance_),
+  reinterpret_cast<const ::PROTOBUF_NAMESPACE_ID::Message*>(&::tunnelbroker::_DeviceMessage_default_instance_),
+  reinterpret_cast<const ::PROTOBUF_NAMESPACE_ID::Message*>(&::tunnelbroker::_ServerPing_default_instance_),
+  reinterpret_cast<const ::PROTOBUF_NAMESPACE_ID::Message*>(&::tunnelbroker::_ServerMessage_default_instance_),
 };
 
 const char descriptor_table_protodef_tunnelbroker_2eproto[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) =
@@ -146,25 +247,33 @@ const char descriptor_table_protodef_tunnelbroker_2eproto[] PROTOBUF_SECTION_VAR
   "PrimaryRequest\022\016\n\006userId\030\001 \001(\t\022\023\n\013device"
   "Token\030\002 \001(\t\"%\n\022NewPrimaryResponse\022\017\n\007suc"
   "cess\030\001 \001(\010\"2\n\013PongRequest\022\016\n\006userId\030\001 \001("
-  "\t\022\023\n\013deviceToken\030\002 \001(\t*n\n\021CheckResponseT"
-  "ype\022\030\n\024PRIMARY_DOESNT_EXIST\020\000\022\022\n\016PRIMARY"
-  "_ONLINE\020\001\022\023\n\017PRIMARY_OFFLINE\020\002\022\026\n\022CURREN"
-  "T_IS_PRIMARY\020\0032\216\002\n\023TunnelBrokerService\022W"
-  "\n\032CheckIfPrimaryDeviceOnline\022\032.tunnelbro"
-  "ker.CheckRequest\032\033.tunnelbroker.CheckRes"
-  "ponse\"\000\022]\n\026BecomeNewPrimaryDevice\022\037.tunn"
-  "elbroker.NewPrimaryRequest\032 .tunnelbroke"
-  "r.NewPrimaryResponse\"\000\022\?\n\010SendPong\022\031.tun"
-  "nelbroker.PongRequest\032\026.google.protobuf."
-  "Empty\"\000b\006proto3"
+  "\t\022\023\n\013deviceToken\030\002 \001(\t\"2\n\013DeviceHello\022\016\n"
+  "\006userId\030\001 \001(\t\022\023\n\013deviceToken\030\002 \001(\t\"\014\n\nDe"
+  "vicePong\"m\n\rDeviceMessage\022*\n\005hello\030\001 \001(\013"
+  "2\031.tunnelbroker.DeviceHelloH\000\022(\n\004pong\030\002 "
+  "\001(\0132\030.tunnelbroker.DevicePongH\000B\006\n\004data\""
+  "\014\n\nServerPing\"A\n\rServerMessage\022(\n\004ping\030\001"
+  " \001(\0132\030.tunnelbroker.ServerPingH\000B\006\n\004data"
+  "*n\n\021CheckResponseType\022\030\n\024PRIMARY_DOESNT_"
+  "EXIST\020\000\022\022\n\016PRIMARY_ONLINE\020\001\022\023\n\017PRIMARY_O"
+  "FFLINE\020\002\022\026\n\022CURRENT_IS_PRIMARY\020\0032\343\002\n\023Tun"
+  "nelBrokerService\022W\n\032CheckIfPrimaryDevice"
+  "Online\022\032.tunnelbroker.CheckRequest\032\033.tun"
+  "nelbroker.CheckResponse\"\000\022]\n\026BecomeNewPr"
+  "imaryDevice\022\037.tunnelbroker.NewPrimaryReq"
+  "uest\032 .tunnelbroker.NewPrimaryResponse\"\000"
+  "\022\?\n\010SendPong\022\031.tunnelbroker.PongRequest\032"
+  "\026.google.protobuf.Empty\"\000\022S\n\021OpenDeviceC"
+  "hannel\022\033.tunnelbroker.DeviceMessage\032\033.tu"
+  "nnelbroker.ServerMessage\"\000(\0010\001b\006proto3"
   ;
 static const ::PROTOBUF_NAMESPACE_ID::internal::DescriptorTable*const descriptor_table_tunnelbroker_2eproto_deps[1] = {
   &::descriptor_table_google_2fprotobuf_2fempty_2eproto,
 };
 static ::PROTOBUF_NAMESPACE_ID::internal::once_flag descriptor_table_tunnelbroker_2eproto_once;
 const ::PROTOBUF_NAMESPACE_ID::internal::DescriptorTable descriptor_table_tunnelbroker_2eproto = {
-  false, false, 735, descriptor_table_protodef_tunnelbroker_2eproto, "tunnelbroker.proto", 
-  &descriptor_table_tunnelbroker_2eproto_once, descriptor_table_tunnelbroker_2eproto_deps, 1, 5,
+  false, false, 1078, descriptor_table_protodef_tunnelbroker_2eproto, "tunnelbroker.proto", 
+  &descriptor_table_tunnelbroker_2eproto_once, descriptor_table_tunnelbroker_2eproto_deps, 1, 10,
   schemas, file_default_instances, TableStruct_tunnelbroker_2eproto::offsets,
   file_level_metadata_tunnelbroker_2eproto, file_level_enum_descriptors_tunnelbroker_2eproto, file_level_service_descriptors_tunnelbroker_2eproto,
 };
@@ -1285,23 +1394,1150 @@ void PongRequest::InternalSwap(PongRequest* other) {
 }
 
 
-// @@protoc_insertion_point(namespace_scope)
-}  // namespace tunnelbroker
-PROTOBUF_NAMESPACE_OPEN
-template<> PROTOBUF_NOINLINE ::tunnelbroker::CheckRequest* Arena::CreateMaybeMessage< ::tunnelbroker::CheckRequest >(Arena* arena) {
-  return Arena::CreateMessageInternal< ::tunnelbroker::CheckRequest >(arena);
+// ===================================================================
+
+class DeviceHello::_Internal {
+ public:
+};
+
+DeviceHello::DeviceHello(::PROTOBUF_NAMESPACE_ID::Arena* arena)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena) {
+  SharedCtor();
+  RegisterArenaDtor(arena);
+  // @@protoc_insertion_point(arena_constructor:tunnelbroker.DeviceHello)
 }
-template<> PROTOBUF_NOINLINE ::tunnelbroker::CheckResponse* Arena::CreateMaybeMessage< ::tunnelbroker::CheckResponse >(Arena* arena) {
-  return Arena::CreateMessageInternal< ::tunnelbroker::CheckResponse >(arena);
+DeviceHello::DeviceHello(const DeviceHello& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  userid_.UnsafeSetDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
+  if (!from._internal_userid().empty()) {
+    userid_.Set(::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::EmptyDefault{}, from._internal_userid(), 
+      GetArena());
+  }
+  devicetoken_.UnsafeSetDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
+  if (!from._internal_devicetoken().empty()) {
+    devicetoken_.Set(::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::EmptyDefault{}, from._internal_devicetoken(), 
+      GetArena());
+  }
+  // @@protoc_insertion_point(copy_constructor:tunnelbroker.DeviceHello)
 }
-template<> PROTOBUF_NOINLINE ::tunnelbroker::NewPrimaryRequest* Arena::CreateMaybeMessage< ::tunnelbroker::NewPrimaryRequest >(Arena* arena) {
-  return Arena::CreateMessageInternal< ::tunnelbroker::NewPrimaryRequest >(arena);
+
+void DeviceHello::SharedCtor() {
+userid_.UnsafeSetDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
+devicetoken_.UnsafeSetDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
 }
-template<> PROTOBUF_NOINLINE ::tunnelbroker::NewPrimaryResponse* Arena::CreateMaybeMessage< ::tunnelbroker::NewPrimaryResponse >(Arena* arena) {
-  return Arena::CreateMessageInternal< ::tunnelbroker::NewPrimaryResponse >(arena);
+
+DeviceHello::~DeviceHello() {
+  // @@protoc_insertion_point(destructor:tunnelbroker.DeviceHello)
+  SharedDtor();
+  _internal_metadata_.Delete<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
 }
-template<> PROTOBUF_NOINLINE ::tunnelbroker::PongRequest* Arena::CreateMaybeMessage< ::tunnelbroker::PongRequest >(Arena* arena) {
-  return Arena::CreateMessageInternal< ::tunnelbroker::PongRequest >(arena);
+
+void DeviceHello::SharedDtor() {
+  GOOGLE_DCHECK(GetArena() == nullptr);
+  userid_.DestroyNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
+  devicetoken_.DestroyNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
+}
+
+void DeviceHello::ArenaDtor(void* object) {
+  DeviceHello* _this = reinterpret_cast< DeviceHello* >(object);
+  (void)_this;
+}
+void DeviceHello::RegisterArenaDtor(::PROTOBUF_NAMESPACE_ID::Arena*) {
+}
+void DeviceHello::SetCachedSize(int size) const {
+  _cached_size_.Set(size);
+}
+
+void DeviceHello::Clear() {
+// @@protoc_insertion_point(message_clear_start:tunnelbroker.DeviceHello)
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  userid_.ClearToEmpty();
+  devicetoken_.ClearToEmpty();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* DeviceHello::_InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  while (!ctx->Done(&ptr)) {
+    ::PROTOBUF_NAMESPACE_ID::uint32 tag;
+    ptr = ::PROTOBUF_NAMESPACE_ID::internal::ReadTag(ptr, &tag);
+    CHK_(ptr);
+    switch (tag >> 3) {
+      // string userId = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 10)) {
+          auto str = _internal_mutable_userid();
+          ptr = ::PROTOBUF_NAMESPACE_ID::internal::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(::PROTOBUF_NAMESPACE_ID::internal::VerifyUTF8(str, "tunnelbroker.DeviceHello.userId"));
+          CHK_(ptr);
+        } else goto handle_unusual;
+        continue;
+      // string deviceToken = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 18)) {
+          auto str = _internal_mutable_devicetoken();
+          ptr = ::PROTOBUF_NAMESPACE_ID::internal::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(::PROTOBUF_NAMESPACE_ID::internal::VerifyUTF8(str, "tunnelbroker.DeviceHello.deviceToken"));
+          CHK_(ptr);
+        } else goto handle_unusual;
+        continue;
+      default: {
+      handle_unusual:
+        if ((tag & 7) == 4 || tag == 0) {
+          ctx->SetLastTag(tag);
+          goto success;
+        }
+        ptr = UnknownFieldParse(tag,
+            _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+            ptr, ctx);
+        CHK_(ptr != nullptr);
+        continue;
+      }
+    }  // switch
+  }  // while
+success:
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto success;
+#undef CHK_
+}
+
+::PROTOBUF_NAMESPACE_ID::uint8* DeviceHello::_InternalSerialize(
+    ::PROTOBUF_NAMESPACE_ID::uint8* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:tunnelbroker.DeviceHello)
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // string userId = 1;
+  if (this->userid().size() > 0) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::VerifyUtf8String(
+      this->_internal_userid().data(), static_cast<int>(this->_internal_userid().length()),
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::SERIALIZE,
+      "tunnelbroker.DeviceHello.userId");
+    target = stream->WriteStringMaybeAliased(
+        1, this->_internal_userid(), target);
+  }
+
+  // string deviceToken = 2;
+  if (this->devicetoken().size() > 0) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::VerifyUtf8String(
+      this->_internal_devicetoken().data(), static_cast<int>(this->_internal_devicetoken().length()),
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::SERIALIZE,
+      "tunnelbroker.DeviceHello.deviceToken");
+    target = stream->WriteStringMaybeAliased(
+        2, this->_internal_devicetoken(), target);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:tunnelbroker.DeviceHello)
+  return target;
+}
+
+size_t DeviceHello::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:tunnelbroker.DeviceHello)
+  size_t total_size = 0;
+
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // string userId = 1;
+  if (this->userid().size() > 0) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+        this->_internal_userid());
+  }
+
+  // string deviceToken = 2;
+  if (this->devicetoken().size() > 0) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+        this->_internal_devicetoken());
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    return ::PROTOBUF_NAMESPACE_ID::internal::ComputeUnknownFieldsSize(
+        _internal_metadata_, total_size, &_cached_size_);
+  }
+  int cached_size = ::PROTOBUF_NAMESPACE_ID::internal::ToCachedSize(total_size);
+  SetCachedSize(cached_size);
+  return total_size;
+}
+
+void DeviceHello::MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) {
+// @@protoc_insertion_point(generalized_merge_from_start:tunnelbroker.DeviceHello)
+  GOOGLE_DCHECK_NE(&from, this);
+  const DeviceHello* source =
+      ::PROTOBUF_NAMESPACE_ID::DynamicCastToGenerated<DeviceHello>(
+          &from);
+  if (source == nullptr) {
+  // @@protoc_insertion_point(generalized_merge_from_cast_fail:tunnelbroker.DeviceHello)
+    ::PROTOBUF_NAMESPACE_ID::internal::ReflectionOps::Merge(from, this);
+  } else {
+  // @@protoc_insertion_point(generalized_merge_from_cast_success:tunnelbroker.DeviceHello)
+    MergeFrom(*source);
+  }
+}
+
+void DeviceHello::MergeFrom(const DeviceHello& from) {
+// @@protoc_insertion_point(class_specific_merge_from_start:tunnelbroker.DeviceHello)
+  GOOGLE_DCHECK_NE(&from, this);
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  if (from.userid().size() > 0) {
+    _internal_set_userid(from._internal_userid());
+  }
+  if (from.devicetoken().size() > 0) {
+    _internal_set_devicetoken(from._internal_devicetoken());
+  }
+}
+
+void DeviceHello::CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) {
+// @@protoc_insertion_point(generalized_copy_from_start:tunnelbroker.DeviceHello)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+void DeviceHello::CopyFrom(const DeviceHello& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:tunnelbroker.DeviceHello)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool DeviceHello::IsInitialized() const {
+  return true;
+}
+
+void DeviceHello::InternalSwap(DeviceHello* other) {
+  using std::swap;
+  _internal_metadata_.Swap<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(&other->_internal_metadata_);
+  userid_.Swap(&other->userid_, &::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
+  devicetoken_.Swap(&other->devicetoken_, &::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata DeviceHello::GetMetadata() const {
+  return GetMetadataStatic();
+}
+
+
+// ===================================================================
+
+class DevicePong::_Internal {
+ public:
+};
+
+DevicePong::DevicePong(::PROTOBUF_NAMESPACE_ID::Arena* arena)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena) {
+  SharedCtor();
+  RegisterArenaDtor(arena);
+  // @@protoc_insertion_point(arena_constructor:tunnelbroker.DevicePong)
+}
+DevicePong::DevicePong(const DevicePong& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  // @@protoc_insertion_point(copy_constructor:tunnelbroker.DevicePong)
+}
+
+void DevicePong::SharedCtor() {
+}
+
+DevicePong::~DevicePong() {
+  // @@protoc_insertion_point(destructor:tunnelbroker.DevicePong)
+  SharedDtor();
+  _internal_metadata_.Delete<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+void DevicePong::SharedDtor() {
+  GOOGLE_DCHECK(GetArena() == nullptr);
+}
+
+void DevicePong::ArenaDtor(void* object) {
+  DevicePong* _this = reinterpret_cast< DevicePong* >(object);
+  (void)_this;
+}
+void DevicePong::RegisterArenaDtor(::PROTOBUF_NAMESPACE_ID::Arena*) {
+}
+void DevicePong::SetCachedSize(int size) const {
+  _cached_size_.Set(size);
+}
+
+void DevicePong::Clear() {
+// @@protoc_insertion_point(message_clear_start:tunnelbroker.DevicePong)
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* DevicePong::_InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  while (!ctx->Done(&ptr)) {
+    ::PROTOBUF_NAMESPACE_ID::uint32 tag;
+    ptr = ::PROTOBUF_NAMESPACE_ID::internal::ReadTag(ptr, &tag);
+    CHK_(ptr);
+        if ((tag & 7) == 4 || tag == 0) {
+          ctx->SetLastTag(tag);
+          goto success;
+        }
+        ptr = UnknownFieldParse(tag,
+            _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+            ptr, ctx);
+        CHK_(ptr != nullptr);
+        continue;
+  }  // while
+success:
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto success;
+#undef CHK_
+}
+
+::PROTOBUF_NAMESPACE_ID::uint8* DevicePong::_InternalSerialize(
+    ::PROTOBUF_NAMESPACE_ID::uint8* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:tunnelbroker.DevicePong)
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:tunnelbroker.DevicePong)
+  return target;
+}
+
+size_t DevicePong::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:tunnelbroker.DevicePong)
+  size_t total_size = 0;
+
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    return ::PROTOBUF_NAMESPACE_ID::internal::ComputeUnknownFieldsSize(
+        _internal_metadata_, total_size, &_cached_size_);
+  }
+  int cached_size = ::PROTOBUF_NAMESPACE_ID::internal::ToCachedSize(total_size);
+  SetCachedSize(cached_size);
+  return total_size;
+}
+
+void DevicePong::MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) {
+// @@protoc_insertion_point(generalized_merge_from_start:tunnelbroker.DevicePong)
+  GOOGLE_DCHECK_NE(&from, this);
+  const DevicePong* source =
+      ::PROTOBUF_NAMESPACE_ID::DynamicCastToGenerated<DevicePong>(
+          &from);
+  if (source == nullptr) {
+  // @@protoc_insertion_point(generalized_merge_from_cast_fail:tunnelbroker.DevicePong)
+    ::PROTOBUF_NAMESPACE_ID::internal::ReflectionOps::Merge(from, this);
+  } else {
+  // @@protoc_insertion_point(generalized_merge_from_cast_success:tunnelbroker.DevicePong)
+    MergeFrom(*source);
+  }
+}
+
+void DevicePong::MergeFrom(const DevicePong& from) {
+// @@protoc_insertion_point(class_specific_merge_from_start:tunnelbroker.DevicePong)
+  GOOGLE_DCHECK_NE(&from, this);
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+}
+
+void DevicePong::CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) {
+// @@protoc_insertion_point(generalized_copy_from_start:tunnelbroker.DevicePong)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+void DevicePong::CopyFrom(const DevicePong& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:tunnelbroker.DevicePong)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool DevicePong::IsInitialized() const {
+  return true;
+}
+
+void DevicePong::InternalSwap(DevicePong* other) {
+  using std::swap;
+  _internal_metadata_.Swap<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(&other->_internal_metadata_);
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata DevicePong::GetMetadata() const {
+  return GetMetadataStatic();
+}
+
+
+// ===================================================================
+
+class DeviceMessage::_Internal {
+ public:
+  static const ::tunnelbroker::DeviceHello& hello(const DeviceMessage* msg);
+  static const ::tunnelbroker::DevicePong& pong(const DeviceMessage* msg);
+};
+
+const ::tunnelbroker::DeviceHello&
+DeviceMessage::_Internal::hello(const DeviceMessage* msg) {
+  return *msg->data_.hello_;
+}
+const ::tunnelbroker::DevicePong&
+DeviceMessage::_Internal::pong(const DeviceMessage* msg) {
+  return *msg->data_.pong_;
+}
+void DeviceMessage::set_allocated_hello(::tunnelbroker::DeviceHello* hello) {
+  ::PROTOBUF_NAMESPACE_ID::Arena* message_arena = GetArena();
+  clear_data();
+  if (hello) {
+    ::PROTOBUF_NAMESPACE_ID::Arena* submessage_arena =
+      ::PROTOBUF_NAMESPACE_ID::Arena::GetArena(hello);
+    if (message_arena != submessage_arena) {
+      hello = ::PROTOBUF_NAMESPACE_ID::internal::GetOwnedMessage(
+          message_arena, hello, submessage_arena);
+    }
+    set_has_hello();
+    data_.hello_ = hello;
+  }
+  // @@protoc_insertion_point(field_set_allocated:tunnelbroker.DeviceMessage.hello)
+}
+void DeviceMessage::set_allocated_pong(::tunnelbroker::DevicePong* pong) {
+  ::PROTOBUF_NAMESPACE_ID::Arena* message_arena = GetArena();
+  clear_data();
+  if (pong) {
+    ::PROTOBUF_NAMESPACE_ID::Arena* submessage_arena =
+      ::PROTOBUF_NAMESPACE_ID::Arena::GetArena(pong);
+    if (message_arena != submessage_arena) {
+      pong = ::PROTOBUF_NAMESPACE_ID::internal::GetOwnedMessage(
+          message_arena, pong, submessage_arena);
+    }
+    set_has_pong();
+    data_.pong_ = pong;
+  }
+  // @@protoc_insertion_point(field_set_allocated:tunnelbroker.DeviceMessage.pong)
+}
+DeviceMessage::DeviceMessage(::PROTOBUF_NAMESPACE_ID::Arena* arena)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena) {
+  SharedCtor();
+  RegisterArenaDtor(arena);
+  // @@protoc_insertion_point(arena_constructor:tunnelbroker.DeviceMessage)
+}
+DeviceMessage::DeviceMessage(const DeviceMessage& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  clear_has_data();
+  switch (from.data_case()) {
+    case kHello: {
+      _internal_mutable_hello()->::tunnelbroker::DeviceHello::MergeFrom(from._internal_hello());
+      break;
+    }
+    case kPong: {
+      _internal_mutable_pong()->::tunnelbroker::DevicePong::MergeFrom(from._internal_pong());
+      break;
+    }
+    case DATA_NOT_SET: {
+      break;
+    }
+  }
+  // @@protoc_insertion_point(copy_constructor:tunnelbroker.DeviceMessage)
+}
+
+void DeviceMessage::SharedCtor() {
+clear_has_data();
+}
+
+DeviceMessage::~DeviceMessage() {
+  // @@protoc_insertion_point(destructor:tunnelbroker.DeviceMessage)
+  SharedDtor();
+  _internal_metadata_.Delete<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+void DeviceMessage::SharedDtor() {
+  GOOGLE_DCHECK(GetArena() == nullptr);
+  if (has_data()) {
+    clear_data();
+  }
+}
+
+void DeviceMessage::ArenaDtor(void* object) {
+  DeviceMessage* _this = reinterpret_cast< DeviceMessage* >(object);
+  (void)_this;
+}
+void DeviceMessage::RegisterArenaDtor(::PROTOBUF_NAMESPACE_ID::Arena*) {
+}
+void DeviceMessage::SetCachedSize(int size) const {
+  _cached_size_.Set(size);
+}
+
+void DeviceMessage::clear_data() {
+// @@protoc_insertion_point(one_of_clear_start:tunnelbroker.DeviceMessage)
+  switch (data_case()) {
+    case kHello: {
+      if (GetArena() == nullptr) {
+        delete data_.hello_;
+      }
+      break;
+    }
+    case kPong: {
+      if (GetArena() == nullptr) {
+        delete data_.pong_;
+      }
+      break;
+    }
+    case DATA_NOT_SET: {
+      break;
+    }
+  }
+  _oneof_case_[0] = DATA_NOT_SET;
+}
+
+
+void DeviceMessage::Clear() {
+// @@protoc_insertion_point(message_clear_start:tunnelbroker.DeviceMessage)
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  clear_data();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* DeviceMessage::_InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  while (!ctx->Done(&ptr)) {
+    ::PROTOBUF_NAMESPACE_ID::uint32 tag;
+    ptr = ::PROTOBUF_NAMESPACE_ID::internal::ReadTag(ptr, &tag);
+    CHK_(ptr);
+    switch (tag >> 3) {
+      // .tunnelbroker.DeviceHello hello = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 10)) {
+          ptr = ctx->ParseMessage(_internal_mutable_hello(), ptr);
+          CHK_(ptr);
+        } else goto handle_unusual;
+        continue;
+      // .tunnelbroker.DevicePong pong = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 18)) {
+          ptr = ctx->ParseMessage(_internal_mutable_pong(), ptr);
+          CHK_(ptr);
+        } else goto handle_unusual;
+        continue;
+      default: {
+      handle_unusual:
+        if ((tag & 7) == 4 || tag == 0) {
+          ctx->SetLastTag(tag);
+          goto success;
+        }
+        ptr = UnknownFieldParse(tag,
+            _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+            ptr, ctx);
+        CHK_(ptr != nullptr);
+        continue;
+      }
+    }  // switch
+  }  // while
+success:
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto success;
+#undef CHK_
+}
+
+::PROTOBUF_NAMESPACE_ID::uint8* DeviceMessage::_InternalSerialize(
+    ::PROTOBUF_NAMESPACE_ID::uint8* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:tunnelbroker.DeviceMessage)
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // .tunnelbroker.DeviceHello hello = 1;
+  if (_internal_has_hello()) {
+    target = stream->EnsureSpace(target);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(
+        1, _Internal::hello(this), target, stream);
+  }
+
+  // .tunnelbroker.DevicePong pong = 2;
+  if (_internal_has_pong()) {
+    target = stream->EnsureSpace(target);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(
+        2, _Internal::pong(this), target, stream);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:tunnelbroker.DeviceMessage)
+  return target;
+}
+
+size_t DeviceMessage::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:tunnelbroker.DeviceMessage)
+  size_t total_size = 0;
+
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  switch (data_case()) {
+    // .tunnelbroker.DeviceHello hello = 1;
+    case kHello: {
+      total_size += 1 +
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *data_.hello_);
+      break;
+    }
+    // .tunnelbroker.DevicePong pong = 2;
+    case kPong: {
+      total_size += 1 +
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *data_.pong_);
+      break;
+    }
+    case DATA_NOT_SET: {
+      break;
+    }
+  }
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    return ::PROTOBUF_NAMESPACE_ID::internal::ComputeUnknownFieldsSize(
+        _internal_metadata_, total_size, &_cached_size_);
+  }
+  int cached_size = ::PROTOBUF_NAMESPACE_ID::internal::ToCachedSize(total_size);
+  SetCachedSize(cached_size);
+  return total_size;
+}
+
+void DeviceMessage::MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) {
+// @@protoc_insertion_point(generalized_merge_from_start:tunnelbroker.DeviceMessage)
+  GOOGLE_DCHECK_NE(&from, this);
+  const DeviceMessage* source =
+      ::PROTOBUF_NAMESPACE_ID::DynamicCastToGenerated<DeviceMessage>(
+          &from);
+  if (source == nullptr) {
+  // @@protoc_insertion_point(generalized_merge_from_cast_fail:tunnelbroker.DeviceMessage)
+    ::PROTOBUF_NAMESPACE_ID::internal::ReflectionOps::Merge(from, this);
+  } else {
+  // @@protoc_insertion_point(generalized_merge_from_cast_success:tunnelbroker.DeviceMessage)
+    MergeFrom(*source);
+  }
+}
+
+void DeviceMessage::MergeFrom(const DeviceMessage& from) {
+// @@protoc_insertion_point(class_specific_merge_from_start:tunnelbroker.DeviceMessage)
+  GOOGLE_DCHECK_NE(&from, this);
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  switch (from.data_case()) {
+    case kHello: {
+      _internal_mutable_hello()->::tunnelbroker::DeviceHello::MergeFrom(from._internal_hello());
+      break;
+    }
+    case kPong: {
+      _internal_mutable_pong()->::tunnelbroker::DevicePong::MergeFrom(from._internal_pong());
+      break;
+    }
+    case DATA_NOT_SET: {
+      break;
+    }
+  }
+}
+
+void DeviceMessage::CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) {
+// @@protoc_insertion_point(generalized_copy_from_start:tunnelbroker.DeviceMessage)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+void DeviceMessage::CopyFrom(const DeviceMessage& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:tunnelbroker.DeviceMessage)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool DeviceMessage::IsInitialized() const {
+  return true;
+}
+
+void DeviceMessage::InternalSwap(DeviceMessage* other) {
+  using std::swap;
+  _internal_metadata_.Swap<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(&other->_internal_metadata_);
+  swap(data_, other->data_);
+  swap(_oneof_case_[0], other->_oneof_case_[0]);
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata DeviceMessage::GetMetadata() const {
+  return GetMetadataStatic();
+}
+
+
+// ===================================================================
+
+class ServerPing::_Internal {
+ public:
+};
+
+ServerPing::ServerPing(::PROTOBUF_NAMESPACE_ID::Arena* arena)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena) {
+  SharedCtor();
+  RegisterArenaDtor(arena);
+  // @@protoc_insertion_point(arena_constructor:tunnelbroker.ServerPing)
+}
+ServerPing::ServerPing(const ServerPing& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  // @@protoc_insertion_point(copy_constructor:tunnelbroker.ServerPing)
+}
+
+void ServerPing::SharedCtor() {
+}
+
+ServerPing::~ServerPing() {
+  // @@protoc_insertion_point(destructor:tunnelbroker.ServerPing)
+  SharedDtor();
+  _internal_metadata_.Delete<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+void ServerPing::SharedDtor() {
+  GOOGLE_DCHECK(GetArena() == nullptr);
+}
+
+void ServerPing::ArenaDtor(void* object) {
+  ServerPing* _this = reinterpret_cast< ServerPing* >(object);
+  (void)_this;
+}
+void ServerPing::RegisterArenaDtor(::PROTOBUF_NAMESPACE_ID::Arena*) {
+}
+void ServerPing::SetCachedSize(int size) const {
+  _cached_size_.Set(size);
+}
+
+void ServerPing::Clear() {
+// @@protoc_insertion_point(message_clear_start:tunnelbroker.ServerPing)
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* ServerPing::_InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  while (!ctx->Done(&ptr)) {
+    ::PROTOBUF_NAMESPACE_ID::uint32 tag;
+    ptr = ::PROTOBUF_NAMESPACE_ID::internal::ReadTag(ptr, &tag);
+    CHK_(ptr);
+        if ((tag & 7) == 4 || tag == 0) {
+          ctx->SetLastTag(tag);
+          goto success;
+        }
+        ptr = UnknownFieldParse(tag,
+            _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+            ptr, ctx);
+        CHK_(ptr != nullptr);
+        continue;
+  }  // while
+success:
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto success;
+#undef CHK_
+}
+
+::PROTOBUF_NAMESPACE_ID::uint8* ServerPing::_InternalSerialize(
+    ::PROTOBUF_NAMESPACE_ID::uint8* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:tunnelbroker.ServerPing)
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:tunnelbroker.ServerPing)
+  return target;
+}
+
+size_t ServerPing::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:tunnelbroker.ServerPing)
+  size_t total_size = 0;
+
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    return ::PROTOBUF_NAMESPACE_ID::internal::ComputeUnknownFieldsSize(
+        _internal_metadata_, total_size, &_cached_size_);
+  }
+  int cached_size = ::PROTOBUF_NAMESPACE_ID::internal::ToCachedSize(total_size);
+  SetCachedSize(cached_size);
+  return total_size;
+}
+
+void ServerPing::MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) {
+// @@protoc_insertion_point(generalized_merge_from_start:tunnelbroker.ServerPing)
+  GOOGLE_DCHECK_NE(&from, this);
+  const ServerPing* source =
+      ::PROTOBUF_NAMESPACE_ID::DynamicCastToGenerated<ServerPing>(
+          &from);
+  if (source == nullptr) {
+  // @@protoc_insertion_point(generalized_merge_from_cast_fail:tunnelbroker.ServerPing)
+    ::PROTOBUF_NAMESPACE_ID::internal::ReflectionOps::Merge(from, this);
+  } else {
+  // @@protoc_insertion_point(generalized_merge_from_cast_success:tunnelbroker.ServerPing)
+    MergeFrom(*source);
+  }
+}
+
+void ServerPing::MergeFrom(const ServerPing& from) {
+// @@protoc_insertion_point(class_specific_merge_from_start:tunnelbroker.ServerPing)
+  GOOGLE_DCHECK_NE(&from, this);
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+}
+
+void ServerPing::CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) {
+// @@protoc_insertion_point(generalized_copy_from_start:tunnelbroker.ServerPing)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+void ServerPing::CopyFrom(const ServerPing& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:tunnelbroker.ServerPing)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool ServerPing::IsInitialized() const {
+  return true;
+}
+
+void ServerPing::InternalSwap(ServerPing* other) {
+  using std::swap;
+  _internal_metadata_.Swap<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(&other->_internal_metadata_);
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata ServerPing::GetMetadata() const {
+  return GetMetadataStatic();
+}
+
+
+// ===================================================================
+
+class ServerMessage::_Internal {
+ public:
+  static const ::tunnelbroker::ServerPing& ping(const ServerMessage* msg);
+};
+
+const ::tunnelbroker::ServerPing&
+ServerMessage::_Internal::ping(const ServerMessage* msg) {
+  return *msg->data_.ping_;
+}
+void ServerMessage::set_allocated_ping(::tunnelbroker::ServerPing* ping) {
+  ::PROTOBUF_NAMESPACE_ID::Arena* message_arena = GetArena();
+  clear_data();
+  if (ping) {
+    ::PROTOBUF_NAMESPACE_ID::Arena* submessage_arena =
+      ::PROTOBUF_NAMESPACE_ID::Arena::GetArena(ping);
+    if (message_arena != submessage_arena) {
+      ping = ::PROTOBUF_NAMESPACE_ID::internal::GetOwnedMessage(
+          message_arena, ping, submessage_arena);
+    }
+    set_has_ping();
+    data_.ping_ = ping;
+  }
+  // @@protoc_insertion_point(field_set_allocated:tunnelbroker.ServerMessage.ping)
+}
+ServerMessage::ServerMessage(::PROTOBUF_NAMESPACE_ID::Arena* arena)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena) {
+  SharedCtor();
+  RegisterArenaDtor(arena);
+  // @@protoc_insertion_point(arena_constructor:tunnelbroker.ServerMessage)
+}
+ServerMessage::ServerMessage(const ServerMessage& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  clear_has_data();
+  switch (from.data_case()) {
+    case kPing: {
+      _internal_mutable_ping()->::tunnelbroker::ServerPing::MergeFrom(from._internal_ping());
+      break;
+    }
+    case DATA_NOT_SET: {
+      break;
+    }
+  }
+  // @@protoc_insertion_point(copy_constructor:tunnelbroker.ServerMessage)
+}
+
+void ServerMessage::SharedCtor() {
+clear_has_data();
+}
+
+ServerMessage::~ServerMessage() {
+  // @@protoc_insertion_point(destructor:tunnelbroker.ServerMessage)
+  SharedDtor();
+  _internal_metadata_.Delete<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+void ServerMessage::SharedDtor() {
+  GOOGLE_DCHECK(GetArena() == nullptr);
+  if (has_data()) {
+    clear_data();
+  }
+}
+
+void ServerMessage::ArenaDtor(void* object) {
+  ServerMessage* _this = reinterpret_cast< ServerMessage* >(object);
+  (void)_this;
+}
+void ServerMessage::RegisterArenaDtor(::PROTOBUF_NAMESPACE_ID::Arena*) {
+}
+void ServerMessage::SetCachedSize(int size) const {
+  _cached_size_.Set(size);
+}
+
+void ServerMessage::clear_data() {
+// @@protoc_insertion_point(one_of_clear_start:tunnelbroker.ServerMessage)
+  switch (data_case()) {
+    case kPing: {
+      if (GetArena() == nullptr) {
+        delete data_.ping_;
+      }
+      break;
+    }
+    case DATA_NOT_SET: {
+      break;
+    }
+  }
+  _oneof_case_[0] = DATA_NOT_SET;
+}
+
+
+void ServerMessage::Clear() {
+// @@protoc_insertion_point(message_clear_start:tunnelbroker.ServerMessage)
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  clear_data();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* ServerMessage::_InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  while (!ctx->Done(&ptr)) {
+    ::PROTOBUF_NAMESPACE_ID::uint32 tag;
+    ptr = ::PROTOBUF_NAMESPACE_ID::internal::ReadTag(ptr, &tag);
+    CHK_(ptr);
+    switch (tag >> 3) {
+      // .tunnelbroker.ServerPing ping = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 10)) {
+          ptr = ctx->ParseMessage(_internal_mutable_ping(), ptr);
+          CHK_(ptr);
+        } else goto handle_unusual;
+        continue;
+      default: {
+      handle_unusual:
+        if ((tag & 7) == 4 || tag == 0) {
+          ctx->SetLastTag(tag);
+          goto success;
+        }
+        ptr = UnknownFieldParse(tag,
+            _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+            ptr, ctx);
+        CHK_(ptr != nullptr);
+        continue;
+      }
+    }  // switch
+  }  // while
+success:
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto success;
+#undef CHK_
+}
+
+::PROTOBUF_NAMESPACE_ID::uint8* ServerMessage::_InternalSerialize(
+    ::PROTOBUF_NAMESPACE_ID::uint8* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:tunnelbroker.ServerMessage)
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // .tunnelbroker.ServerPing ping = 1;
+  if (_internal_has_ping()) {
+    target = stream->EnsureSpace(target);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(
+        1, _Internal::ping(this), target, stream);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:tunnelbroker.ServerMessage)
+  return target;
+}
+
+size_t ServerMessage::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:tunnelbroker.ServerMessage)
+  size_t total_size = 0;
+
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  switch (data_case()) {
+    // .tunnelbroker.ServerPing ping = 1;
+    case kPing: {
+      total_size += 1 +
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *data_.ping_);
+      break;
+    }
+    case DATA_NOT_SET: {
+      break;
+    }
+  }
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    return ::PROTOBUF_NAMESPACE_ID::internal::ComputeUnknownFieldsSize(
+        _internal_metadata_, total_size, &_cached_size_);
+  }
+  int cached_size = ::PROTOBUF_NAMESPACE_ID::internal::ToCachedSize(total_size);
+  SetCachedSize(cached_size);
+  return total_size;
+}
+
+void ServerMessage::MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) {
+// @@protoc_insertion_point(generalized_merge_from_start:tunnelbroker.ServerMessage)
+  GOOGLE_DCHECK_NE(&from, this);
+  const ServerMessage* source =
+      ::PROTOBUF_NAMESPACE_ID::DynamicCastToGenerated<ServerMessage>(
+          &from);
+  if (source == nullptr) {
+  // @@protoc_insertion_point(generalized_merge_from_cast_fail:tunnelbroker.ServerMessage)
+    ::PROTOBUF_NAMESPACE_ID::internal::ReflectionOps::Merge(from, this);
+  } else {
+  // @@protoc_insertion_point(generalized_merge_from_cast_success:tunnelbroker.ServerMessage)
+    MergeFrom(*source);
+  }
+}
+
+void ServerMessage::MergeFrom(const ServerMessage& from) {
+// @@protoc_insertion_point(class_specific_merge_from_start:tunnelbroker.ServerMessage)
+  GOOGLE_DCHECK_NE(&from, this);
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  switch (from.data_case()) {
+    case kPing: {
+      _internal_mutable_ping()->::tunnelbroker::ServerPing::MergeFrom(from._internal_ping());
+      break;
+    }
+    case DATA_NOT_SET: {
+      break;
+    }
+  }
+}
+
+void ServerMessage::CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) {
+// @@protoc_insertion_point(generalized_copy_from_start:tunnelbroker.ServerMessage)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+void ServerMessage::CopyFrom(const ServerMessage& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:tunnelbroker.ServerMessage)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool ServerMessage::IsInitialized() const {
+  return true;
+}
+
+void ServerMessage::InternalSwap(ServerMessage* other) {
+  using std::swap;
+  _internal_metadata_.Swap<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(&other->_internal_metadata_);
+  swap(data_, other->data_);
+  swap(_oneof_case_[0], other->_oneof_case_[0]);
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata ServerMessage::GetMetadata() const {
+  return GetMetadataStatic();
+}
+
+
+// @@protoc_insertion_point(namespace_scope)
+}  // namespace tunnelbroker
+PROTOBUF_NAMESPACE_OPEN
+template<> PROTOBUF_NOINLINE ::tunnelbroker::CheckRequest* Arena::CreateMaybeMessage< ::tunnelbroker::CheckRequest >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::tunnelbroker::CheckRequest >(arena);
+}
+template<> PROTOBUF_NOINLINE ::tunnelbroker::CheckResponse* Arena::CreateMaybeMessage< ::tunnelbroker::CheckResponse >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::tunnelbroker::CheckResponse >(arena);
+}
+template<> PROTOBUF_NOINLINE ::tunnelbroker::NewPrimaryRequest* Arena::CreateMaybeMessage< ::tunnelbroker::NewPrimaryRequest >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::tunnelbroker::NewPrimaryRequest >(arena);
+}
+template<> PROTOBUF_NOINLINE ::tunnelbroker::NewPrimaryResponse* Arena::CreateMaybeMessage< ::tunnelbroker::NewPrimaryResponse >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::tunnelbroker::NewPrimaryResponse >(arena);
+}
+template<> PROTOBUF_NOINLINE ::tunnelbroker::PongRequest* Arena::CreateMaybeMessage< ::tunnelbroker::PongRequest >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::tunnelbroker::PongRequest >(arena);
+}
+template<> PROTOBUF_NOINLINE ::tunnelbroker::DeviceHello* Arena::CreateMaybeMessage< ::tunnelbroker::DeviceHello >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::tunnelbroker::DeviceHello >(arena);
+}
+template<> PROTOBUF_NOINLINE ::tunnelbroker::DevicePong* Arena::CreateMaybeMessage< ::tunnelbroker::DevicePong >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::tunnelbroker::DevicePong >(arena);
+}
+template<> PROTOBUF_NOINLINE ::tunnelbroker::DeviceMessage* Arena::CreateMaybeMessage< ::tunnelbroker::DeviceMessage >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::tunnelbroker::DeviceMessage >(arena);
+}
+template<> PROTOBUF_NOINLINE ::tunnelbroker::ServerPing* Arena::CreateMaybeMessage< ::tunnelbroker::ServerPing >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::tunnelbroker::ServerPing >(arena);
+}
+template<> PROTOBUF_NOINLINE ::tunnelbroker::ServerMessage* Arena::CreateMaybeMessage< ::tunnelbroker::ServerMessage >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::tunnelbroker::ServerMessage >(arena);
 }
 PROTOBUF_NAMESPACE_CLOSE
 
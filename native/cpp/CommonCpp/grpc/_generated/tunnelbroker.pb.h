@@ -48,7 +48,7 @@ struct TableStruct_tunnelbroker_2eproto {
     PROTOBUF_SECTION_VARIABLE(protodesc_cold);
   static const ::PROTOBUF_NAMESPACE_ID::internal::AuxiliaryParseTableField aux[]
     PROTOBUF_SECTION_VARIABLE(protodesc_cold);
-  static const ::PROTOBUF_NAMESPACE_ID::internal::ParseTable schema[5]
+  static const ::PROTOBUF_NAMESPACE_ID::internal::ParseTable schema[10]
     PROTOBUF_SECTION_VARIABLE(protodesc_cold);
   static const ::PROTOBUF_NAMESPACE_ID::internal::FieldMetadata field_metadata[];
   static const ::PROTOBUF_NAMESPACE_ID::internal::SerializationTable serialization_table[];
@@ -63,6 +63,15 @@ extern CheckRequestDefaultTypeInternal _CheckRequest_default_instance_;
 class CheckResponse;
 struct CheckResponseDefaultTypeInternal;
 extern CheckResponseDefaultTypeInternal _CheckResponse_default_instance_;
+class DeviceHello;
+struct DeviceHelloDefaultTypeInternal;
+extern DeviceHelloDefaultTypeInternal _DeviceHello_default_instance_;
+class DeviceMessage;
+struct DeviceMessageDefaultTypeInternal;
+extern DeviceMessageDefaultTypeInternal _DeviceMessage_default_instance_;
+class DevicePong;
+struct DevicePongDefaultTypeInternal;
+extern DevicePongDefaultTypeInternal _DevicePong_default_instance_;
 class NewPrimaryRequest;
 struct NewPrimaryRequestDefaultTypeInternal;
 extern NewPrimaryRequestDefaultTypeInternal _NewPrimaryRequest_default_instance_;
@@ -72,13 +81,24 @@ extern NewPrimaryResponseDefaultTypeInternal _NewPrimaryResponse_default_instanc
 class PongRequest;
 struct PongRequestDefaultTypeInternal;
 extern PongRequestDefaultTypeInternal _PongRequest_default_instance_;
+class ServerMessage;
+struct ServerMessageDefaultTypeInternal;
+extern ServerMessageDefaultTypeInternal _ServerMessage_default_instance_;
+class ServerPing;
+struct ServerPingDefaultTypeInternal;
+extern ServerPingDefaultTypeInternal _ServerPing_default_instance_;
 }  // namespace tunnelbroker
 PROTOBUF_NAMESPACE_OPEN
 template<> ::tunnelbroker::CheckRequest* Arena::CreateMaybeMessage<::tunnelbroker::CheckRequest>(Arena*);
 template<> ::tunnelbroker::CheckResponse* Arena::CreateMaybeMessage<::tunnelbroker::CheckResponse>(Arena*);
+template<> ::tunnelbroker::DeviceHello* Arena::CreateMaybeMessage<::tunnelbroker::DeviceHello>(Arena*);
+template<> ::tunnelbroker::DeviceMessage* Arena::CreateMaybeMessage<::tunnelbroker::DeviceMessage>(Arena*);
+template<> ::tunnelbroker::DevicePong* Arena::CreateMaybeMessage<::tunnelbroker::DevicePong>(Arena*);
 template<> ::tunnelbroker::NewPrimaryRequest* Arena::CreateMaybeMessage<::tunnelbroker::NewPrimaryRequest>(Arena*);
 template<> ::tunnelbroker::NewPrimaryResponse* Arena::CreateMaybeMessage<::tunnelbroker::NewPrimaryResponse>(Arena*);
 template<> ::tunnelbroker::PongRequest* Arena::CreateMaybeMessage<::tunnelbroker::PongRequest>(Arena*);
+template<> ::tunnelbroker::ServerMessage* Arena::CreateMaybeMessage<::tunnelbroker::ServerMessage>(Arena*);
+template<> ::tunnelbroker::ServerPing* Arena::CreateMaybeMessage<::tunnelbroker::ServerPing>(Arena*);
 PROTOBUF_NAMESPACE_CLOSE
 namespace tunnelbroker {
 
@@ -869,6 +889,764 @@ class PongRequest PROTOBUF_FINAL :
   mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
   friend struct ::TableStruct_tunnelbroker_2eproto;
 };
+// -------------------------------------------------------------------
+
+class DeviceHello PROTOBUF_FINAL :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:tunnelbroker.DeviceHello) */ {
+ public:
+  inline DeviceHello() : DeviceHello(nullptr) {}
+  virtual ~DeviceHello();
+  explicit constexpr DeviceHello(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  DeviceHello(const DeviceHello& from);
+  DeviceHello(DeviceHello&& from) noexcept
+    : DeviceHello() {
+    *this = ::std::move(from);
+  }
+
+  inline DeviceHello& operator=(const DeviceHello& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline DeviceHello& operator=(DeviceHello&& from) noexcept {
+    if (GetArena() == from.GetArena()) {
+      if (this != &from) InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return GetMetadataStatic().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return GetMetadataStatic().reflection;
+  }
+  static const DeviceHello& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const DeviceHello* internal_default_instance() {
+    return reinterpret_cast<const DeviceHello*>(
+               &_DeviceHello_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    5;
+
+  friend void swap(DeviceHello& a, DeviceHello& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(DeviceHello* other) {
+    if (other == this) return;
+    if (GetArena() == other->GetArena()) {
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(DeviceHello* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetArena() == other->GetArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  inline DeviceHello* New() const final {
+    return CreateMaybeMessage<DeviceHello>(nullptr);
+  }
+
+  DeviceHello* New(::PROTOBUF_NAMESPACE_ID::Arena* arena) const final {
+    return CreateMaybeMessage<DeviceHello>(arena);
+  }
+  void CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
+  void MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
+  void CopyFrom(const DeviceHello& from);
+  void MergeFrom(const DeviceHello& from);
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  ::PROTOBUF_NAMESPACE_ID::uint8* _InternalSerialize(
+      ::PROTOBUF_NAMESPACE_ID::uint8* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _cached_size_.Get(); }
+
+  private:
+  inline void SharedCtor();
+  inline void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(DeviceHello* other);
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "tunnelbroker.DeviceHello";
+  }
+  protected:
+  explicit DeviceHello(::PROTOBUF_NAMESPACE_ID::Arena* arena);
+  private:
+  static void ArenaDtor(void* object);
+  inline void RegisterArenaDtor(::PROTOBUF_NAMESPACE_ID::Arena* arena);
+  public:
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+  private:
+  static ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadataStatic() {
+    return ::descriptor_table_tunnelbroker_2eproto_metadata_getter(kIndexInFileMessages);
+  }
+
+  public:
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kUserIdFieldNumber = 1,
+    kDeviceTokenFieldNumber = 2,
+  };
+  // string userId = 1;
+  void clear_userid();
+  const std::string& userid() const;
+  void set_userid(const std::string& value);
+  void set_userid(std::string&& value);
+  void set_userid(const char* value);
+  void set_userid(const char* value, size_t size);
+  std::string* mutable_userid();
+  std::string* release_userid();
+  void set_allocated_userid(std::string* userid);
+  private:
+  const std::string& _internal_userid() const;
+  void _internal_set_userid(const std::string& value);
+  std::string* _internal_mutable_userid();
+  public:
+
+  // string deviceToken = 2;
+  void clear_devicetoken();
+  const std::string& devicetoken() const;
+  void set_devicetoken(const std::string& value);
+  void set_devicetoken(std::string&& value);
+  void set_devicetoken(const char* value);
+  void set_devicetoken(const char* value, size_t size);
+  std::string* mutable_devicetoken();
+  std::string* release_devicetoken();
+  void set_allocated_devicetoken(std::string* devicetoken);
+  private:
+  const std::string& _internal_devicetoken() const;
+  void _internal_set_devicetoken(const std::string& value);
+  std::string* _internal_mutable_devicetoken();
+  public:
+
+  // @@protoc_insertion_point(class_scope:tunnelbroker.DeviceHello)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr userid_;
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr devicetoken_;
+  mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  friend struct ::TableStruct_tunnelbroker_2eproto;
+};
+// -------------------------------------------------------------------
+
+class DevicePong PROTOBUF_FINAL :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:tunnelbroker.DevicePong) */ {
+ public:
+  inline DevicePong() : DevicePong(nullptr) {}
+  virtual ~DevicePong();
+  explicit constexpr DevicePong(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  DevicePong(const DevicePong& from);
+  DevicePong(DevicePong&& from) noexcept
+    : DevicePong() {
+    *this = ::std::move(from);
+  }
+
+  inline DevicePong& operator=(const DevicePong& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline DevicePong& operator=(DevicePong&& from) noexcept {
+    if (GetArena() == from.GetArena()) {
+      if (this != &from) InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return GetMetadataStatic().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return GetMetadataStatic().reflection;
+  }
+  static const DevicePong& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const DevicePong* internal_default_instance() {
+    return reinterpret_cast<const DevicePong*>(
+               &_DevicePong_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    6;
+
+  friend void swap(DevicePong& a, DevicePong& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(DevicePong* other) {
+    if (other == this) return;
+    if (GetArena() == other->GetArena()) {
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(DevicePong* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetArena() == other->GetArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  inline DevicePong* New() const final {
+    return CreateMaybeMessage<DevicePong>(nullptr);
+  }
+
+  DevicePong* New(::PROTOBUF_NAMESPACE_ID::Arena* arena) const final {
+    return CreateMaybeMessage<DevicePong>(arena);
+  }
+  void CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
+  void MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
+  void CopyFrom(const DevicePong& from);
+  void MergeFrom(const DevicePong& from);
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  ::PROTOBUF_NAMESPACE_ID::uint8* _InternalSerialize(
+      ::PROTOBUF_NAMESPACE_ID::uint8* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _cached_size_.Get(); }
+
+  private:
+  inline void SharedCtor();
+  inline void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(DevicePong* other);
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "tunnelbroker.DevicePong";
+  }
+  protected:
+  explicit DevicePong(::PROTOBUF_NAMESPACE_ID::Arena* arena);
+  private:
+  static void ArenaDtor(void* object);
+  inline void RegisterArenaDtor(::PROTOBUF_NAMESPACE_ID::Arena* arena);
+  public:
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+  private:
+  static ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadataStatic() {
+    return ::descriptor_table_tunnelbroker_2eproto_metadata_getter(kIndexInFileMessages);
+  }
+
+  public:
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  // @@protoc_insertion_point(class_scope:tunnelbroker.DevicePong)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  friend struct ::TableStruct_tunnelbroker_2eproto;
+};
+// -------------------------------------------------------------------
+
+class DeviceMessage PROTOBUF_FINAL :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:tunnelbroker.DeviceMessage) */ {
+ public:
+  inline DeviceMessage() : DeviceMessage(nullptr) {}
+  virtual ~DeviceMessage();
+  explicit constexpr DeviceMessage(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  DeviceMessage(const DeviceMessage& from);
+  DeviceMessage(DeviceMessage&& from) noexcept
+    : DeviceMessage() {
+    *this = ::std::move(from);
+  }
+
+  inline DeviceMessage& operator=(const DeviceMessage& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline DeviceMessage& operator=(DeviceMessage&& from) noexcept {
+    if (GetArena() == from.GetArena()) {
+      if (this != &from) InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return GetMetadataStatic().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return GetMetadataStatic().reflection;
+  }
+  static const DeviceMessage& default_instance() {
+    return *internal_default_instance();
+  }
+  enum DataCase {
+    kHello = 1,
+    kPong = 2,
+    DATA_NOT_SET = 0,
+  };
+
+  static inline const DeviceMessage* internal_default_instance() {
+    return reinterpret_cast<const DeviceMessage*>(
+               &_DeviceMessage_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    7;
+
+  friend void swap(DeviceMessage& a, DeviceMessage& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(DeviceMessage* other) {
+    if (other == this) return;
+    if (GetArena() == other->GetArena()) {
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(DeviceMessage* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetArena() == other->GetArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  inline DeviceMessage* New() const final {
+    return CreateMaybeMessage<DeviceMessage>(nullptr);
+  }
+
+  DeviceMessage* New(::PROTOBUF_NAMESPACE_ID::Arena* arena) const final {
+    return CreateMaybeMessage<DeviceMessage>(arena);
+  }
+  void CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
+  void MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
+  void CopyFrom(const DeviceMessage& from);
+  void MergeFrom(const DeviceMessage& from);
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  ::PROTOBUF_NAMESPACE_ID::uint8* _InternalSerialize(
+      ::PROTOBUF_NAMESPACE_ID::uint8* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _cached_size_.Get(); }
+
+  private:
+  inline void SharedCtor();
+  inline void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(DeviceMessage* other);
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "tunnelbroker.DeviceMessage";
+  }
+  protected:
+  explicit DeviceMessage(::PROTOBUF_NAMESPACE_ID::Arena* arena);
+  private:
+  static void ArenaDtor(void* object);
+  inline void RegisterArenaDtor(::PROTOBUF_NAMESPACE_ID::Arena* arena);
+  public:
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+  private:
+  static ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadataStatic() {
+    return ::descriptor_table_tunnelbroker_2eproto_metadata_getter(kIndexInFileMessages);
+  }
+
+  public:
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kHelloFieldNumber = 1,
+    kPongFieldNumber = 2,
+  };
+  // .tunnelbroker.DeviceHello hello = 1;
+  bool has_hello() const;
+  private:
+  bool _internal_has_hello() const;
+  public:
+  void clear_hello();
+  const ::tunnelbroker::DeviceHello& hello() const;
+  ::tunnelbroker::DeviceHello* release_hello();
+  ::tunnelbroker::DeviceHello* mutable_hello();
+  void set_allocated_hello(::tunnelbroker::DeviceHello* hello);
+  private:
+  const ::tunnelbroker::DeviceHello& _internal_hello() const;
+  ::tunnelbroker::DeviceHello* _internal_mutable_hello();
+  public:
+  void unsafe_arena_set_allocated_hello(
+      ::tunnelbroker::DeviceHello* hello);
+  ::tunnelbroker::DeviceHello* unsafe_arena_release_hello();
+
+  // .tunnelbroker.DevicePong pong = 2;
+  bool has_pong() const;
+  private:
+  bool _internal_has_pong() const;
+  public:
+  void clear_pong();
+  const ::tunnelbroker::DevicePong& pong() const;
+  ::tunnelbroker::DevicePong* release_pong();
+  ::tunnelbroker::DevicePong* mutable_pong();
+  void set_allocated_pong(::tunnelbroker::DevicePong* pong);
+  private:
+  const ::tunnelbroker::DevicePong& _internal_pong() const;
+  ::tunnelbroker::DevicePong* _internal_mutable_pong();
+  public:
+  void unsafe_arena_set_allocated_pong(
+      ::tunnelbroker::DevicePong* pong);
+  ::tunnelbroker::DevicePong* unsafe_arena_release_pong();
+
+  void clear_data();
+  DataCase data_case() const;
+  // @@protoc_insertion_point(class_scope:tunnelbroker.DeviceMessage)
+ private:
+  class _Internal;
+  void set_has_hello();
+  void set_has_pong();
+
+  inline bool has_data() const;
+  inline void clear_has_data();
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  union DataUnion {
+    constexpr DataUnion() : _constinit_{} {}
+      ::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized _constinit_;
+    ::tunnelbroker::DeviceHello* hello_;
+    ::tunnelbroker::DevicePong* pong_;
+  } data_;
+  mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  ::PROTOBUF_NAMESPACE_ID::uint32 _oneof_case_[1];
+
+  friend struct ::TableStruct_tunnelbroker_2eproto;
+};
+// -------------------------------------------------------------------
+
+class ServerPing PROTOBUF_FINAL :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:tunnelbroker.ServerPing) */ {
+ public:
+  inline ServerPing() : ServerPing(nullptr) {}
+  virtual ~ServerPing();
+  explicit constexpr ServerPing(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  ServerPing(const ServerPing& from);
+  ServerPing(ServerPing&& from) noexcept
+    : ServerPing() {
+    *this = ::std::move(from);
+  }
+
+  inline ServerPing& operator=(const ServerPing& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline ServerPing& operator=(ServerPing&& from) noexcept {
+    if (GetArena() == from.GetArena()) {
+      if (this != &from) InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return GetMetadataStatic().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return GetMetadataStatic().reflection;
+  }
+  static const ServerPing& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const ServerPing* internal_default_instance() {
+    return reinterpret_cast<const ServerPing*>(
+               &_ServerPing_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    8;
+
+  friend void swap(ServerPing& a, ServerPing& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(ServerPing* other) {
+    if (other == this) return;
+    if (GetArena() == other->GetArena()) {
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(ServerPing* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetArena() == other->GetArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  inline ServerPing* New() const final {
+    return CreateMaybeMessage<ServerPing>(nullptr);
+  }
+
+  ServerPing* New(::PROTOBUF_NAMESPACE_ID::Arena* arena) const final {
+    return CreateMaybeMessage<ServerPing>(arena);
+  }
+  void CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
+  void MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
+  void CopyFrom(const ServerPing& from);
+  void MergeFrom(const ServerPing& from);
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  ::PROTOBUF_NAMESPACE_ID::uint8* _InternalSerialize(
+      ::PROTOBUF_NAMESPACE_ID::uint8* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _cached_size_.Get(); }
+
+  private:
+  inline void SharedCtor();
+  inline void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(ServerPing* other);
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "tunnelbroker.ServerPing";
+  }
+  protected:
+  explicit ServerPing(::PROTOBUF_NAMESPACE_ID::Arena* arena);
+  private:
+  static void ArenaDtor(void* object);
+  inline void RegisterArenaDtor(::PROTOBUF_NAMESPACE_ID::Arena* arena);
+  public:
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+  private:
+  static ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadataStatic() {
+    return ::descriptor_table_tunnelbroker_2eproto_metadata_getter(kIndexInFileMessages);
+  }
+
+  public:
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  // @@protoc_insertion_point(class_scope:tunnelbroker.ServerPing)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  friend struct ::TableStruct_tunnelbroker_2eproto;
+};
+// -------------------------------------------------------------------
+
+class ServerMessage PROTOBUF_FINAL :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:tunnelbroker.ServerMessage) */ {
+ public:
+  inline ServerMessage() : ServerMessage(nullptr) {}
+  virtual ~ServerMessage();
+  explicit constexpr ServerMessage(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  ServerMessage(const ServerMessage& from);
+  ServerMessage(ServerMessage&& from) noexcept
+    : ServerMessage() {
+    *this = ::std::move(from);
+  }
+
+  inline ServerMessage& operator=(const ServerMessage& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline ServerMessage& operator=(ServerMessage&& from) noexcept {
+    if (GetArena() == from.GetArena()) {
+      if (this != &from) InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return GetMetadataStatic().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return GetMetadataStatic().reflection;
+  }
+  static const ServerMessage& default_instance() {
+    return *internal_default_instance();
+  }
+  enum DataCase {
+    kPing = 1,
+    DATA_NOT_SET = 0,
+  };
+
+  static inline const ServerMessage* internal_default_instance() {
+    return reinterpret_cast<const ServerMessage*>(
+               &_ServerMessage_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    9;
+
+  friend void swap(ServerMessage& a, ServerMessage& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(ServerMessage* other) {
+    if (other == this) return;
+    if (GetArena() == other->GetArena()) {
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(ServerMessage* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetArena() == other->GetArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  inline ServerMessage* New() const final {
+    return CreateMaybeMessage<ServerMessage>(nullptr);
+  }
+
+  ServerMessage* New(::PROTOBUF_NAMESPACE_ID::Arena* arena) const final {
+    return CreateMaybeMessage<ServerMessage>(arena);
+  }
+  void CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
+  void MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
+  void CopyFrom(const ServerMessage& from);
+  void MergeFrom(const ServerMessage& from);
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  ::PROTOBUF_NAMESPACE_ID::uint8* _InternalSerialize(
+      ::PROTOBUF_NAMESPACE_ID::uint8* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _cached_size_.Get(); }
+
+  private:
+  inline void SharedCtor();
+  inline void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(ServerMessage* other);
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "tunnelbroker.ServerMessage";
+  }
+  protected:
+  explicit ServerMessage(::PROTOBUF_NAMESPACE_ID::Arena* arena);
+  private:
+  static void ArenaDtor(void* object);
+  inline void RegisterArenaDtor(::PROTOBUF_NAMESPACE_ID::Arena* arena);
+  public:
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+  private:
+  static ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadataStatic() {
+    return ::descriptor_table_tunnelbroker_2eproto_metadata_getter(kIndexInFileMessages);
+  }
+
+  public:
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kPingFieldNumber = 1,
+  };
+  // .tunnelbroker.ServerPing ping = 1;
+  bool has_ping() const;
+  private:
+  bool _internal_has_ping() const;
+  public:
+  void clear_ping();
+  const ::tunnelbroker::ServerPing& ping() const;
+  ::tunnelbroker::ServerPing* release_ping();
+  ::tunnelbroker::ServerPing* mutable_ping();
+  void set_allocated_ping(::tunnelbroker::ServerPing* ping);
+  private:
+  const ::tunnelbroker::ServerPing& _internal_ping() const;
+  ::tunnelbroker::ServerPing* _internal_mutable_ping();
+  public:
+  void unsafe_arena_set_allocated_ping(
+      ::tunnelbroker::ServerPing* ping);
+  ::tunnelbroker::ServerPing* unsafe_arena_release_ping();
+
+  void clear_data();
+  DataCase data_case() const;
+  // @@protoc_insertion_point(class_scope:tunnelbroker.ServerMessage)
+ private:
+  class _Internal;
+  void set_has_ping();
+
+  inline bool has_data() const;
+  inline void clear_has_data();
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  union DataUnion {
+    constexpr DataUnion() : _constinit_{} {}
+      ::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized _constinit_;
+    ::tunnelbroker::ServerPing* ping_;
+  } data_;
+  mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  ::PROTOBUF_NAMESPACE_ID::uint32 _oneof_case_[1];
+
+  friend struct ::TableStruct_tunnelbroker_2eproto;
+};
 // ===================================================================
 
 
@@ -1302,6 +2080,385 @@ inline void PongRequest::set_allocated_devicetoken(std::string* devicetoken) {
   // @@protoc_insertion_point(field_set_allocated:tunnelbroker.PongRequest.deviceToken)
 }
 
+// -------------------------------------------------------------------
+
+// DeviceHello
+
+// string userId = 1;
+inline void DeviceHello::clear_userid() {
+  userid_.ClearToEmpty();
+}
+inline const std::string& DeviceHello::userid() const {
+  // @@protoc_insertion_point(field_get:tunnelbroker.DeviceHello.userId)
+  return _internal_userid();
+}
+inline void DeviceHello::set_userid(const std::string& value) {
+  _internal_set_userid(value);
+  // @@protoc_insertion_point(field_set:tunnelbroker.DeviceHello.userId)
+}
+inline std::string* DeviceHello::mutable_userid() {
+  // @@protoc_insertion_point(field_mutable:tunnelbroker.DeviceHello.userId)
+  return _internal_mutable_userid();
+}
+inline const std::string& DeviceHello::_internal_userid() const {
+  return userid_.Get();
+}
+inline void DeviceHello::_internal_set_userid(const std::string& value) {
+  
+  userid_.Set(::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::EmptyDefault{}, value, GetArena());
+}
+inline void DeviceHello::set_userid(std::string&& value) {
+  
+  userid_.Set(
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::EmptyDefault{}, ::std::move(value), GetArena());
+  // @@protoc_insertion_point(field_set_rvalue:tunnelbroker.DeviceHello.userId)
+}
+inline void DeviceHello::set_userid(const char* value) {
+  GOOGLE_DCHECK(value != nullptr);
+  
+  userid_.Set(::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::EmptyDefault{}, ::std::string(value), GetArena());
+  // @@protoc_insertion_point(field_set_char:tunnelbroker.DeviceHello.userId)
+}
+inline void DeviceHello::set_userid(const char* value,
+    size_t size) {
+  
+  userid_.Set(::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::EmptyDefault{}, ::std::string(
+      reinterpret_cast<const char*>(value), size), GetArena());
+  // @@protoc_insertion_point(field_set_pointer:tunnelbroker.DeviceHello.userId)
+}
+inline std::string* DeviceHello::_internal_mutable_userid() {
+  
+  return userid_.Mutable(::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::EmptyDefault{}, GetArena());
+}
+inline std::string* DeviceHello::release_userid() {
+  // @@protoc_insertion_point(field_release:tunnelbroker.DeviceHello.userId)
+  return userid_.Release(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
+}
+inline void DeviceHello::set_allocated_userid(std::string* userid) {
+  if (userid != nullptr) {
+    
+  } else {
+    
+  }
+  userid_.SetAllocated(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), userid,
+      GetArena());
+  // @@protoc_insertion_point(field_set_allocated:tunnelbroker.DeviceHello.userId)
+}
+
+// string deviceToken = 2;
+inline void DeviceHello::clear_devicetoken() {
+  devicetoken_.ClearToEmpty();
+}
+inline const std::string& DeviceHello::devicetoken() const {
+  // @@protoc_insertion_point(field_get:tunnelbroker.DeviceHello.deviceToken)
+  return _internal_devicetoken();
+}
+inline void DeviceHello::set_devicetoken(const std::string& value) {
+  _internal_set_devicetoken(value);
+  // @@protoc_insertion_point(field_set:tunnelbroker.DeviceHello.deviceToken)
+}
+inline std::string* DeviceHello::mutable_devicetoken() {
+  // @@protoc_insertion_point(field_mutable:tunnelbroker.DeviceHello.deviceToken)
+  return _internal_mutable_devicetoken();
+}
+inline const std::string& DeviceHello::_internal_devicetoken() const {
+  return devicetoken_.Get();
+}
+inline void DeviceHello::_internal_set_devicetoken(const std::string& value) {
+  
+  devicetoken_.Set(::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::EmptyDefault{}, value, GetArena());
+}
+inline void DeviceHello::set_devicetoken(std::string&& value) {
+  
+  devicetoken_.Set(
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::EmptyDefault{}, ::std::move(value), GetArena());
+  // @@protoc_insertion_point(field_set_rvalue:tunnelbroker.DeviceHello.deviceToken)
+}
+inline void DeviceHello::set_devicetoken(const char* value) {
+  GOOGLE_DCHECK(value != nullptr);
+  
+  devicetoken_.Set(::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::EmptyDefault{}, ::std::string(value), GetArena());
+  // @@protoc_insertion_point(field_set_char:tunnelbroker.DeviceHello.deviceToken)
+}
+inline void DeviceHello::set_devicetoken(const char* value,
+    size_t size) {
+  
+  devicetoken_.Set(::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::EmptyDefault{}, ::std::string(
+      reinterpret_cast<const char*>(value), size), GetArena());
+  // @@protoc_insertion_point(field_set_pointer:tunnelbroker.DeviceHello.deviceToken)
+}
+inline std::string* DeviceHello::_internal_mutable_devicetoken() {
+  
+  return devicetoken_.Mutable(::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::EmptyDefault{}, GetArena());
+}
+inline std::string* DeviceHello::release_devicetoken() {
+  // @@protoc_insertion_point(field_release:tunnelbroker.DeviceHello.deviceToken)
+  return devicetoken_.Release(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
+}
+inline void DeviceHello::set_allocated_devicetoken(std::string* devicetoken) {
+  if (devicetoken != nullptr) {
+    
+  } else {
+    
+  }
+  devicetoken_.SetAllocated(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), devicetoken,
+      GetArena());
+  // @@protoc_insertion_point(field_set_allocated:tunnelbroker.DeviceHello.deviceToken)
+}
+
+// -------------------------------------------------------------------
+
+// DevicePong
+
+// -------------------------------------------------------------------
+
+// DeviceMessage
+
+// .tunnelbroker.DeviceHello hello = 1;
+inline bool DeviceMessage::_internal_has_hello() const {
+  return data_case() == kHello;
+}
+inline bool DeviceMessage::has_hello() const {
+  return _internal_has_hello();
+}
+inline void DeviceMessage::set_has_hello() {
+  _oneof_case_[0] = kHello;
+}
+inline void DeviceMessage::clear_hello() {
+  if (_internal_has_hello()) {
+    if (GetArena() == nullptr) {
+      delete data_.hello_;
+    }
+    clear_has_data();
+  }
+}
+inline ::tunnelbroker::DeviceHello* DeviceMessage::release_hello() {
+  // @@protoc_insertion_point(field_release:tunnelbroker.DeviceMessage.hello)
+  if (_internal_has_hello()) {
+    clear_has_data();
+      ::tunnelbroker::DeviceHello* temp = data_.hello_;
+    if (GetArena() != nullptr) {
+      temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+    }
+    data_.hello_ = nullptr;
+    return temp;
+  } else {
+    return nullptr;
+  }
+}
+inline const ::tunnelbroker::DeviceHello& DeviceMessage::_internal_hello() const {
+  return _internal_has_hello()
+      ? *data_.hello_
+      : reinterpret_cast< ::tunnelbroker::DeviceHello&>(::tunnelbroker::_DeviceHello_default_instance_);
+}
+inline const ::tunnelbroker::DeviceHello& DeviceMessage::hello() const {
+  // @@protoc_insertion_point(field_get:tunnelbroker.DeviceMessage.hello)
+  return _internal_hello();
+}
+inline ::tunnelbroker::DeviceHello* DeviceMessage::unsafe_arena_release_hello() {
+  // @@protoc_insertion_point(field_unsafe_arena_release:tunnelbroker.DeviceMessage.hello)
+  if (_internal_has_hello()) {
+    clear_has_data();
+    ::tunnelbroker::DeviceHello* temp = data_.hello_;
+    data_.hello_ = nullptr;
+    return temp;
+  } else {
+    return nullptr;
+  }
+}
+inline void DeviceMessage::unsafe_arena_set_allocated_hello(::tunnelbroker::DeviceHello* hello) {
+  clear_data();
+  if (hello) {
+    set_has_hello();
+    data_.hello_ = hello;
+  }
+  // @@protoc_insertion_point(field_unsafe_arena_set_allocated:tunnelbroker.DeviceMessage.hello)
+}
+inline ::tunnelbroker::DeviceHello* DeviceMessage::_internal_mutable_hello() {
+  if (!_internal_has_hello()) {
+    clear_data();
+    set_has_hello();
+    data_.hello_ = CreateMaybeMessage< ::tunnelbroker::DeviceHello >(GetArena());
+  }
+  return data_.hello_;
+}
+inline ::tunnelbroker::DeviceHello* DeviceMessage::mutable_hello() {
+  // @@protoc_insertion_point(field_mutable:tunnelbroker.DeviceMessage.hello)
+  return _internal_mutable_hello();
+}
+
+// .tunnelbroker.DevicePong pong = 2;
+inline bool DeviceMessage::_internal_has_pong() const {
+  return data_case() == kPong;
+}
+inline bool DeviceMessage::has_pong() const {
+  return _internal_has_pong();
+}
+inline void DeviceMessage::set_has_pong() {
+  _oneof_case_[0] = kPong;
+}
+inline void DeviceMessage::clear_pong() {
+  if (_internal_has_pong()) {
+    if (GetArena() == nullptr) {
+      delete data_.pong_;
+    }
+    clear_has_data();
+  }
+}
+inline ::tunnelbroker::DevicePong* DeviceMessage::release_pong() {
+  // @@protoc_insertion_point(field_release:tunnelbroker.DeviceMessage.pong)
+  if (_internal_has_pong()) {
+    clear_has_data();
+      ::tunnelbroker::DevicePong* temp = data_.pong_;
+    if (GetArena() != nullptr) {
+      temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+    }
+    data_.pong_ = nullptr;
+    return temp;
+  } else {
+    return nullptr;
+  }
+}
+inline const ::tunnelbroker::DevicePong& DeviceMessage::_internal_pong() const {
+  return _internal_has_pong()
+      ? *data_.pong_
+      : reinterpret_cast< ::tunnelbroker::DevicePong&>(::tunnelbroker::_DevicePong_default_instance_);
+}
+inline const ::tunnelbroker::DevicePong& DeviceMessage::pong() const {
+  // @@protoc_insertion_point(field_get:tunnelbroker.DeviceMessage.pong)
+  return _internal_pong();
+}
+inline ::tunnelbroker::DevicePong* DeviceMessage::unsafe_arena_release_pong() {
+  // @@protoc_insertion_point(field_unsafe_arena_release:tunnelbroker.DeviceMessage.pong)
+  if (_internal_has_pong()) {
+    clear_has_data();
+    ::tunnelbroker::DevicePong* temp = data_.pong_;
+    data_.pong_ = nullptr;
+    return temp;
+  } else {
+    return nullptr;
+  }
+}
+inline void DeviceMessage::unsafe_arena_set_allocated_pong(::tunnelbroker::DevicePong* pong) {
+  clear_data();
+  if (pong) {
+    set_has_pong();
+    data_.pong_ = pong;
+  }
+  // @@protoc_insertion_point(field_unsafe_arena_set_allocated:tunnelbroker.DeviceMessage.pong)
+}
+inline ::tunnelbroker::DevicePong* DeviceMessage::_internal_mutable_pong() {
+  if (!_internal_has_pong()) {
+    clear_data();
+    set_has_pong();
+    data_.pong_ = CreateMaybeMessage< ::tunnelbroker::DevicePong >(GetArena());
+  }
+  return data_.pong_;
+}
+inline ::tunnelbroker::DevicePong* DeviceMessage::mutable_pong() {
+  // @@protoc_insertion_point(field_mutable:tunnelbroker.DeviceMessage.pong)
+  return _internal_mutable_pong();
+}
+
+inline bool DeviceMessage::has_data() const {
+  return data_case() != DATA_NOT_SET;
+}
+inline void DeviceMessage::clear_has_data() {
+  _oneof_case_[0] = DATA_NOT_SET;
+}
+inline DeviceMessage::DataCase DeviceMessage::data_case() const {
+  return DeviceMessage::DataCase(_oneof_case_[0]);
+}
+// -------------------------------------------------------------------
+
+// ServerPing
+
+// -------------------------------------------------------------------
+
+// ServerMessage
+
+// .tunnelbroker.ServerPing ping = 1;
+inline bool ServerMessage::_internal_has_ping() const {
+  return data_case() == kPing;
+}
+inline bool ServerMessage::has_ping() const {
+  return _internal_has_ping();
+}
+inline void ServerMessage::set_has_ping() {
+  _oneof_case_[0] = kPing;
+}
+inline void ServerMessage::clear_ping() {
+  if (_internal_has_ping()) {
+    if (GetArena() == nullptr) {
+      delete data_.ping_;
+    }
+    clear_has_data();
+  }
+}
+inline ::tunnelbroker::ServerPing* ServerMessage::release_ping() {
+  // @@protoc_insertion_point(field_release:tunnelbroker.ServerMessage.ping)
+  if (_internal_has_ping()) {
+    clear_has_data();
+      ::tunnelbroker::ServerPing* temp = data_.ping_;
+    if (GetArena() != nullptr) {
+      temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+    }
+    data_.ping_ = nullptr;
+    return temp;
+  } else {
+    return nullptr;
+  }
+}
+inline const ::tunnelbroker::ServerPing& ServerMessage::_internal_ping() const {
+  return _internal_has_ping()
+      ? *data_.ping_
+      : reinterpret_cast< ::tunnelbroker::ServerPing&>(::tunnelbroker::_ServerPing_default_instance_);
+}
+inline const ::tunnelbroker::ServerPing& ServerMessage::ping() const {
+  // @@protoc_insertion_point(field_get:tunnelbroker.ServerMessage.ping)
+  return _internal_ping();
+}
+inline ::tunnelbroker::ServerPing* ServerMessage::unsafe_arena_release_ping() {
+  // @@protoc_insertion_point(field_unsafe_arena_release:tunnelbroker.ServerMessage.ping)
+  if (_internal_has_ping()) {
+    clear_has_data();
+    ::tunnelbroker::ServerPing* temp = data_.ping_;
+    data_.ping_ = nullptr;
+    return temp;
+  } else {
+    return nullptr;
+  }
+}
+inline void ServerMessage::unsafe_arena_set_allocated_ping(::tunnelbroker::ServerPing* ping) {
+  clear_data();
+  if (ping) {
+    set_has_ping();
+    data_.ping_ = ping;
+  }
+  // @@protoc_insertion_point(field_unsafe_arena_set_allocated:tunnelbroker.ServerMessage.ping)
+}
+inline ::tunnelbroker::ServerPing* ServerMessage::_internal_mutable_ping() {
+  if (!_internal_has_ping()) {
+    clear_data();
+    set_has_ping();
+    data_.ping_ = CreateMaybeMessage< ::tunnelbroker::ServerPing >(GetArena());
+  }
+  return data_.ping_;
+}
+inline ::tunnelbroker::ServerPing* ServerMessage::mutable_ping() {
+  // @@protoc_insertion_point(field_mutable:tunnelbroker.ServerMessage.ping)
+  return _internal_mutable_ping();
+}
+
+inline bool ServerMessage::has_data() const {
+  return data_case() != DATA_NOT_SET;
+}
+inline void ServerMessage::clear_has_data() {
+  _oneof_case_[0] = DATA_NOT_SET;
+}
+inline ServerMessage::DataCase ServerMessage::data_case() const {
+  return ServerMessage::DataCase(_oneof_case_[0]);
+}
 #ifdef __GNUC__
   #pragma GCC diagnostic pop
 #endif  // __GNUC__
@@ -1313,6 +2470,16 @@ inline void PongRequest::set_allocated_devicetoken(std::string* devicetoken) {
 
 // -------------------------------------------------------------------
 
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
 
 // @@protoc_insertion_point(namespace_scope)
 
@@ -0,0 +1,132 @@
+#include "CryptoBenchmarkTools.h"
+#include "PlatformSpecificTools.h"
+#include "Session.h"
+
+#include <stdexcept>
+
+namespace comm {
+namespace benchmarks {
+
+ModuleWithKeys createModuleWithKeys(const std::string &id) {
+  std::unique_ptr<crypto::CryptoModule> module =
+      std::make_unique<crypto::CryptoModule>(id);
+  crypto::Keys keys = crypto::CryptoModule::keysFromStrings(
+      module->getIdentityKeys(), module->getOneTimeKeys());
+  return {std::move(module), keys};
+}
+
+void connectModules(
+    ModuleWithKeys &sender,
+    ModuleWithKeys &receiver,
+    bool exchangeMessages) {
+  sender.module->initializeOutboundForSendingSession(
+      receiver.module->id,
+      receiver.keys.identityKeys,
+      receiver.keys.oneTimeKeys);
+  crypto::EncryptedData initialMessage =
+      sender.module->encrypt(receiver.module->id, generateMessage(16));
+  receiver.module->initializeInboundForReceivingSession(
+      sender.module->id, initialMessage.message, sender.keys.identityKeys);
+  receiver.module->decrypt(
+      sender.module->id, initialMessage, sender.keys.identityKeys);
+  if (!exchangeMessages) {
+    return;
+  }
+  crypto::EncryptedData reply =
+      receiver.module->encrypt(sender.module->id, generateMessage(16));
+  sender.module->decrypt(
+      receiver.module->id, reply, receiver.keys.identityKeys);
+}
+
+void createSessions(
+    ModuleWithKeys &module,
+    size_t sessionsCount,
+    std::vector<ModuleWithKeys> &peers) {
+  for (size_t i = 0; i < sessionsCount; ++i) {
+    peers.push_back(createModuleWithKeys("peer" + std::to_string(i)));
+    connectModules(module, peers.back(), true);
+  }
+}
+
+std::unique_ptr<AccountWithKeys> createAccountWithKeys() {
+  std::unique_ptr<AccountWithKeys> result =
+      std::make_unique<AccountWithKeys>();
+  result->accountBuffer.resize(::olm_account_size());
+  result->account = ::olm_account(result->accountBuffer.data());
+
+  crypto::OlmBuffer random;
+  PlatformSpecificTools::generateSecureRandomBytes(
+      random, ::olm_create_account_random_length(result->account));
+  if (-1 ==
+      ::olm_create_account(result->account, random.data(), random.size())) {
+    throw std::runtime_error("error ::olm_create_account");
+  }
+
+  result->keys.identityKeys.resize(
+      ::olm_account_identity_keys_length(result->account));
+  if (-1 ==
+      ::olm_account_identity_keys(
+          result->account,
+          result->keys.identityKeys.data(),
+          result->keys.identityKeys.size())) {
+    throw std::runtime_error("error ::olm_account_identity_keys");
+  }
+
+  PlatformSpecificTools::generateSecureRandomBytes(
+      random,
+      ::olm_account_generate_one_time_keys_random_length(result->account, 1));
+  if (-1 ==
+      ::olm_account_generate_one_time_keys(
+          result->account, 1, random.data(), random.size())) {
+    throw std::runtime_error("error ::olm_account_generate_one_time_keys");
+  }
+  result->keys.oneTimeKeys.resize(
+      ::olm_account_one_time_keys_length(result->account));
+  if (-1 ==
+      ::olm_account_one_time_keys(
+          result->account,
+          result->keys.oneTimeKeys.data(),
+          result->keys.oneTimeKeys.size())) {
+    throw std::runtime_error("error ::olm_account_one_time_keys");
+  }
+  ::olm_account_mark_keys_as_published(result->account);
+  return result;
+}
+
+crypto::OlmBuffer createPreKeyMessage(
+    AccountWithKeys &sender,
+    AccountWithKeys &receiver) {
+  std::unique_ptr<crypto::Session> session =
+      crypto::Session::createSessionAsInitializer(
+          sender.account,
+          sender.keys.identityKeys.data(),
+          receiver.keys.identityKeys,
+          receiver.keys.oneTimeKeys);
+  OlmSession *olmSession = session->getOlmSession();
+  const std::string message = generateMessage(16);
+
+  crypto::OlmBuffer encryptedMessage(
+      ::olm_encrypt_message_length(olmSession, message.size()));
+  crypto::OlmBuffer random;
+  PlatformSpecificTools::generateSecureRandomBytes(
+      random, ::olm_encrypt_random_length(olmSession));
+  if (-1 ==
+      ::olm_encrypt(
+          olmSession,
+          (uint8_t *)message.data(),
+          message.size(),
+          random.data(),
+          random.size(),
+          encryptedMessage.data(),
+          encryptedMessage.size())) {
+    throw std::runtime_error("error ::olm_encrypt");
+  }
+  return encryptedMessage;
+}
+
+std::string generateMessage(size_t size) {
+  return std::string(size, 'x');
+}
+
+} // namespace benchmarks
+} // namespace comm
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "CryptoModule.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace comm {
+namespace benchmarks {
+
+struct ModuleWithKeys {
+  std::unique_ptr<crypto::CryptoModule> module;
+  crypto::Keys keys;
+};
+
+ModuleWithKeys createModuleWithKeys(const std::string &id);
+
+// creates sessions between `sender` and `receiver`, when `exchangeMessages`
+// is set the receiver replies once so the next messages from the sender are
+// regular messages instead of pre-key ones
+void connectModules(
+    ModuleWithKeys &sender,
+    ModuleWithKeys &receiver,
+    bool exchangeMessages);
+
+// connects `module` with `sessionsCount` new peers, the peers are appended
+// to `peers`
+void createSessions(
+    ModuleWithKeys &module,
+    size_t sessionsCount,
+    std::vector<ModuleWithKeys> &peers);
+
+// a bare olm account, used to benchmark `Session` without `CryptoModule`
+struct AccountWithKeys {
+  crypto::OlmBuffer accountBuffer;
+  OlmAccount *account;
+  crypto::Keys keys;
+};
+
+std::unique_ptr<AccountWithKeys> createAccountWithKeys();
+
+// a pre-key message that `receiver` can create an inbound session from
+crypto::OlmBuffer createPreKeyMessage(
+    AccountWithKeys &sender,
+    AccountWithKeys &receiver);
+
+std::string generateMessage(size_t size);
+
+} // namespace benchmarks
+} // namespace comm
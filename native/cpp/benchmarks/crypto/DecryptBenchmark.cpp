@@ -0,0 +1,76 @@
+#include "AllocationCounter.h"
+#include "CryptoBenchmarkTools.h"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+using namespace comm::benchmarks;
+using namespace comm::crypto;
+
+namespace {
+
+// every iteration decrypts one freshly encrypted message, encryption is
+// excluded from both the timings and the allocation count
+template <typename DecryptFunction>
+void runDecryptBenchmark(
+    benchmark::State &state,
+    const DecryptFunction &decryptFunction) {
+  const size_t messageSize = state.range(0);
+  const bool preKeyMessages = state.range(1);
+  ModuleWithKeys sender = createModuleWithKeys("sender");
+  ModuleWithKeys receiver = createModuleWithKeys("receiver");
+  connectModules(sender, receiver, !preKeyMessages);
+  const std::string message = generateMessage(messageSize);
+
+  size_t allocations = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    EncryptedData encryptedData =
+        sender.module->encrypt(receiver.module->id, message);
+    const size_t allocationsBefore = getAllocationsCount();
+    state.ResumeTiming();
+
+    decryptFunction(sender, receiver, encryptedData);
+
+    state.PauseTiming();
+    allocations += getAllocationsCount() - allocationsBefore;
+    state.ResumeTiming();
+  }
+  state.counters["allocs_per_msg"] = benchmark::Counter(
+      allocations, benchmark::Counter::kAvgIterations);
+  state.SetBytesProcessed(state.iterations() * messageSize);
+}
+
+void BM_DecryptToString(benchmark::State &state) {
+  runDecryptBenchmark(
+      state,
+      [](ModuleWithKeys &sender,
+         ModuleWithKeys &receiver,
+         const EncryptedData &encryptedData) {
+        benchmark::DoNotOptimize(receiver.module->decrypt(
+            sender.module->id, encryptedData, sender.keys.identityKeys));
+      });
+}
+
+void BM_DecryptIntoBuffer(benchmark::State &state) {
+  OlmBuffer plaintext;
+  runDecryptBenchmark(
+      state,
+      [&plaintext](
+          ModuleWithKeys &sender,
+          ModuleWithKeys &receiver,
+          const EncryptedData &encryptedData) {
+        benchmark::DoNotOptimize(receiver.module->decrypt(
+            sender.module->id,
+            EncryptedDataView(encryptedData),
+            sender.keys.identityKeys,
+            plaintext));
+      });
+}
+
+} // namespace
+
+// args: message size, whether messages are pre-key messages
+BENCHMARK(BM_DecryptToString)->ArgsProduct({{64, 1024, 16 * 1024}, {0, 1}});
+BENCHMARK(BM_DecryptIntoBuffer)->ArgsProduct({{64, 1024, 16 * 1024}, {0, 1}});
@@ -0,0 +1,82 @@
+#include "CryptoBenchmarkTools.h"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+using namespace comm::benchmarks;
+using namespace comm::crypto;
+
+namespace {
+
+// args: message size
+void BM_Encrypt(benchmark::State &state) {
+  const size_t messageSize = state.range(0);
+  ModuleWithKeys sender = createModuleWithKeys("sender");
+  ModuleWithKeys receiver = createModuleWithKeys("receiver");
+  connectModules(sender, receiver, true);
+  const std::string message = generateMessage(messageSize);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        sender.module->encrypt(receiver.module->id, message));
+  }
+  state.SetBytesProcessed(state.iterations() * messageSize);
+  state.SetItemsProcessed(state.iterations());
+}
+
+// args: number of sessions, messages go to every session in turns
+void BM_EncryptAcrossSessions(benchmark::State &state) {
+  const size_t sessionsCount = state.range(0);
+  ModuleWithKeys sender = createModuleWithKeys("sender");
+  std::vector<ModuleWithKeys> peers;
+  createSessions(sender, sessionsCount, peers);
+  const std::string message = generateMessage(1024);
+
+  size_t peerIndex = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        sender.module->encrypt(peers[peerIndex].module->id, message));
+    peerIndex = (peerIndex + 1) % sessionsCount;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// args: number of thread members, every member gets the message through its
+// pairwise session
+void BM_EncryptForThreadPairwise(benchmark::State &state) {
+  const size_t membersCount = state.range(0);
+  ModuleWithKeys sender = createModuleWithKeys("sender");
+  std::vector<ModuleWithKeys> peers;
+  createSessions(sender, membersCount, peers);
+  const std::string message = generateMessage(1024);
+
+  for (auto _ : state) {
+    for (ModuleWithKeys &peer : peers) {
+      benchmark::DoNotOptimize(
+          sender.module->encrypt(peer.module->id, message));
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// args: number of thread members, the message is encrypted once with the
+// thread's group session
+void BM_EncryptForThreadGroup(benchmark::State &state) {
+  ModuleWithKeys sender = createModuleWithKeys("sender");
+  sender.module->initializeOutboundGroupSession("thread");
+  const std::string message = generateMessage(1024);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(sender.module->groupEncrypt("thread", message));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+} // namespace
+
+BENCHMARK(BM_Encrypt)->RangeMultiplier(4)->Range(16, 256 * 1024);
+BENCHMARK(BM_EncryptAcrossSessions)->RangeMultiplier(4)->Range(1, 256);
+BENCHMARK(BM_EncryptForThreadPairwise)->RangeMultiplier(4)->Range(1, 256);
+BENCHMARK(BM_EncryptForThreadGroup)->RangeMultiplier(4)->Range(1, 256);
@@ -0,0 +1,50 @@
+#include "CryptoBenchmarkTools.h"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+using namespace comm::benchmarks;
+using namespace comm::crypto;
+
+namespace {
+
+const std::string secretKey(64, 'k');
+
+// args: number of sessions
+void BM_StoreAsB64(benchmark::State &state) {
+  ModuleWithKeys module = createModuleWithKeys("module");
+  std::vector<ModuleWithKeys> peers;
+  createSessions(module, state.range(0), peers);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(module.module->storeAsB64(secretKey));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// args: number of sessions
+void BM_RestoreFromB64(benchmark::State &state) {
+  ModuleWithKeys module = createModuleWithKeys("module");
+  std::vector<ModuleWithKeys> peers;
+  createSessions(module, state.range(0), peers);
+  const Persist persist = module.module->storeAsB64(secretKey);
+
+  size_t pickleSize = persist.account.size();
+  for (const auto &session : persist.sessions) {
+    pickleSize += session.second.size();
+  }
+
+  CryptoModule restoredModule("restored");
+  for (auto _ : state) {
+    restoredModule.restoreFromB64(secretKey, persist);
+  }
+  state.SetBytesProcessed(state.iterations() * pickleSize);
+  state.SetItemsProcessed(state.iterations());
+}
+
+} // namespace
+
+BENCHMARK(BM_StoreAsB64)->RangeMultiplier(4)->Range(1, 256);
+BENCHMARK(BM_RestoreFromB64)->RangeMultiplier(4)->Range(1, 256);
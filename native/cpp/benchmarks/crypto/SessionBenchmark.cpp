@@ -0,0 +1,47 @@
+#include "CryptoBenchmarkTools.h"
+#include "Session.h"
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+using namespace comm::benchmarks;
+using namespace comm::crypto;
+
+namespace {
+
+void BM_CreateSessionAsInitializer(benchmark::State &state) {
+  std::unique_ptr<AccountWithKeys> sender = createAccountWithKeys();
+  std::unique_ptr<AccountWithKeys> receiver = createAccountWithKeys();
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Session::createSessionAsInitializer(
+        sender->account,
+        sender->keys.identityKeys.data(),
+        receiver->keys.identityKeys,
+        receiver->keys.oneTimeKeys));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_CreateSessionAsResponder(benchmark::State &state) {
+  std::unique_ptr<AccountWithKeys> sender = createAccountWithKeys();
+  std::unique_ptr<AccountWithKeys> receiver = createAccountWithKeys();
+  // olm doesn't remove the one-time key when the inbound session is
+  // created, so the same message can be used for every iteration
+  const OlmBuffer preKeyMessage = createPreKeyMessage(*sender, *receiver);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Session::createSessionAsResponder(
+        receiver->account,
+        receiver->keys.identityKeys.data(),
+        preKeyMessage,
+        sender->keys.identityKeys));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+} // namespace
+
+BENCHMARK(BM_CreateSessionAsInitializer);
+BENCHMARK(BM_CreateSessionAsResponder);
@@ -0,0 +1,38 @@
+#include "AllocationCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<size_t> allocationsCount(0);
+
+} // namespace
+
+void *operator new(size_t size) {
+  allocationsCount.fetch_add(1, std::memory_order_relaxed);
+  void *result = std::malloc(size);
+  if (result == nullptr) {
+    throw std::bad_alloc();
+  }
+  return result;
+}
+
+void operator delete(void *pointer) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void *pointer, size_t) noexcept {
+  std::free(pointer);
+}
+
+namespace comm {
+namespace benchmarks {
+
+size_t getAllocationsCount() {
+  return allocationsCount.load(std::memory_order_relaxed);
+}
+
+} // namespace benchmarks
+} // namespace comm
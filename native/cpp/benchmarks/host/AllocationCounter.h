@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstddef>
+
+namespace comm {
+namespace benchmarks {
+
+// number of calls to the global operator new made so far by the process
+size_t getAllocationsCount();
+
+} // namespace benchmarks
+} // namespace comm
@@ -0,0 +1,20 @@
+#include "PlatformSpecificTools.h"
+
+#include <fstream>
+#include <stdexcept>
+
+namespace comm {
+
+// host implementation used by the benchmarks, the apps use the ones provided
+// by the platforms
+void PlatformSpecificTools::generateSecureRandomBytes(
+    crypto::OlmBuffer &buffer,
+    size_t size) {
+  static std::ifstream urandom("/dev/urandom", std::ios::in | std::ios::binary);
+  buffer.resize(size);
+  if (!urandom.read((char *)buffer.data(), size)) {
+    throw std::runtime_error("error generateSecureRandomBytes => /dev/urandom");
+  }
+}
+
+} // namespace comm
@@ -311,4 +311,130 @@ void testMessagesWrapper(
   }
 }
 
+- (void)testOneTimeKeysPool {
+  try {
+    CryptoModule module("pool");
+    XCTAssert(module.needsOneTimeKeysRefill(), @"new account needs keys");
+    module.refillOneTimeKeys();
+    XCTAssert(
+        module.getUnpublishedOneTimeKeysCount() == ONE_TIME_KEYS_POOL_SIZE,
+        @"pool filled");
+    XCTAssert(!module.needsOneTimeKeysRefill(), @"full pool isn't refilled");
+
+    const std::string secretKey = "pool secret";
+    CryptoModule restored("pool", secretKey, module.storeAsB64(secretKey));
+    XCTAssert(
+        restored.getUnpublishedOneTimeKeysCount() == ONE_TIME_KEYS_POOL_SIZE,
+        @"pool counted after a restore");
+
+    std::string otKeys = module.getOneTimeKeys(ONE_TIME_KEYS_POOL_SIZE);
+    XCTAssert(otKeys.size() > 0, @"pre-generated keys published");
+    XCTAssert(module.getUnpublishedOneTimeKeysCount() == 0, @"pool drained");
+    XCTAssert(module.needsOneTimeKeysRefill(), @"drained pool is refilled");
+  } catch (std::runtime_error &e) {
+    comm::Logger::log("testOneTimeKeysPool error: " + std::string(e.what()));
+    XCTAssert(false);
+  }
+}
+
+- (void)testGroupSessions {
+  try {
+    ModuleWithKeys sender = initializeModuleWithKeys(++currentId);
+    ModuleWithKeys receiverA = initializeModuleWithKeys(++currentId);
+    ModuleWithKeys receiverB = initializeModuleWithKeys(++currentId);
+    const std::string threadId = "thread";
+
+    std::string sessionKey =
+        sender.module->initializeOutboundGroupSession(threadId);
+    for (ModuleWithKeys *receiver : {&receiverA, &receiverB}) {
+      // in the app the key is sent through the pairwise sessions
+      receiver->module->initializeInboundGroupSession(
+          sender.keys.identityKeys, sessionKey);
+    }
+
+    std::uint32_t messageIndex;
+    for (std::uint32_t i = 0; i < 10; ++i) {
+      std::string message = Tools::generateRandomString(50);
+      GroupEncryptedData encryptedData =
+          sender.module->groupEncrypt(threadId, message);
+      XCTAssert(
+          receiverA.module->groupDecrypt(
+              encryptedData, sender.keys.identityKeys, messageIndex) ==
+              message,
+          @"first member decrypted the group message");
+      XCTAssert(messageIndex == i, @"message index returned");
+      XCTAssert(
+          receiverB.module->groupDecrypt(
+              encryptedData, sender.keys.identityKeys, messageIndex) ==
+              message,
+          @"second member decrypted the group message");
+    }
+
+    GroupEncryptedData encryptedData =
+        sender.module->groupEncrypt(threadId, "replayed");
+    receiverA.module->groupDecrypt(
+        encryptedData, sender.keys.identityKeys, messageIndex);
+    try {
+      receiverA.module->groupDecrypt(
+          encryptedData, sender.keys.identityKeys, messageIndex);
+      XCTAssert(false, @"replayed message rejected");
+    } catch (std::runtime_error &) {
+    }
+    try {
+      receiverB.module->groupDecrypt(
+          encryptedData, receiverA.keys.identityKeys, messageIndex);
+      XCTAssert(false, @"session bound to its sender");
+    } catch (std::runtime_error &) {
+    }
+
+    // the key shared later can't decrypt the earlier messages so it doesn't
+    // replace the session
+    receiverB.module->initializeInboundGroupSession(
+        sender.keys.identityKeys,
+        sender.module->getOutboundGroupSessionKey(threadId));
+    XCTAssert(
+        receiverB.module->groupDecrypt(
+            encryptedData, sender.keys.identityKeys, messageIndex) ==
+            "replayed",
+        @"earlier session kept");
+
+    std::string pickleKey = Tools::generateRandomString(20);
+    Persist pickled = receiverA.module->storeAsB64(pickleKey);
+    CryptoModule restoredModule(receiverA.module->id);
+    restoredModule.restoreFromB64(pickleKey, pickled);
+    std::string message = Tools::generateRandomString(50);
+    encryptedData = sender.module->groupEncrypt(threadId, message);
+    XCTAssert(
+        restoredModule.groupDecrypt(
+            encryptedData, sender.keys.identityKeys, messageIndex) == message,
+        @"group message decrypted after repickle");
+  } catch (std::runtime_error &e) {
+    comm::Logger::log("testGroupSessions error: " + std::string(e.what()));
+    XCTAssert(false);
+  }
+}
+
+
+- (void)testPickleBase64RoundTrip {
+  try {
+    ModuleWithKeys module = initializeModuleWithKeys(++currentId);
+    std::string pickleKey = Tools::generateRandomString(20);
+    OlmBuffer pickled = module.module->storeAsB64(pickleKey).account;
+
+    // the database keeps the raw pickle bytes and re-encodes them on load
+    std::vector<std::uint8_t> raw(
+        Tools::getDecodedBase64Length(pickled.size()));
+    raw.resize(Tools::decodeBase64(pickled.data(), pickled.size(), raw.data()));
+    XCTAssert(raw.size() < pickled.size(), @"raw pickle is smaller");
+
+    OlmBuffer encoded;
+    Tools::encodeBase64(raw.data(), raw.size(), encoded);
+    XCTAssert(encoded == pickled, @"pickle survives the round trip");
+  } catch (std::runtime_error &e) {
+    comm::Logger::log(
+        "testPickleBase64RoundTrip error: " + std::string(e.what()));
+    XCTAssert(false);
+  }
+}
+
 @end
@@ -19,6 +19,11 @@ type ClientDBDraftInfo = {
   +text: string,
 };
 
+type ClientGroupEncryptedData = {
+  +sessionID: string,
+  +message: string,
+};
+
 export interface Spec extends TurboModule {
   +getDraft: (key: string) => Promise<string>;
   +updateDraft: (draft: ClientDBDraftInfo) => Promise<boolean>;
@@ -44,6 +49,19 @@ export interface Spec extends TurboModule {
   +initializeCryptoAccount: (userId: string) => Promise<string>;
   +getUserPublicKey: () => Promise<string>;
   +getUserOneTimeKeys: () => Promise<string>;
+  +initializeOutboundGroupSession: (threadID: string) => Promise<string>;
+  +initializeInboundGroupSession: (
+    senderIdentityKeys: string,
+    sessionKey: string,
+  ) => Promise<string>;
+  +groupEncrypt: (
+    threadID: string,
+    content: string,
+  ) => Promise<ClientGroupEncryptedData>;
+  +groupDecrypt: (
+    encryptedData: ClientGroupEncryptedData,
+    senderIdentityKeys: string,
+  ) => Promise<string>;
 }
 
 export default (TurboModuleRegistry.getEnforcing<Spec>(
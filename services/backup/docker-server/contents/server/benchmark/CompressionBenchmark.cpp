@@ -0,0 +1,91 @@
+#include "Compression.h"
+#include "Tools.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+
+using namespace comm::network;
+
+namespace {
+
+// transaction logs are mostly small JSON operations with random identifiers
+std::string createSyntheticLogs(const size_t size) {
+  const char *types[] = {"create_entry", "edit_entry", "send_text", "reaction"};
+  std::mt19937_64 random(2022);
+  std::string result;
+  while (result.size() < size) {
+    result += "{\"type\":\"";
+    result += types[random() % 4];
+    result += "\",\"id\":\"" + std::to_string(random()) + "\",\"thread\":\"" +
+        std::to_string(random() % 100) + "\",\"time\":" +
+        std::to_string(1650000000000 + random() % 1000000000) + "}\n";
+  }
+  result.resize(size);
+  return result;
+}
+
+double megabytesPerSecond(
+    const size_t bytes,
+    const std::chrono::steady_clock::time_point start) {
+  const std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return static_cast<double>(bytes) / (1024 * 1024) / elapsed.count();
+}
+
+} // namespace
+
+// compresses synthetic logs the way ResetKey does (in gRPC sized chunks) and
+// decompresses them the way PullCompaction does, reports the compression
+// ratio and the throughput of both directions
+int main(int argc, char **argv) {
+  const size_t repetitions = 5;
+  const std::string data = createSyntheticLogs(16 * GRPC_CHUNK_SIZE_LIMIT);
+
+  std::string compressed;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < repetitions; ++i) {
+    ZstdCompressor compressor;
+    compressed.clear();
+    for (size_t offset = 0; offset < data.size();
+         offset += GRPC_CHUNK_SIZE_LIMIT) {
+      compressed +=
+          compressor.compress(data.substr(offset, GRPC_CHUNK_SIZE_LIMIT));
+    }
+    compressed += compressor.finish();
+  }
+  const double compressionSpeed =
+      megabytesPerSecond(data.size() * repetitions, start);
+
+  std::string buffer;
+  buffer.resize(GRPC_CHUNK_SIZE_LIMIT);
+  size_t decompressedSize = 0;
+  start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < repetitions; ++i) {
+    ZstdInputStream stream(std::make_shared<std::istringstream>(compressed));
+    while (stream.read((char *)buffer.data(), buffer.size())) {
+      decompressedSize += buffer.size();
+    }
+    decompressedSize += stream.gcount();
+  }
+  const double decompressionSpeed =
+      megabytesPerSecond(data.size() * repetitions, start);
+  if (decompressedSize != data.size() * repetitions) {
+    std::cout << "error: decompressed size mismatch" << std::endl;
+    return 1;
+  }
+
+  std::cout << std::fixed << std::setprecision(2)
+            << "level:              " << ZSTD_COMPRESSION_LEVEL << std::endl
+            << "ratio:              "
+            << static_cast<double>(data.size()) / compressed.size()
+            << std::endl
+            << std::setprecision(1)
+            << "compression MB/s:   " << compressionSpeed << std::endl
+            << "decompression MB/s: " << decompressionSpeed << std::endl;
+  return 0;
+}
@@ -0,0 +1,49 @@
+#include "LocalStorageEngine.h"
+
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace comm::network;
+
+// writes small objects (like log segments and indexes) from concurrent
+// threads, every write is durable when it returns, the directory syncs are
+// shared between the threads so the rate should grow with the threads
+int main(int argc, char **argv) {
+  const std::string path = "/tmp/comm-local-storage-benchmark";
+  const size_t writesPerThread = 200;
+  const std::string data(4096, 'A');
+
+  std::cout << std::setw(10) << "threads" << std::setw(14) << "writes/s"
+            << std::endl;
+  for (const size_t threadsCount : {1, 4, 16}) {
+    std::filesystem::remove_all(path);
+    std::shared_ptr<LocalStorageEngine> engine =
+        std::make_shared<LocalStorageEngine>(path);
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < threadsCount; ++i) {
+      threads.emplace_back([&engine, &data, writesPerThread, i]() {
+        for (size_t j = 0; j < writesPerThread; ++j) {
+          engine->writeObject(
+              "object-" + std::to_string(i) + "-" + std::to_string(j), data);
+        }
+      });
+    }
+    for (std::thread &thread : threads) {
+      thread.join();
+    }
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    std::cout << std::setw(10) << threadsCount << std::setw(14) << std::fixed
+              << std::setprecision(0)
+              << threadsCount * writesPerThread / elapsed.count() << std::endl;
+  }
+  std::filesystem::remove_all(path);
+  return 0;
+}
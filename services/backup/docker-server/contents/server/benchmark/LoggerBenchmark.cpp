@@ -0,0 +1,141 @@
+#include "Logger.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace comm::network;
+
+namespace {
+
+const size_t THREADS_COUNT = 4;
+const size_t HANDLERS_PER_THREAD = 50000;
+// a typical transaction log sent with SendLog
+const size_t PAYLOAD_SIZE = 1024;
+const char *OUTPUT_PATH = "/tmp/comm-logger-benchmark.log";
+
+using LogFunction =
+    std::function<void(const std::string &id, const std::string &data)>;
+
+// stands for the part of SendLog done on the gRPC thread before the storage
+// task is submitted, the payload is read once
+size_t handleRequest(const std::string &data) {
+  size_t checksum = 0;
+  for (const char c : data) {
+    checksum = checksum * 31 + c;
+  }
+  return checksum;
+}
+
+// the latencies of all the handlers in nanoseconds, sorted
+std::vector<int64_t> runHandlers(const LogFunction &log) {
+  const std::string data(PAYLOAD_SIZE, 'x');
+  std::vector<std::vector<int64_t>> latencies(THREADS_COUNT);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < THREADS_COUNT; ++i) {
+    threads.emplace_back([&log, &data, &latencies, i]() {
+      const std::string id = "user-" + std::to_string(i);
+      volatile size_t checksum = 0;
+      latencies[i].reserve(HANDLERS_PER_THREAD);
+      for (size_t j = 0; j < HANDLERS_PER_THREAD; ++j) {
+        const auto start = std::chrono::steady_clock::now();
+        log(id, data);
+        checksum = checksum + handleRequest(data);
+        latencies[i].push_back(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start)
+                .count());
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  std::vector<int64_t> result;
+  for (const std::vector<int64_t> &threadLatencies : latencies) {
+    result.insert(result.end(), threadLatencies.begin(), threadLatencies.end());
+  }
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+double getPercentile(const std::vector<int64_t> &latencies, const double p) {
+  return latencies[static_cast<size_t>(p * (latencies.size() - 1))] / 1000.0;
+}
+
+void report(const std::string &mode, const std::vector<int64_t> &latencies) {
+  std::cout << std::setw(16) << mode << std::setw(12)
+            << getPercentile(latencies, 0.5) << std::setw(12)
+            << getPercentile(latencies, 0.99) << std::setw(12)
+            << getPercentile(latencies, 0.999) << std::setw(12)
+            << latencies.back() / 1000.0 << std::endl;
+}
+
+} // namespace
+
+// runs a SendLog-like handler on several threads and measures its latency
+// without logging, with the synchronous logging the service used to do (the
+// whole payload and a flush per request) and with the asynchronous logger,
+// the logs go to a file so every flush is a real write
+int main(int argc, char **argv) {
+  std::cout << "threads: " << THREADS_COUNT
+            << ", handlers per thread: " << HANDLERS_PER_THREAD
+            << ", payload: " << PAYLOAD_SIZE << " bytes" << std::endl;
+  std::cout << std::fixed << std::setprecision(2) << std::setw(16) << "mode"
+            << std::setw(12) << "p50 us" << std::setw(12) << "p99 us"
+            << std::setw(12) << "p999 us" << std::setw(12) << "max us"
+            << std::endl;
+
+  report("none", runHandlers([](const std::string &, const std::string &) {}));
+
+  {
+    std::ofstream output(OUTPUT_PATH);
+    // the std::cout operations are serialized the same way
+    std::mutex mutex;
+    report(
+        "sync",
+        runHandlers([&output, &mutex](
+                        const std::string &id, const std::string &data) {
+          std::lock_guard<std::mutex> lock(mutex);
+          output << "Backup Service => SendLog, id:[" << id << "] data: ["
+                 << data << "]" << std::endl;
+        }));
+  }
+
+  for (const bool logPayloads : {false, true}) {
+    std::ofstream output(OUTPUT_PATH);
+    LoggerConfig config;
+    // every record is kept, the drops are only caused by a full buffer
+    config.maxRecordsPerSecond = 0;
+    config.logPayloads = logPayloads;
+    std::unique_ptr<Logger> logger = std::make_unique<Logger>(output, config);
+    report(
+        logPayloads ? "async payloads" : "async",
+        runHandlers([&logger](const std::string &id, const std::string &data) {
+          logger->info(
+              "SendLog",
+              {{"user_id", id},
+               {"bytes", data.size()},
+               {"data", logger->payload(data)}});
+        }));
+    logger = nullptr;
+  }
+
+  const Counter &dropped = MetricsRegistry::getInstance().getCounter(
+      "comm_log_records_dropped_total",
+      "The log records dropped instead of blocking the caller.",
+      {{"reason", "buffer_full"}});
+  std::cout << "async records dropped with a full buffer: " << dropped.get()
+            << std::endl;
+  std::remove(OUTPUT_PATH);
+  return 0;
+}
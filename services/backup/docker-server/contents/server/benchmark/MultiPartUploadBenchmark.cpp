@@ -0,0 +1,56 @@
+#include "AwsS3Bucket.h"
+#include "AwsStorageManager.h"
+#include "MultiPartUploader.h"
+#include "StorageConfig.h"
+#include "Tools.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+
+using namespace comm::network;
+
+// uploads an object the way ResetKey receives it (in gRPC sized chunks) with
+// different numbers of concurrent part uploads and reports the throughput
+int main(int argc, char **argv) {
+  const size_t objectSize = 20 * AWS_MULTIPART_UPLOAD_MINIMUM_CHUNK_SIZE;
+  const size_t repetitions = 5;
+  const std::string bucketName = "commapp-benchmark";
+  const std::string objectName = "multipart-upload-benchmark";
+
+  StorageConfig config = StorageConfig::load();
+  std::cout << "storage engine: "
+            << ((config.storageEngine == STORAGE_ENGINE::LOCAL) ? "local"
+                                                                 : "s3")
+            << std::endl;
+  AwsStorageManager storageManager(config);
+  AwsS3Bucket &bucket = storageManager.getBucket(bucketName);
+
+  std::string chunk;
+  chunk.resize(GRPC_CHUNK_SIZE_LIMIT, 'A');
+
+  std::cout << std::setw(18) << "parallel uploads" << std::setw(14) << "MB/s"
+            << std::endl;
+  for (const size_t parallelUploads : {1, 2, 4, 8}) {
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < repetitions; ++i) {
+      std::unique_ptr<MultiPartUploader> uploader =
+          bucket.startMultiPartUpload(objectName, parallelUploads);
+      for (size_t offset = 0; offset < objectSize; offset += chunk.size()) {
+        uploader->addPart(chunk);
+      }
+      uploader->finishUpload();
+    }
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    const double megabytes =
+        static_cast<double>(objectSize * repetitions) / (1024 * 1024);
+    std::cout << std::setw(18) << parallelUploads << std::setw(14)
+              << std::fixed << std::setprecision(1)
+              << megabytes / elapsed.count() << std::endl;
+  }
+  bucket.deleteObject(objectName);
+  return 0;
+}
@@ -1,204 +1,83 @@
 #include "AwsS3Bucket.h"
+#include "Compression.h"
 #include "MultiPartUploader.h"
 #include "Tools.h"
 
-#include <aws/s3/model/CopyObjectRequest.h>
-#include <aws/s3/model/DeleteObjectRequest.h>
-#include <aws/s3/model/GetObjectRequest.h>
-#include <aws/s3/model/HeadBucketRequest.h>
-#include <aws/s3/model/HeadObjectRequest.h>
-#include <aws/s3/model/ListObjectsRequest.h>
-#include <aws/s3/model/Object.h>
-#include <aws/s3/model/PutObjectRequest.h>
-
-#include <boost/interprocess/streams/bufferstream.hpp>
-
 namespace comm {
 namespace network {
 
 AwsS3Bucket::AwsS3Bucket(
     const std::string name,
-    std::shared_ptr<Aws::S3::S3Client> client)
-    : name(name), client(client) {
+    std::shared_ptr<StorageEngine> engine,
+    TaskSubmitter submit)
+    : name(name), engine(engine), submit(std::move(submit)) {
 }
 
 std::vector<std::string> AwsS3Bucket::listObjects() {
-  Aws::S3::Model::ListObjectsRequest request;
-  request.SetBucket(this->name);
-  std::vector<std::string> result;
-
-  Aws::S3::Model::ListObjectsOutcome outcome =
-      this->client->ListObjects(request);
-  if (!outcome.IsSuccess()) {
-    throw std::runtime_error(outcome.GetError().GetMessage());
-  }
-  Aws::Vector<Aws::S3::Model::Object> objects =
-      outcome.GetResult().GetContents();
-  for (Aws::S3::Model::Object &object : objects) {
-    result.push_back(object.GetKey());
-  }
-  return result;
+  return this->engine->listObjects();
 }
 
 bool AwsS3Bucket::isAvailable() const {
-  Aws::S3::Model::HeadBucketRequest headRequest;
-  headRequest.SetBucket(this->name);
-  Aws::S3::Model::HeadBucketOutcome outcome =
-      this->client->HeadBucket(headRequest);
-  return outcome.IsSuccess();
+  return this->engine->isAvailable();
+}
+
+bool AwsS3Bucket::objectExists(const std::string &objectName) {
+  return this->engine->objectExists(objectName);
 }
 
 const size_t AwsS3Bucket::getObjectSize(const std::string &objectName) {
-  Aws::S3::Model::HeadObjectRequest headRequest;
-  headRequest.SetBucket(this->name);
-  headRequest.SetKey(objectName);
-  Aws::S3::Model::HeadObjectOutcome headOutcome =
-      this->client->HeadObject(headRequest);
-  if (!headOutcome.IsSuccess()) {
-    throw std::runtime_error(headOutcome.GetError().GetMessage());
-  }
-  return headOutcome.GetResultWithOwnership().GetContentLength();
+  return this->engine->getObjectSize(objectName);
 }
 
 void AwsS3Bucket::renameObject(
     const std::string &currentName,
     const std::string &newName) {
-  Aws::S3::Model::CopyObjectRequest copyRequest;
-  copyRequest.SetCopySource(this->name + "/" + currentName);
-  copyRequest.SetKey(newName);
-  copyRequest.SetBucket(this->name);
-
-  Aws::S3::Model::CopyObjectOutcome copyOutcome =
-      this->client->CopyObject(copyRequest);
-  if (!copyOutcome.IsSuccess()) {
-    throw std::runtime_error(copyOutcome.GetError().GetMessage());
-  }
-
-  this->deleteObject(currentName);
+  this->engine->renameObject(currentName, newName);
 }
 
-void AwsS3Bucket::writeObject(
+std::string AwsS3Bucket::writeObject(
     const std::string &objectName,
     const std::string data) {
-  // we don't have to handle multiple write here because the GRPC limit is 4MB
-  // and minimum size of data to perform multipart upload is 5MB
-  Aws::S3::Model::PutObjectRequest request;
-  request.SetBucket(this->name);
-  request.SetKey(objectName);
-
-  std::shared_ptr<Aws::IOStream> body = std::shared_ptr<Aws::IOStream>(
-      new boost::interprocess::bufferstream((char *)data.data(), data.size()));
-
-  request.SetBody(body);
-
-  Aws::S3::Model::PutObjectOutcome outcome = this->client->PutObject(request);
-
-  if (!outcome.IsSuccess()) {
-    throw std::runtime_error(outcome.GetError().GetMessage());
-  }
+  return this->engine->writeObject(objectName, data);
 }
 
 std::string AwsS3Bucket::getObjectData(const std::string &objectName) {
-  Aws::S3::Model::GetObjectRequest request;
-  request.SetBucket(this->name);
-  request.SetKey(objectName);
-
-  Aws::S3::Model::GetObjectOutcome outcome = this->client->GetObject(request);
-
-  if (!outcome.IsSuccess()) {
-    throw std::runtime_error(outcome.GetError().GetMessage());
-  }
-
-  const size_t size = this->getObjectSize(objectName);
-  if (size > GRPC_CHUNK_SIZE_LIMIT) {
-    throw invalid_argument_error(std::string(
-        "The file is too big(" + std::to_string(size) + " bytes, max is " +
-        std::to_string(GRPC_CHUNK_SIZE_LIMIT) +
-        "bytes), please, use getObjectDataChunks"));
-  }
-  Aws::IOStream &retrievedFile = outcome.GetResultWithOwnership().GetBody();
-
-  std::string result;
-  result.resize(size);
-  retrievedFile.get((char *)result.data(), size + 1);
+  return this->engine->getObjectData(objectName);
+}
 
-  return result;
+std::shared_ptr<std::istream>
+AwsS3Bucket::openObjectStream(const std::string &objectName) {
+  return this->engine->openObjectStream(objectName);
 }
 
 void AwsS3Bucket::getObjectDataChunks(
     const std::string &objectName,
     const std::function<void(const std::string &)> &callback,
-    const size_t chunkSize) {
-  const size_t fileSize = this->getObjectSize(objectName);
-
-  if (fileSize == 0) {
-    return;
+    const size_t chunkSize,
+    const OBJECT_CODEC codec) {
+  // a single request is made for the whole object and its body is read in
+  // chunks into one buffer, the buffer is only valid during the callback
+  std::shared_ptr<std::istream> retrievedFile =
+      decodeStream(this->openObjectStream(objectName), codec);
+  std::string buffer;
+  buffer.resize(chunkSize);
+  while (retrievedFile->read((char *)buffer.data(), chunkSize)) {
+    callback(buffer);
   }
-
-  Aws::S3::Model::GetObjectRequest request;
-  request.SetBucket(this->name);
-  request.SetKey(objectName);
-  for (size_t offset = 0; offset < fileSize; offset += chunkSize) {
-    const size_t nextSize = std::min(chunkSize, fileSize - offset);
-
-    std::string range = "bytes=" + std::to_string(offset) + "-" +
-        std::to_string(offset + nextSize);
-    request.SetRange(range);
-
-    Aws::S3::Model::GetObjectOutcome getOutcome =
-        this->client->GetObject(request);
-    if (!getOutcome.IsSuccess()) {
-      throw std::runtime_error(getOutcome.GetError().GetMessage());
-    }
-
-    Aws::IOStream &retrievedFile =
-        getOutcome.GetResultWithOwnership().GetBody();
-    std::string result;
-    result.resize(nextSize);
-    retrievedFile.get((char *)result.data(), nextSize + 1);
-    callback(result);
+  const size_t lastChunkSize = retrievedFile->gcount();
+  if (lastChunkSize) {
+    buffer.resize(lastChunkSize);
+    callback(buffer);
   }
 }
 
-void AwsS3Bucket::appendToObject(
+std::unique_ptr<MultiPartUploader> AwsS3Bucket::startMultiPartUpload(
     const std::string &objectName,
-    const std::string data) {
-  const size_t objectSize = this->getObjectSize(objectName);
-  if (objectSize < AWS_MULTIPART_UPLOAD_MINIMUM_CHUNK_SIZE) {
-    std::string currentData = this->getObjectData(objectName);
-    currentData += data;
-    this->writeObject(objectName, currentData);
-    return;
-  }
-  size_t currentSize = 0;
-  MultiPartUploader uploader(
-      this->client, this->name, objectName + "-multipart");
-  std::function<void(const std::string &)> callback =
-      [&uploader, &data, &currentSize, objectSize](const std::string &chunk) {
-        currentSize += chunk.size();
-        if (currentSize < objectSize) {
-          uploader.addPart(chunk);
-        } else if (currentSize == objectSize) {
-          uploader.addPart(std::string(chunk + data));
-        } else {
-          throw std::runtime_error(
-              "size of chunks exceeds the size of the object");
-        }
-      };
-  this->getObjectDataChunks(
-      objectName, callback, AWS_MULTIPART_UPLOAD_MINIMUM_CHUNK_SIZE);
-  uploader.finishUpload();
-  // this will overwrite the target file
-  this->renameObject(objectName + "-multipart", objectName);
-  const size_t newSize = this->getObjectSize(objectName);
-  if (objectSize + data.size() != newSize) {
-    throw std::runtime_error(
-        "append to object " + objectName +
-        " has been performed but the final sizes don't "
-        "match, the size is now [" +
-        std::to_string(newSize) + "] but should be [" +
-        std::to_string(objectSize + data.size()) + "]");
-  }
+    const size_t parallelUploads) {
+  return std::make_unique<MultiPartUploader>(
+      this->engine->startMultiPartUpload(objectName),
+      parallelUploads,
+      this->submit);
 }
 
 void AwsS3Bucket::clearObject(const std::string &objectName) {
@@ -206,16 +85,7 @@ void AwsS3Bucket::clearObject(const std::string &objectName) {
 }
 
 void AwsS3Bucket::deleteObject(const std::string &objectName) {
-  Aws::S3::Model::DeleteObjectRequest deleteRequest;
-
-  deleteRequest.SetKey(objectName);
-  deleteRequest.SetBucket(this->name);
-
-  Aws::S3::Model::DeleteObjectOutcome deleteOutcome =
-      this->client->DeleteObject(deleteRequest);
-  if (!deleteOutcome.IsSuccess()) {
-    throw std::runtime_error(deleteOutcome.GetError().GetMessage());
-  }
+  this->engine->deleteObject(objectName);
 }
 
 } // namespace network
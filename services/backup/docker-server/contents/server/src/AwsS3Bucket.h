@@ -1,35 +1,54 @@
 #pragma once
 
-#include <aws/core/Aws.h>
-#include <aws/s3/S3Client.h>
+#include "StorageEngine.h"
+#include "StorageTask.h"
+#include "Tools.h"
 
 #include <functional>
+#include <istream>
+#include <memory>
 #include <string>
 #include <vector>
 
 namespace comm {
 namespace network {
 
+class MultiPartUploader;
+
+/**
+ * A bucket of objects, the objects are kept by the storage engine (S3 or the
+ * local filesystem) and everything above the basic operations is implemented
+ * here the same way for every engine. The parallel parts are uploaded
+ * on the storage manager's executor.
+ */
 class AwsS3Bucket {
   const std::string name;
-  std::shared_ptr<Aws::S3::S3Client> client;
+  std::shared_ptr<StorageEngine> engine;
+  TaskSubmitter submit;
 
 public:
   AwsS3Bucket(
       const std::string name,
-      std::shared_ptr<Aws::S3::S3Client> client);
+      std::shared_ptr<StorageEngine> engine,
+      TaskSubmitter submit = nullptr);
 
   std::vector<std::string> listObjects();
   bool isAvailable() const;
+  bool objectExists(const std::string &objectName);
   const size_t getObjectSize(const std::string &objectName);
   void renameObject(const std::string &currentName, const std::string &newName);
-  void writeObject(const std::string &objectName, const std::string data);
+  std::string
+  writeObject(const std::string &objectName, const std::string data);
   std::string getObjectData(const std::string &objectName);
+  std::shared_ptr<std::istream> openObjectStream(const std::string &objectName);
   void getObjectDataChunks(
       const std::string &objectName,
       const std::function<void(const std::string &)> &callback,
-      const size_t chunkSize);
-  void appendToObject(const std::string &objectName, const std::string data);
+      const size_t chunkSize,
+      const OBJECT_CODEC codec = OBJECT_CODEC::NONE);
+  std::unique_ptr<MultiPartUploader> startMultiPartUpload(
+      const std::string &objectName,
+      const size_t parallelUploads = AWS_PARALLEL_UPLOADS);
   void clearObject(const std::string &objectName);
   void deleteObject(const std::string &objectName);
 };
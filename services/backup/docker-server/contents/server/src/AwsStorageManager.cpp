@@ -1,23 +1,109 @@
 #include "AwsStorageManager.h"
-
+#include "LocalStorageEngine.h"
+#include "Logger.h"
+#include "Metrics.h"
+#include "S3StorageEngine.h"
 #include "Tools.h"
 
+#include <aws/core/client/DefaultRetryStrategy.h>
 #include <aws/s3/model/Bucket.h>
 
+#include <filesystem>
+
 namespace comm {
 namespace network {
 
-AwsStorageManager::AwsStorageManager() {
-  Aws::Client::ClientConfiguration config;
-  config.region = this->region;
-  this->client = std::make_shared<Aws::S3::S3Client>(config);
+namespace {
+
+Gauge &getQueuedTasks() {
+  static Gauge &queuedTasks = MetricsRegistry::getInstance().getGauge(
+      "backup_storage_tasks_queued",
+      "The storage tasks waiting for an executor thread.");
+  return queuedTasks;
 }
 
-AwsS3Bucket AwsStorageManager::getBucket(const std::string &bucketName) {
-  return AwsS3Bucket(bucketName, this->client);
+Gauge &getRunningTasks() {
+  static Gauge &runningTasks = MetricsRegistry::getInstance().getGauge(
+      "backup_storage_tasks_running",
+      "The storage tasks being run by the executor threads.");
+  return runningTasks;
+}
+
+// counts the task as running until it returns or throws
+struct RunningTask {
+  RunningTask() {
+    getRunningTasks().add(1);
+  }
+  ~RunningTask() {
+    getRunningTasks().add(-1);
+  }
+};
+
+} // namespace
+
+AwsStorageManager::AwsStorageManager(const StorageConfig &config)
+    : config(config) {
+  this->executor =
+      std::make_shared<Aws::Utils::Threading::PooledThreadExecutor>(
+          config.executorThreads);
+  if (config.storageEngine != STORAGE_ENGINE::S3) {
+    return;
+  }
+  Aws::Client::ClientConfiguration clientConfig;
+  clientConfig.region = config.region;
+  // the client's *Async calls run on the same bounded pool as the tasks
+  // submitted by the service
+  clientConfig.executor = this->executor;
+  // connections are pooled per client, a pool smaller than the number of
+  // concurrent requests makes the requests wait for a free connection
+  clientConfig.maxConnections = config.getS3MaxConnections();
+  clientConfig.connectTimeoutMs = config.s3ConnectTimeoutMs;
+  clientConfig.requestTimeoutMs = config.s3RequestTimeoutMs;
+  clientConfig.enableTcpKeepAlive = config.s3TcpKeepAlive;
+  clientConfig.tcpKeepAliveIntervalMs = config.s3TcpKeepAliveIntervalMs;
+  clientConfig.retryStrategy =
+      std::make_shared<Aws::Client::DefaultRetryStrategy>(
+          config.s3MaxRetries, config.s3RetryScaleFactor);
+  this->client = std::make_shared<Aws::S3::S3Client>(clientConfig);
+}
+
+AwsS3Bucket &AwsStorageManager::getBucket(const std::string &bucketName) {
+  std::lock_guard<std::mutex> lock(this->bucketsMutex);
+  auto it = this->buckets.find(bucketName);
+  if (it == this->buckets.end()) {
+    std::shared_ptr<StorageEngine> engine;
+    if (this->config.storageEngine == STORAGE_ENGINE::LOCAL) {
+      engine = std::make_shared<LocalStorageEngine>(
+          this->config.localStoragePath + "/" + bucketName,
+          this->config.localStorageSync);
+    } else {
+      engine = std::make_shared<S3StorageEngine>(this->client, bucketName);
+    }
+    it = this->buckets
+             .emplace(
+                 bucketName,
+                 AwsS3Bucket(
+                     bucketName,
+                     engine,
+                     [this](std::function<void()> task) {
+                       this->submit(std::move(task));
+                     }))
+             .first;
+  }
+  return it->second;
 }
 
 std::vector<std::string> AwsStorageManager::listBuckets() {
+  if (this->config.storageEngine == STORAGE_ENGINE::LOCAL) {
+    std::vector<std::string> result;
+    for (const auto &entry : std::filesystem::directory_iterator(
+             this->config.localStoragePath)) {
+      if (entry.is_directory()) {
+        result.push_back(entry.path().filename());
+      }
+    }
+    return result;
+  }
   Aws::S3::Model::ListBucketsOutcome outcome = this->client->ListBuckets();
   std::vector<std::string> result;
   if (!outcome.IsSuccess()) {
@@ -31,5 +117,30 @@ std::vector<std::string> AwsStorageManager::listBuckets() {
   return result;
 }
 
+void AwsStorageManager::submit(std::function<void()> task) {
+  getQueuedTasks().add(1);
+  const bool submitted =
+      this->executor->Submit([task = std::move(task)]() {
+        getQueuedTasks().add(-1);
+        RunningTask running;
+        // storage tasks forward their errors to the waiters through futures
+        // and the RPCs finish their calls with an error status, anything
+        // escaping to the pool thread would terminate the process
+        try {
+          task();
+        } catch (std::exception &e) {
+          Logger::getInstance().error(
+              "storage task failed", {{"error", e.what()}});
+        } catch (...) {
+          Logger::getInstance().error(
+              "storage task failed", {{"error", "unknown exception"}});
+        }
+      });
+  if (!submitted) {
+    getQueuedTasks().add(-1);
+    throw std::runtime_error("storage task could not be scheduled");
+  }
+}
+
 } // namespace network
 } // namespace comm
@@ -1,25 +1,41 @@
 #pragma once
 
 #include "AwsS3Bucket.h"
+#include "StorageConfig.h"
 
 #include <aws/core/Aws.h>
+#include <aws/core/utils/threading/Executor.h>
 #include <aws/s3/S3Client.h>
 
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace comm {
 namespace network {
 
+/**
+ * Owns the storage engine of every bucket and, for S3, the single client of
+ * the process and its connection pool. Buckets are created once and shared by
+ * all of the calls.
+ */
 class AwsStorageManager {
-  const std::string region = "us-east-2";
+  const StorageConfig config;
+  std::shared_ptr<Aws::Utils::Threading::PooledThreadExecutor> executor;
   std::shared_ptr<Aws::S3::S3Client> client;
+  std::mutex bucketsMutex;
+  std::unordered_map<std::string, AwsS3Bucket> buckets;
 
 public:
-  AwsStorageManager();
-  AwsS3Bucket getBucket(const std::string &bucketName);
+  AwsStorageManager(const StorageConfig &config = StorageConfig());
+  AwsS3Bucket &getBucket(const std::string &bucketName);
   std::vector<std::string> listBuckets();
+  // exceptions thrown by the task are logged, tasks report their errors
+  // themselves
+  void submit(std::function<void()> task);
 };
 
 } // namespace network
@@ -1,6 +1,13 @@
 #include "BackupServiceImpl.h"
+#include "Compression.h"
+#include "Logger.h"
+#include "MultiPartUploader.h"
+#include "SegmentedObject.h"
+#include "StorageMetrics.h"
 
-#include <iostream>
+#include <deque>
+#include <iterator>
+#include <utility>
 
 namespace comm {
 namespace network {
@@ -17,160 +24,529 @@ std::string BackupServiceImpl::generateObjectName(
   if (objectType == OBJECT_TYPE::COMPACTION) {
     return userId + "-compaction";
   }
+  if (objectType == OBJECT_TYPE::INDEX) {
+    return userId + "-index";
+  }
   throw std::runtime_error("unhandled operation");
 }
 
-BackupServiceImpl::BackupServiceImpl() {
-  Aws::InitAPI({});
-  this->storageManager = std::make_unique<AwsStorageManager>();
-  if (!this->storageManager->getBucket(this->bucketName).isAvailable()) {
+std::shared_ptr<UserIndex>
+BackupServiceImpl::findUserIndex(const std::string &userId) {
+  auto it = this->userIndexes.find(userId);
+  if (it != this->userIndexes.end()) {
+    this->userIndexesUsage.splice(
+        this->userIndexesUsage.begin(),
+        this->userIndexesUsage,
+        it->second.usage);
+    return it->second.index;
+  }
+  auto evicted = this->evictedUserIndexes.find(userId);
+  if (evicted == this->evictedUserIndexes.end()) {
+    return nullptr;
+  }
+  std::shared_ptr<UserIndex> index = evicted->second.lock();
+  this->evictedUserIndexes.erase(evicted);
+  if (index != nullptr) {
+    this->cacheUserIndex(userId, index);
+  }
+  return index;
+}
+
+void BackupServiceImpl::cacheUserIndex(
+    const std::string &userId,
+    std::shared_ptr<UserIndex> index) {
+  if (this->userIndexes.size() >= USER_INDEX_CACHE_SIZE) {
+    auto oldest = this->userIndexes.find(this->userIndexesUsage.back());
+    // an index used by a call has to be found by the next call of the same
+    // user, otherwise a second instance would be loaded and the two would
+    // overwrite each other's changes
+    if (oldest->second.index.use_count() > 1) {
+      for (auto it = this->evictedUserIndexes.begin();
+           it != this->evictedUserIndexes.end();) {
+        it = it->second.expired() ? this->evictedUserIndexes.erase(it)
+                                  : std::next(it);
+      }
+      this->evictedUserIndexes.emplace(oldest->first, oldest->second.index);
+    }
+    this->userIndexes.erase(oldest);
+    this->userIndexesUsage.pop_back();
+  }
+  this->userIndexesUsage.push_front(userId);
+  this->userIndexes.emplace(
+      userId, CachedUserIndex{index, this->userIndexesUsage.begin()});
+}
+
+std::shared_ptr<UserIndex>
+BackupServiceImpl::getUserIndex(const std::string &userId) {
+  {
+    std::lock_guard<std::mutex> lock(this->userIndexesMutex);
+    std::shared_ptr<UserIndex> index = this->findUserIndex(userId);
+    if (index != nullptr) {
+      return index;
+    }
+  }
+  // the index is loaded without holding the lock, if another call loaded it
+  // in the meantime that one is used
+  std::shared_ptr<UserIndex> index = std::make_shared<UserIndex>(
+      *this->bucket, this->generateObjectName(userId, OBJECT_TYPE::INDEX));
+  std::lock_guard<std::mutex> lock(this->userIndexesMutex);
+  std::shared_ptr<UserIndex> loadedIndex = this->findUserIndex(userId);
+  if (loadedIndex != nullptr) {
+    return loadedIndex;
+  }
+  this->cacheUserIndex(userId, index);
+  return index;
+}
+
+BackupServiceImpl::BackupServiceImpl(const StorageConfig &config)
+    : config(config),
+      resetKeyMetrics("backup", "ResetKey"),
+      sendLogMetrics("backup", "SendLog"),
+      pullBackupKeyMetrics("backup", "PullBackupKey"),
+      pullCompactionMetrics("backup", "PullCompaction"),
+      receivedBytes(MetricsRegistry::getInstance().getCounter(
+          "backup_received_bytes_total",
+          "The data received in the requests.")),
+      sentBytes(MetricsRegistry::getInstance().getCounter(
+          "backup_sent_bytes_total",
+          "The data sent in the responses.")) {
+  this->sdkOptions.monitoringOptions.customizedMonitoringFactory_create_fn
+      .push_back(StorageMetrics::createMonitoringFactory);
+  Aws::InitAPI(this->sdkOptions);
+  this->storageManager = std::make_unique<AwsStorageManager>(this->config);
+  this->bucket = &this->storageManager->getBucket(this->bucketName);
+  if (!this->bucket->isAvailable()) {
     throw std::runtime_error("bucket " + this->bucketName + " not available");
   }
 }
 
 BackupServiceImpl::~BackupServiceImpl() {
-  Aws::ShutdownAPI({});
+  // the S3 client has to be released before the SDK is shut down
+  this->userIndexes.clear();
+  this->userIndexesUsage.clear();
+  this->evictedUserIndexes.clear();
+  this->storageManager = nullptr;
+  Aws::ShutdownAPI(this->sdkOptions);
 }
 
-grpc::Status BackupServiceImpl::ResetKey(
-    grpc::ServerContext *context,
-    grpc::ServerReader<backup::ResetKeyRequest> *reader,
-    google::protobuf::Empty *response) {
+class BackupServiceImpl::ResetKeyReactor
+    : public grpc::ServerReadReactor<backup::ResetKeyRequest> {
+  BackupServiceImpl *service;
+  grpc::CallbackServerContext *context;
+  const std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
   backup::ResetKeyRequest request;
   std::string id;
-  AwsS3Bucket bucket = this->storageManager->getBucket(this->bucketName);
+  std::string newKey;
+  // the compaction is streamed into a single upload which replaces the
+  // current compaction only when the whole stream has been received
+  std::unique_ptr<MultiPartUploader> compactionUploader;
+  // set when the service compresses, the chunks become one zstd frame
+  std::unique_ptr<ZstdCompressor> compactionCompressor;
+
+  void handleRequest();
+  void finishReading();
+  void fail(const std::string &error);
+  void finish(const grpc::Status &status);
+
+public:
+  ResetKeyReactor(
+      BackupServiceImpl *service,
+      grpc::CallbackServerContext *context)
+      : service(service), context(context) {
+    this->StartRead(&this->request);
+  }
+
+  void OnReadDone(bool ok) override {
+    if (!ok) {
+      this->service->storageManager->submit(
+          [this]() { this->finishReading(); });
+      return;
+    }
+    this->service->storageManager->submit([this]() { this->handleRequest(); });
+  }
+
+  void OnDone() override {
+    delete this;
+  }
+};
+
+void BackupServiceImpl::ResetKeyReactor::fail(const std::string &error) {
+  Logger::getInstance().error(
+      "ResetKey failed", {{"user_id", this->id}, {"error", error}});
+  if (this->compactionUploader != nullptr) {
+    try {
+      this->compactionUploader->abortUpload();
+    } catch (std::runtime_error &e) {
+      Logger::getInstance().warning(
+          "aborting the compaction upload failed",
+          {{"user_id", this->id}, {"error", e.what()}});
+    }
+    this->compactionUploader = nullptr;
+  }
+  this->finish(grpc::Status(grpc::StatusCode::INTERNAL, error));
+}
+
+void BackupServiceImpl::ResetKeyReactor::finish(const grpc::Status &status) {
+  this->service->resetKeyMetrics.record(this->start, status.ok());
+  this->Finish(status);
+}
+
+void BackupServiceImpl::ResetKeyReactor::handleRequest() {
   try {
-    while (reader->Read(&request)) {
-      if (!id.size()) {
-        id = request.userid();
-      } else if (id != request.userid()) {
-        throw std::runtime_error("id mismatch: " + id + "/" + request.userid());
+    if (!this->id.size()) {
+      this->id = this->request.userid();
+    } else if (this->id != this->request.userid()) {
+      throw std::runtime_error(
+          "id mismatch: " + this->id + "/" + this->request.userid());
+    }
+    const std::string &newKey = this->request.newkey();
+    const std::string &compactionChunk = this->request.compactionchunk();
+    this->service->receivedBytes.increment(
+        newKey.size() + compactionChunk.size());
+    // the following behavior assumes that the client sends:
+    // 1. key + empty chunk
+    // 2. empty key + chunk
+    // ...
+    // N. empty key + chunk
+    Logger &logger = Logger::getInstance();
+    if (newKey.size()) {
+      logger.debug(
+          "ResetKey key",
+          {{"user_id", this->id}, {"key", logger.payload(newKey)}});
+      this->newKey = newKey;
+    } else if (compactionChunk.size()) {
+      // the chunks are big, they aren't copied unless they get logged
+      if (logger.isEnabled(LOG_LEVEL::DEBUG)) {
+        logger.debug(
+            "ResetKey chunk",
+            {{"user_id", this->id},
+             {"bytes", compactionChunk.size()},
+             {"chunk", logger.payload(compactionChunk)}});
+      }
+      if (this->compactionUploader == nullptr) {
+        this->compactionUploader =
+            this->service->bucket->startMultiPartUpload(
+                this->service->generateObjectName(
+                    this->id, OBJECT_TYPE::COMPACTION));
+        if (this->service->config.codec == OBJECT_CODEC::ZSTD) {
+          this->compactionCompressor = std::make_unique<ZstdCompressor>();
+        }
       }
-      const std::string newKey = request.newkey();
-      const std::string compactionChunk = request.compactionchunk();
-      // the following behavior assumes that the client sends:
-      // 1. key + empty chunk
-      // 2. empty key + chunk
-      // ...
-      // N. empty key + chunk
-      if (newKey.size()) {
-        std::cout << "Backup Service => ResetKey(this log will be removed) "
-                     "reading key ["
-                  << newKey << "]" << std::endl;
-        bucket.writeObject(
-            this->generateObjectName(id, OBJECT_TYPE::ENCRYPTED_BACKUP_KEY),
-            newKey);
-        bucket.clearObject(
-            this->generateObjectName(id, OBJECT_TYPE::COMPACTION));
-      } else if (compactionChunk.size()) {
-        std::cout << "Backup Service => ResetKey(this log will be removed) "
-                     "reading chunk ["
-                  << compactionChunk << "]" << std::endl;
-        bucket.appendToObject(
-            this->generateObjectName(id, OBJECT_TYPE::COMPACTION),
-            compactionChunk);
+      if (this->compactionCompressor != nullptr) {
+        // the compressor buffers small inputs, an empty part is skipped
+        const std::string compressedChunk =
+            this->compactionCompressor->compress(compactionChunk);
+        if (compressedChunk.size()) {
+          this->compactionUploader->addPart(compressedChunk);
+        }
+      } else {
+        this->compactionUploader->addPart(compactionChunk);
       }
     }
-    bucket.clearObject(
-        this->generateObjectName(id, OBJECT_TYPE::TRANSACTION_LOGS));
-  } catch (std::runtime_error &e) {
-    std::cout << "error: " << e.what() << std::endl;
-    return grpc::Status(grpc::StatusCode::INTERNAL, e.what());
+  } catch (std::exception &e) {
+    this->fail(e.what());
+    return;
   }
-  return grpc::Status::OK;
+  this->StartRead(&this->request);
 }
 
-grpc::Status BackupServiceImpl::SendLog(
-    grpc::ServerContext *context,
+void BackupServiceImpl::ResetKeyReactor::finishReading() {
+  // reading also stops when the call gets cancelled, nothing is committed then
+  if (this->context->IsCancelled()) {
+    try {
+      if (this->compactionUploader != nullptr) {
+        this->compactionUploader->abortUpload();
+      }
+    } catch (std::runtime_error &e) {
+      Logger::getInstance().warning(
+          "aborting the compaction upload failed",
+          {{"user_id", this->id}, {"error", e.what()}});
+    }
+    this->finish(grpc::Status::CANCELLED);
+    return;
+  }
+  try {
+    AwsS3Bucket &bucket = *this->service->bucket;
+    const std::string compactionName =
+        this->service->generateObjectName(this->id, OBJECT_TYPE::COMPACTION);
+    std::shared_ptr<UserIndex> index = this->service->getUserIndex(this->id);
+    std::unique_lock<std::mutex> indexLock = index->lock();
+    // pulls in progress stop before opening an object which is replaced here
+    index->nextGeneration();
+    ObjectMetadata metadata;
+    if (this->compactionUploader != nullptr) {
+      if (this->compactionCompressor != nullptr) {
+        this->compactionUploader->addPart(
+            this->compactionCompressor->finish());
+        metadata = this->compactionUploader->finishUpload();
+        metadata.codec = OBJECT_CODEC::ZSTD;
+      } else {
+        metadata = this->compactionUploader->finishUpload();
+      }
+      this->compactionUploader = nullptr;
+    } else {
+      metadata.eTag = bucket.writeObject(compactionName, "");
+    }
+    // the compaction has already been replaced, its metadata is stored before
+    // anything else can fail
+    index->setObjectMetadata(compactionName, metadata);
+    index->store();
+    if (this->newKey.size()) {
+      bucket.writeObject(
+          this->service->generateObjectName(
+              this->id, OBJECT_TYPE::ENCRYPTED_BACKUP_KEY),
+          this->newKey);
+    }
+    SegmentedObject(
+        bucket,
+        *index,
+        this->service->generateObjectName(
+            this->id, OBJECT_TYPE::TRANSACTION_LOGS))
+        .clear();
+  } catch (std::exception &e) {
+    this->fail(e.what());
+    return;
+  }
+  this->finish(grpc::Status::OK);
+}
+
+class BackupServiceImpl::PullCompactionReactor
+    : public grpc::ServerWriteReactor<backup::PullCompactionResponse> {
+  BackupServiceImpl *service;
+  const std::string id;
+  const std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  struct PendingObject {
+    std::string name;
+    OBJECT_TYPE type;
+    OBJECT_CODEC codec;
+  };
+  // objects to send in order, each of them is streamed in chunks
+  std::deque<PendingObject> objects;
+  // the objects are opened one by one, each of them with the index locked and
+  // only if nothing was replaced or deleted since they were listed
+  std::shared_ptr<UserIndex> index;
+  uint64_t generation = 0;
+  std::shared_ptr<std::istream> currentObject;
+  backup::PullCompactionResponse response;
+
+  bool listObjects();
+  void writeNextChunk();
+  void finish(const grpc::Status &status);
+
+public:
+  PullCompactionReactor(BackupServiceImpl *service, const std::string id)
+      : service(service), id(id) {
+    this->service->storageManager->submit([this]() {
+      if (this->listObjects()) {
+        this->writeNextChunk();
+      }
+    });
+  }
+
+  void OnWriteDone(bool ok) override {
+    if (!ok) {
+      const std::string error =
+          (this->objects.front().type == OBJECT_TYPE::COMPACTION)
+          ? "writer interrupted sending compaction"
+          : "writer interrupted sending logs";
+      Logger::getInstance().error(
+          "PullCompaction failed", {{"user_id", this->id}, {"error", error}});
+      this->finish(grpc::Status(grpc::StatusCode::INTERNAL, error));
+      return;
+    }
+    this->service->storageManager->submit(
+        [this]() { this->writeNextChunk(); });
+  }
+
+  void OnDone() override {
+    delete this;
+  }
+};
+
+void BackupServiceImpl::PullCompactionReactor::finish(
+    const grpc::Status &status) {
+  this->service->pullCompactionMetrics.record(this->start, status.ok());
+  this->Finish(status);
+}
+
+bool BackupServiceImpl::PullCompactionReactor::listObjects() {
+  try {
+    AwsS3Bucket &bucket = *this->service->bucket;
+    this->index = this->service->getUserIndex(this->id);
+    std::unique_lock<std::mutex> indexLock = this->index->lock();
+    this->generation = this->index->getGeneration();
+    const std::string compactionName =
+        this->service->generateObjectName(this->id, OBJECT_TYPE::COMPACTION);
+    // an indexed empty compaction doesn't have to be requested at all
+    const ObjectMetadata compaction =
+        this->index->getObjectMetadata(compactionName);
+    if (!this->index->hasObjectMetadata(compactionName) || compaction.size) {
+      this->objects.push_back(
+          {compactionName, OBJECT_TYPE::COMPACTION, compaction.codec});
+    }
+    SegmentedObject logs(
+        bucket,
+        *this->index,
+        this->service->generateObjectName(
+            this->id, OBJECT_TYPE::TRANSACTION_LOGS));
+    const OBJECT_CODEC logsCodec =
+        this->index
+            ->getObjectMetadata(this->service->generateObjectName(
+                this->id, OBJECT_TYPE::TRANSACTION_LOGS))
+            .codec;
+    for (const std::string &segmentName : logs.getSegmentsNames()) {
+      this->objects.push_back(
+          {segmentName, OBJECT_TYPE::TRANSACTION_LOGS, logsCodec});
+    }
+  } catch (std::exception &e) {
+    Logger::getInstance().error(
+        "PullCompaction failed", {{"user_id", this->id}, {"error", e.what()}});
+    this->finish(grpc::Status(grpc::StatusCode::INTERNAL, e.what()));
+    return false;
+  }
+  return true;
+}
+
+void BackupServiceImpl::PullCompactionReactor::writeNextChunk() {
+  try {
+    AwsS3Bucket &bucket = *this->service->bucket;
+    while (!this->objects.empty()) {
+      if (this->currentObject == nullptr) {
+        std::unique_lock<std::mutex> indexLock = this->index->lock();
+        if (this->index->getGeneration() != this->generation) {
+          indexLock.unlock();
+          const std::string error = "backup replaced during the pull";
+          Logger::getInstance().warning(
+              "PullCompaction aborted",
+              {{"user_id", this->id}, {"error", error}});
+          this->finish(grpc::Status(grpc::StatusCode::ABORTED, error));
+          return;
+        }
+        // an opened object is read to its end even if it gets deleted,
+        // compressed objects are decompressed while being read
+        this->currentObject = decodeStream(
+            bucket.openObjectStream(this->objects.front().name),
+            this->objects.front().codec);
+      }
+      // the chunk is read straight into the response
+      std::string *chunk =
+          (this->objects.front().type == OBJECT_TYPE::COMPACTION)
+          ? this->response.mutable_compactionchunk()
+          : this->response.mutable_logchunk();
+      chunk->resize(GRPC_CHUNK_SIZE_LIMIT);
+      this->currentObject->read((char *)chunk->data(), GRPC_CHUNK_SIZE_LIMIT);
+      chunk->resize(this->currentObject->gcount());
+      if (chunk->size()) {
+        this->service->sentBytes.increment(chunk->size());
+        this->StartWrite(&this->response);
+        return;
+      }
+      this->currentObject = nullptr;
+      this->objects.pop_front();
+    }
+  } catch (std::exception &e) {
+    Logger::getInstance().error(
+        "PullCompaction failed", {{"user_id", this->id}, {"error", e.what()}});
+    this->finish(grpc::Status(grpc::StatusCode::INTERNAL, e.what()));
+    return;
+  }
+  this->finish(grpc::Status::OK);
+}
+
+grpc::ServerReadReactor<backup::ResetKeyRequest> *BackupServiceImpl::ResetKey(
+    grpc::CallbackServerContext *context,
+    google::protobuf::Empty *response) {
+  return new ResetKeyReactor(this, context);
+}
+
+grpc::ServerUnaryReactor *BackupServiceImpl::SendLog(
+    grpc::CallbackServerContext *context,
     const backup::SendLogRequest *request,
     google::protobuf::Empty *response) {
+  const std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  grpc::ServerUnaryReactor *reactor = context->DefaultReactor();
   const std::string id = request->userid();
-  const std::string data = request->data();
+  this->receivedBytes.increment(request->data().size());
 
-  std::cout << "Backup Service => SendLog, id:[" << id << "] data: [" << data
-            << "](this log will be removed)" << std::endl;
-  try {
-    this->storageManager->getBucket(this->bucketName)
-        .appendToObject(
-            this->generateObjectName(id, OBJECT_TYPE::TRANSACTION_LOGS), data);
-  } catch (std::runtime_error &e) {
-    std::cout << "error: " << e.what() << std::endl;
-    return grpc::Status(grpc::StatusCode::INTERNAL, e.what());
+  // every change of the client's database is sent, they're only logged for
+  // debugging
+  Logger &logger = Logger::getInstance();
+  if (logger.isEnabled(LOG_LEVEL::DEBUG)) {
+    logger.debug(
+        "SendLog",
+        {{"user_id", id},
+         {"bytes", request->data().size()},
+         {"data", logger.payload(request->data())}});
   }
-
-  return grpc::Status::OK;
+  this->storageManager->submit([this, id, request, reactor, start]() {
+    try {
+      std::shared_ptr<UserIndex> index = this->getUserIndex(id);
+      std::unique_lock<std::mutex> indexLock = index->lock();
+      SegmentedObject(
+          *this->bucket,
+          *index,
+          this->generateObjectName(id, OBJECT_TYPE::TRANSACTION_LOGS),
+          this->config.codec)
+          .append(request->data());
+    } catch (std::exception &e) {
+      Logger::getInstance().error(
+          "SendLog failed", {{"user_id", id}, {"error", e.what()}});
+      this->sendLogMetrics.record(start, false);
+      reactor->Finish(grpc::Status(grpc::StatusCode::INTERNAL, e.what()));
+      return;
+    }
+    this->sendLogMetrics.record(start, true);
+    reactor->Finish(grpc::Status::OK);
+  });
+  return reactor;
 }
 
-grpc::Status BackupServiceImpl::PullBackupKey(
-    grpc::ServerContext *context,
+grpc::ServerUnaryReactor *BackupServiceImpl::PullBackupKey(
+    grpc::CallbackServerContext *context,
     const backup::PullBackupKeyRequest *request,
     backup::PullBackupKeyResponse *response) {
+  const std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  grpc::ServerUnaryReactor *reactor = context->DefaultReactor();
   const std::string id = request->userid();
   const std::string pakeKey = request->pakekey();
 
-  std::cout << "Backup Service => PullBackupKey, id:[" << id << "] pakeKey: ["
-            << pakeKey << "](this log will be removed)" << std::endl;
+  Logger &logger = Logger::getInstance();
+  logger.info(
+      "PullBackupKey",
+      {{"user_id", id}, {"pake_key", logger.payload(pakeKey)}});
 
   // TODO pake operations - verify user's password with pake's keys
-  try {
-    std::string key = this->storageManager->getBucket(this->bucketName)
-                          .getObjectData(this->generateObjectName(
-                              id, OBJECT_TYPE::ENCRYPTED_BACKUP_KEY));
-    response->set_encryptedbackupkey(key);
-  } catch (std::runtime_error &e) {
-    std::cout << "error: " << e.what() << std::endl;
-    return grpc::Status(grpc::StatusCode::INTERNAL, e.what());
-  }
-
-  return grpc::Status::OK;
+  this->storageManager->submit([this, id, response, reactor, start]() {
+    try {
+      std::string key = this->bucket->getObjectData(
+          this->generateObjectName(id, OBJECT_TYPE::ENCRYPTED_BACKUP_KEY));
+      this->sentBytes.increment(key.size());
+      response->set_encryptedbackupkey(key);
+    } catch (std::exception &e) {
+      Logger::getInstance().error(
+          "PullBackupKey failed", {{"user_id", id}, {"error", e.what()}});
+      this->pullBackupKeyMetrics.record(start, false);
+      reactor->Finish(grpc::Status(grpc::StatusCode::INTERNAL, e.what()));
+      return;
+    }
+    this->pullBackupKeyMetrics.record(start, true);
+    reactor->Finish(grpc::Status::OK);
+  });
+  return reactor;
 }
 
-grpc::Status BackupServiceImpl::PullCompaction(
-    grpc::ServerContext *context,
-    const backup::PullCompactionRequest *request,
-    grpc::ServerWriter<backup::PullCompactionResponse> *writer) {
+grpc::ServerWriteReactor<backup::PullCompactionResponse> *
+BackupServiceImpl::PullCompaction(
+    grpc::CallbackServerContext *context,
+    const backup::PullCompactionRequest *request) {
   const std::string id = request->userid();
 
-  std::cout << "Backup Service => PullCompaction, id:[" << id
-            << "](this log will be removed)" << std::endl;
-  AwsS3Bucket bucket = this->storageManager->getBucket(this->bucketName);
-  try {
-    backup::PullCompactionResponse response;
-    std::function<void(const std::string &)> callback =
-        [&response, &writer](std::string chunk) {
-          response.set_compactionchunk(chunk);
-          if (!writer->Write(response)) {
-            throw std::runtime_error("writer interrupted sending compaction");
-          }
-        };
-
-    bucket.getObjectDataChunks(
-        this->generateObjectName(id, OBJECT_TYPE::COMPACTION),
-        callback,
-        GRPC_CHUNK_SIZE_LIMIT);
-  } catch (std::runtime_error &e) {
-    std::cout << "error: " << e.what() << std::endl;
-    return grpc::Status(grpc::StatusCode::INTERNAL, e.what());
-  }
-  try {
-    backup::PullCompactionResponse response;
-    std::function<void(const std::string &)> callback =
-        [&response, &writer](std::string chunk) {
-          response.set_logchunk(chunk);
-          if (!writer->Write(response)) {
-            throw std::runtime_error("writer interrupted sending logs");
-          }
-        };
-
-    bucket.getObjectDataChunks(
-        this->generateObjectName(id, OBJECT_TYPE::TRANSACTION_LOGS),
-        callback,
-        GRPC_CHUNK_SIZE_LIMIT);
-  } catch (std::runtime_error &e) {
-    std::cout << "error: " << e.what() << std::endl;
-    return grpc::Status(grpc::StatusCode::INTERNAL, e.what());
-  }
-  return grpc::Status::OK;
+  Logger::getInstance().info("PullCompaction", {{"user_id", id}});
+  return new PullCompactionReactor(this, id);
 }
 
 } // namespace network
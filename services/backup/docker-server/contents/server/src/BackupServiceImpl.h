@@ -1,7 +1,10 @@
 #pragma once
 
 #include "AwsStorageManager.h"
+#include "Metrics.h"
+#include "StorageConfig.h"
 #include "Tools.h"
+#include "UserIndex.h"
 
 #include "../_generated/backup.grpc.pb.h"
 #include "../_generated/backup.pb.h"
@@ -10,7 +13,9 @@
 
 #include <grpcpp/grpcpp.h>
 
+#include <list>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -18,35 +23,74 @@
 namespace comm {
 namespace network {
 
-class BackupServiceImpl final : public backup::BackupService::Service {
+/**
+ * The RPCs are served with the callback API, gRPC threads never block on the
+ * storage. Storage operations are submitted to the storage manager's bounded
+ * executor and every stream keeps at most one read/write in flight.
+ */
+class BackupServiceImpl final : public backup::BackupService::CallbackService {
+  class ResetKeyReactor;
+  class PullCompactionReactor;
+
   const std::string bucketName = "commapp-backup";
+  // the codec of newly written objects is taken from here, objects are read
+  // with the codec recorded in the index so it can be changed between restarts
+  const StorageConfig config;
+  Aws::SDKOptions sdkOptions;
 
   std::unique_ptr<AwsStorageManager> storageManager;
+  // owned by the storage manager, shared by all of the calls
+  AwsS3Bucket *bucket = nullptr;
+  struct CachedUserIndex {
+    std::shared_ptr<UserIndex> index;
+    std::list<std::string>::iterator usage;
+  };
+  // indexes are loaded once per user, up to USER_INDEX_CACHE_SIZE of the most
+  // recently used ones are kept
+  std::mutex userIndexesMutex;
+  std::unordered_map<std::string, CachedUserIndex> userIndexes;
+  // the user ids, the most recently used first
+  std::list<std::string> userIndexesUsage;
+  // indexes evicted while they were used by a call, they're cached again if
+  // another call of the user comes before they're released
+  std::unordered_map<std::string, std::weak_ptr<UserIndex>> evictedUserIndexes;
+
+  RpcMetrics resetKeyMetrics;
+  RpcMetrics sendLogMetrics;
+  RpcMetrics pullBackupKeyMetrics;
+  RpcMetrics pullCompactionMetrics;
+  // the payloads of the requests and responses
+  Counter &receivedBytes;
+  Counter &sentBytes;
 
   std::string generateObjectName(
       const std::string &userId,
       const OBJECT_TYPE objectType) const;
+  std::shared_ptr<UserIndex> getUserIndex(const std::string &userId);
+  // called with the indexes' lock held, the cache never exceeds its size
+  std::shared_ptr<UserIndex> findUserIndex(const std::string &userId);
+  void cacheUserIndex(
+      const std::string &userId,
+      std::shared_ptr<UserIndex> index);
 
 public:
-  BackupServiceImpl();
+  BackupServiceImpl(const StorageConfig &config);
   virtual ~BackupServiceImpl();
 
-  grpc::Status ResetKey(
-      grpc::ServerContext *context,
-      grpc::ServerReader<backup::ResetKeyRequest> *reader,
+  grpc::ServerReadReactor<backup::ResetKeyRequest> *ResetKey(
+      grpc::CallbackServerContext *context,
       google::protobuf::Empty *response) override;
-  grpc::Status SendLog(
-      grpc::ServerContext *context,
+  grpc::ServerUnaryReactor *SendLog(
+      grpc::CallbackServerContext *context,
       const backup::SendLogRequest *request,
       google::protobuf::Empty *response) override;
-  grpc::Status PullBackupKey(
-      grpc::ServerContext *context,
+  grpc::ServerUnaryReactor *PullBackupKey(
+      grpc::CallbackServerContext *context,
       const backup::PullBackupKeyRequest *request,
       backup::PullBackupKeyResponse *response) override;
-  grpc::Status PullCompaction(
-      grpc::ServerContext *context,
-      const backup::PullCompactionRequest *request,
-      grpc::ServerWriter<backup::PullCompactionResponse> *writer) override;
+  grpc::ServerWriteReactor<backup::PullCompactionResponse> *PullCompaction(
+      grpc::CallbackServerContext *context,
+      const backup::PullCompactionRequest *request) override;
 };
 
 } // namespace network
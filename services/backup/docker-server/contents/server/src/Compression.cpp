@@ -0,0 +1,134 @@
+#include "Compression.h"
+
+namespace comm {
+namespace network {
+
+std::string compress(const std::string &data) {
+  std::string result;
+  result.resize(ZSTD_compressBound(data.size()));
+  const size_t size = ZSTD_compress(
+      (char *)result.data(),
+      result.size(),
+      data.data(),
+      data.size(),
+      ZSTD_COMPRESSION_LEVEL);
+  if (ZSTD_isError(size)) {
+    throw std::runtime_error(ZSTD_getErrorName(size));
+  }
+  result.resize(size);
+  return result;
+}
+
+ZstdCompressor::ZstdCompressor() : context(ZSTD_createCCtx()) {
+  if (this->context == nullptr) {
+    throw std::runtime_error("zstd compression context not created");
+  }
+  ZSTD_CCtx_setParameter(
+      this->context, ZSTD_c_compressionLevel, ZSTD_COMPRESSION_LEVEL);
+}
+
+ZstdCompressor::~ZstdCompressor() {
+  ZSTD_freeCCtx(this->context);
+}
+
+std::string ZstdCompressor::compressChunk(
+    const std::string &chunk,
+    const ZSTD_EndDirective directive) {
+  std::string result;
+  ZSTD_inBuffer input = {chunk.data(), chunk.size(), 0};
+  std::string outputBuffer;
+  outputBuffer.resize(ZSTD_CStreamOutSize());
+  size_t remaining;
+  do {
+    ZSTD_outBuffer output = {
+        (char *)outputBuffer.data(), outputBuffer.size(), 0};
+    remaining =
+        ZSTD_compressStream2(this->context, &output, &input, directive);
+    if (ZSTD_isError(remaining)) {
+      throw std::runtime_error(ZSTD_getErrorName(remaining));
+    }
+    result.append(outputBuffer.data(), output.pos);
+    // continuing is done once the input is consumed, ending once the frame
+    // is flushed entirely
+  } while ((directive == ZSTD_e_continue) ? input.pos < input.size
+                                           : remaining != 0);
+  return result;
+}
+
+std::string ZstdCompressor::compress(const std::string &chunk) {
+  return this->compressChunk(chunk, ZSTD_e_continue);
+}
+
+std::string ZstdCompressor::finish() {
+  return this->compressChunk("", ZSTD_e_end);
+}
+
+ZstdDecompressingBuffer::ZstdDecompressingBuffer(
+    std::shared_ptr<std::istream> source)
+    : source(source),
+      stream(ZSTD_createDStream()),
+      inputBuffer(ZSTD_DStreamInSize()),
+      outputBuffer(ZSTD_DStreamOutSize()),
+      input({this->inputBuffer.data(), 0, 0}) {
+  if (this->stream == nullptr) {
+    throw std::runtime_error("zstd decompression stream not created");
+  }
+  ZSTD_initDStream(this->stream);
+}
+
+ZstdDecompressingBuffer::~ZstdDecompressingBuffer() {
+  ZSTD_freeDStream(this->stream);
+}
+
+ZstdDecompressingBuffer::int_type ZstdDecompressingBuffer::underflow() {
+  if (this->gptr() < this->egptr()) {
+    return traits_type::to_int_type(*this->gptr());
+  }
+  while (true) {
+    if (this->input.pos == this->input.size) {
+      if (this->sourceFinished) {
+        if (this->lastResult != 0) {
+          throw std::runtime_error("compressed object is truncated");
+        }
+        return traits_type::eof();
+      }
+      this->source->read(this->inputBuffer.data(), this->inputBuffer.size());
+      this->input.size = this->source->gcount();
+      this->input.pos = 0;
+      this->sourceFinished = this->input.size == 0;
+      continue;
+    }
+    ZSTD_outBuffer output = {
+        this->outputBuffer.data(), this->outputBuffer.size(), 0};
+    this->lastResult =
+        ZSTD_decompressStream(this->stream, &output, &this->input);
+    if (ZSTD_isError(this->lastResult)) {
+      throw std::runtime_error(ZSTD_getErrorName(this->lastResult));
+    }
+    if (output.pos) {
+      this->setg(
+          this->outputBuffer.data(),
+          this->outputBuffer.data(),
+          this->outputBuffer.data() + output.pos);
+      return traits_type::to_int_type(*this->gptr());
+    }
+  }
+}
+
+ZstdInputStream::ZstdInputStream(std::shared_ptr<std::istream> source)
+    : std::istream(nullptr), buffer(source) {
+  this->rdbuf(&this->buffer);
+  // errors of the decompression are rethrown instead of only setting badbit
+  this->exceptions(std::ios::badbit);
+}
+
+std::shared_ptr<std::istream>
+decodeStream(std::shared_ptr<std::istream> source, const OBJECT_CODEC codec) {
+  if (codec == OBJECT_CODEC::ZSTD) {
+    return std::make_shared<ZstdInputStream>(source);
+  }
+  return source;
+}
+
+} // namespace network
+} // namespace comm
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "Tools.h"
+
+#include <zstd.h>
+
+#include <istream>
+#include <memory>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace comm {
+namespace network {
+
+std::string compress(const std::string &data);
+
+// compresses a stream of chunks into a single zstd frame
+class ZstdCompressor {
+  ZSTD_CCtx *context;
+
+  std::string
+  compressChunk(const std::string &chunk, const ZSTD_EndDirective directive);
+
+public:
+  ZstdCompressor();
+  ~ZstdCompressor();
+  ZstdCompressor(const ZstdCompressor &) = delete;
+  ZstdCompressor &operator=(const ZstdCompressor &) = delete;
+
+  std::string compress(const std::string &chunk);
+  std::string finish();
+};
+
+// exposes the decompressed content of the source stream, decompression
+// happens while reading so memory use doesn't depend on the object size
+class ZstdDecompressingBuffer : public std::streambuf {
+  std::shared_ptr<std::istream> source;
+  ZSTD_DStream *stream;
+  std::vector<char> inputBuffer;
+  std::vector<char> outputBuffer;
+  ZSTD_inBuffer input;
+  bool sourceFinished = false;
+  size_t lastResult = 0;
+
+protected:
+  int_type underflow() override;
+
+public:
+  ZstdDecompressingBuffer(std::shared_ptr<std::istream> source);
+  ~ZstdDecompressingBuffer();
+  ZstdDecompressingBuffer(const ZstdDecompressingBuffer &) = delete;
+  ZstdDecompressingBuffer &operator=(const ZstdDecompressingBuffer &) = delete;
+};
+
+class ZstdInputStream : public std::istream {
+  ZstdDecompressingBuffer buffer;
+
+public:
+  ZstdInputStream(std::shared_ptr<std::istream> source);
+};
+
+std::shared_ptr<std::istream>
+decodeStream(std::shared_ptr<std::istream> source, const OBJECT_CODEC codec);
+
+} // namespace network
+} // namespace comm
@@ -0,0 +1,409 @@
+#include "LocalStorageEngine.h"
+#include "Tools.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <streambuf>
+
+namespace comm {
+namespace network {
+
+namespace {
+
+std::runtime_error createError(const std::string &operation) {
+  return std::runtime_error(operation + ": " + std::strerror(errno));
+}
+
+// returns the number of bytes read, less than size only at the end of file
+size_t readFully(int fd, char *data, const size_t size, const size_t offset) {
+  size_t done = 0;
+  while (done < size) {
+    const ssize_t result = pread(fd, data + done, size - done, offset + done);
+    if (result < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw createError("pread");
+    }
+    if (result == 0) {
+      break;
+    }
+    done += result;
+  }
+  return done;
+}
+
+void writeFully(int fd, const char *data, const size_t size, size_t offset) {
+  size_t done = 0;
+  while (done < size) {
+    const ssize_t result = pwrite(fd, data + done, size - done, offset + done);
+    if (result < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw createError("pwrite");
+    }
+    done += result;
+  }
+}
+
+// reserves the blocks up front so concurrently written parts don't get
+// fragmented, filesystems without the support just skip it
+void preallocate(int fd, const size_t offset, const size_t size) {
+  if (!size) {
+    return;
+  }
+  const int result = posix_fallocate(fd, offset, size);
+  if (result == ENOSPC) {
+    errno = result;
+    throw createError("posix_fallocate");
+  }
+}
+
+class FileDescriptor {
+  int fd;
+
+public:
+  FileDescriptor(
+      const std::string &path,
+      const int flags,
+      const mode_t mode = 0)
+      : fd(open(path.c_str(), flags | O_CLOEXEC, mode)) {
+    if (this->fd < 0) {
+      throw createError("open " + path);
+    }
+  }
+  explicit FileDescriptor(const int fd) : fd(fd) {
+  }
+  ~FileDescriptor() {
+    if (this->fd >= 0) {
+      close(this->fd);
+    }
+  }
+  FileDescriptor(const FileDescriptor &) = delete;
+  FileDescriptor &operator=(const FileDescriptor &) = delete;
+
+  int get() const {
+    return this->fd;
+  }
+  int release() {
+    const int result = this->fd;
+    this->fd = -1;
+    return result;
+  }
+  size_t getSize() const {
+    struct stat status;
+    if (fstat(this->fd, &status)) {
+      throw createError("fstat");
+    }
+    return status.st_size;
+  }
+};
+
+// reads the file with pread at its own offset, big reads skip the buffer
+class FileReadBuffer : public std::streambuf {
+  FileDescriptor file;
+  std::vector<char> buffer;
+  size_t offset = 0;
+
+protected:
+  int_type underflow() override {
+    if (this->gptr() < this->egptr()) {
+      return traits_type::to_int_type(*this->gptr());
+    }
+    const size_t size = readFully(
+        this->file.get(),
+        this->buffer.data(),
+        this->buffer.size(),
+        this->offset);
+    this->offset += size;
+    if (!size) {
+      return traits_type::eof();
+    }
+    this->setg(
+        this->buffer.data(),
+        this->buffer.data(),
+        this->buffer.data() + size);
+    return traits_type::to_int_type(*this->gptr());
+  }
+
+  std::streamsize xsgetn(char *data, std::streamsize size) override {
+    std::streamsize done = std::min<std::streamsize>(
+        size, this->egptr() - this->gptr());
+    std::memcpy(data, this->gptr(), done);
+    this->gbump(done);
+    if (size - done >= static_cast<std::streamsize>(this->buffer.size())) {
+      const size_t read =
+          readFully(this->file.get(), data + done, size - done, this->offset);
+      this->offset += read;
+      return done + read;
+    }
+    return done + std::streambuf::xsgetn(data + done, size - done);
+  }
+
+public:
+  FileReadBuffer(const std::string &path)
+      : file(path, O_RDONLY), buffer(1 << 16) {
+    posix_fadvise(this->file.get(), 0, 0, POSIX_FADV_SEQUENTIAL);
+  }
+};
+
+class FileInputStream : public std::istream {
+  FileReadBuffer buffer;
+
+public:
+  FileInputStream(const std::string &path)
+      : std::istream(nullptr), buffer(path) {
+    this->rdbuf(&this->buffer);
+    this->exceptions(std::ios::badbit);
+  }
+};
+
+class LocalMultiPartUpload : public MultiPartUpload {
+  std::shared_ptr<LocalStorageEngine> engine;
+  const std::string objectName;
+  std::string temporaryPath;
+  FileDescriptor file;
+
+public:
+  LocalMultiPartUpload(
+      std::shared_ptr<LocalStorageEngine> engine,
+      const std::string objectName)
+      : engine(engine),
+        objectName(objectName),
+        file(engine->createTemporaryFile(objectName, this->temporaryPath)) {
+  }
+
+  ~LocalMultiPartUpload() {
+    if (this->file.get() >= 0) {
+      unlink(this->temporaryPath.c_str());
+    }
+  }
+
+  std::string uploadPart(
+      const std::string &part,
+      const size_t,
+      const size_t offset) override {
+    preallocate(this->file.get(), offset, part.size());
+    writeFully(this->file.get(), part.data(), part.size(), offset);
+    return "";
+  }
+
+  std::string complete(const std::vector<std::string> &) override {
+    this->engine->commitFile(
+        this->file.release(), this->temporaryPath, this->objectName);
+    return "";
+  }
+
+  void abort() override {
+    close(this->file.release());
+    if (unlink(this->temporaryPath.c_str())) {
+      throw createError("unlink " + this->temporaryPath);
+    }
+  }
+};
+
+} // namespace
+
+LocalStorageEngine::LocalStorageEngine(const std::string path, const bool sync)
+    : path(path), sync(sync) {
+  std::filesystem::create_directories(this->path);
+  // the temporary files left by a previous run which didn't get to rename or
+  // remove them, the directory is used by one engine at a time
+  for (const auto &entry : std::filesystem::directory_iterator(this->path)) {
+    const std::string name = entry.path().filename();
+    if (name[0] == '.' && name.size() > 4 &&
+        name.compare(name.size() - 4, 4, ".tmp") == 0) {
+      std::filesystem::remove(entry.path());
+    }
+  }
+}
+
+std::string
+LocalStorageEngine::getObjectPath(const std::string &objectName) const {
+  if (objectName.empty() || objectName[0] == '.' ||
+      objectName.find('/') != std::string::npos) {
+    throw std::runtime_error("invalid object name [" + objectName + "]");
+  }
+  return this->path + "/" + objectName;
+}
+
+// temporary files start with a dot so they're never listed as objects, the
+// random part of the name is unique among the existing files
+int LocalStorageEngine::createTemporaryFile(
+    const std::string &objectName,
+    std::string &temporaryPath) {
+  temporaryPath = this->getObjectPath(objectName);
+  temporaryPath.insert(this->path.size() + 1, ".");
+  temporaryPath += ".XXXXXX.tmp";
+  const int fd = mkostemps((char *)temporaryPath.data(), 4, O_CLOEXEC);
+  if (fd < 0) {
+    throw createError("mkostemps " + temporaryPath);
+  }
+  if (fchmod(fd, 0644)) {
+    const int error = errno;
+    close(fd);
+    unlink(temporaryPath.c_str());
+    errno = error;
+    throw createError("fchmod " + temporaryPath);
+  }
+  return fd;
+}
+
+// concurrent callers share a single fsync of the directory, a sync started
+// after the caller's request covers the caller's rename
+void LocalStorageEngine::syncDirectory() {
+  if (!this->sync) {
+    return;
+  }
+  std::unique_lock<std::mutex> lock(this->directorySyncMutex);
+  const size_t request = ++this->directorySyncsRequested;
+  while (this->directorySyncsCompleted < request) {
+    if (this->directorySyncRunning) {
+      this->directorySyncCondition.wait(lock);
+      continue;
+    }
+    this->directorySyncRunning = true;
+    const size_t covered = this->directorySyncsRequested;
+    lock.unlock();
+    bool synced = false;
+    try {
+      FileDescriptor directory(this->path, O_RDONLY | O_DIRECTORY);
+      synced = fsync(directory.get()) == 0;
+    } catch (std::runtime_error &) {
+    }
+    lock.lock();
+    this->directorySyncRunning = false;
+    this->directorySyncCondition.notify_all();
+    if (!synced) {
+      throw createError("fsync " + this->path);
+    }
+    this->directorySyncsCompleted =
+        std::max(this->directorySyncsCompleted, covered);
+  }
+}
+
+void LocalStorageEngine::commitFile(
+    int fd,
+    const std::string &temporaryPath,
+    const std::string &objectName) {
+  const bool synced = !this->sync || fdatasync(fd) == 0;
+  const int syncError = errno;
+  close(fd);
+  if (!synced) {
+    unlink(temporaryPath.c_str());
+    errno = syncError;
+    throw createError("fdatasync " + temporaryPath);
+  }
+  if (rename(temporaryPath.c_str(), this->getObjectPath(objectName).c_str())) {
+    const std::runtime_error error = createError("rename " + temporaryPath);
+    unlink(temporaryPath.c_str());
+    throw error;
+  }
+  this->syncDirectory();
+}
+
+std::vector<std::string> LocalStorageEngine::listObjects() {
+  std::vector<std::string> result;
+  for (const auto &entry : std::filesystem::directory_iterator(this->path)) {
+    const std::string name = entry.path().filename();
+    if (name[0] != '.') {
+      result.push_back(name);
+    }
+  }
+  return result;
+}
+
+bool LocalStorageEngine::isAvailable() {
+  return std::filesystem::is_directory(this->path);
+}
+
+bool LocalStorageEngine::objectExists(const std::string &objectName) {
+  struct stat status;
+  if (stat(this->getObjectPath(objectName).c_str(), &status) == 0) {
+    return true;
+  }
+  if (errno == ENOENT) {
+    return false;
+  }
+  throw createError("stat " + objectName);
+}
+
+size_t LocalStorageEngine::getObjectSize(const std::string &objectName) {
+  struct stat status;
+  if (stat(this->getObjectPath(objectName).c_str(), &status)) {
+    throw createError("stat " + objectName);
+  }
+  return status.st_size;
+}
+
+void LocalStorageEngine::renameObject(
+    const std::string &currentName,
+    const std::string &newName) {
+  if (rename(
+          this->getObjectPath(currentName).c_str(),
+          this->getObjectPath(newName).c_str())) {
+    throw createError("rename " + currentName);
+  }
+  this->syncDirectory();
+}
+
+std::string LocalStorageEngine::writeObject(
+    const std::string &objectName,
+    const std::string &data) {
+  std::string temporaryPath;
+  FileDescriptor file(this->createTemporaryFile(objectName, temporaryPath));
+  try {
+    preallocate(file.get(), 0, data.size());
+    writeFully(file.get(), data.data(), data.size(), 0);
+  } catch (std::runtime_error &) {
+    unlink(temporaryPath.c_str());
+    throw;
+  }
+  this->commitFile(file.release(), temporaryPath, objectName);
+  return "";
+}
+
+std::string LocalStorageEngine::getObjectData(const std::string &objectName) {
+  FileDescriptor file(this->getObjectPath(objectName), O_RDONLY);
+  const size_t size = file.getSize();
+  if (size > GRPC_CHUNK_SIZE_LIMIT) {
+    throw invalid_argument_error(std::string(
+        "The file is too big(" + std::to_string(size) + " bytes, max is " +
+        std::to_string(GRPC_CHUNK_SIZE_LIMIT) +
+        "bytes), please, use getObjectDataChunks"));
+  }
+  std::string result;
+  result.resize(size);
+  result.resize(readFully(file.get(), (char *)result.data(), size, 0));
+  return result;
+}
+
+std::shared_ptr<std::istream>
+LocalStorageEngine::openObjectStream(const std::string &objectName) {
+  return std::make_shared<FileInputStream>(this->getObjectPath(objectName));
+}
+
+std::unique_ptr<MultiPartUpload>
+LocalStorageEngine::startMultiPartUpload(const std::string &objectName) {
+  // validates the name before anything is created
+  this->getObjectPath(objectName);
+  return std::make_unique<LocalMultiPartUpload>(
+      this->shared_from_this(), objectName);
+}
+
+void LocalStorageEngine::deleteObject(const std::string &objectName) {
+  if (unlink(this->getObjectPath(objectName).c_str()) && errno != ENOENT) {
+    throw createError("unlink " + objectName);
+  }
+  this->syncDirectory();
+}
+
+} // namespace network
+} // namespace comm
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "StorageEngine.h"
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace comm {
+namespace network {
+
+/**
+ * Stores every object as a file in one directory. Objects are written to a
+ * temporary file which is synced and renamed over the object so readers
+ * never see a partial object. Multipart uploads write their parts with
+ * pwrite into one preallocated file at the parts' final offsets and sync it
+ * once when completed. The directory syncs after renames are batched between
+ * concurrent writers.
+ */
+class LocalStorageEngine
+    : public StorageEngine,
+      public std::enable_shared_from_this<LocalStorageEngine> {
+  const std::string path;
+  // syncing can be disabled where durability doesn't matter (tests, dev)
+  const bool sync;
+
+  std::mutex directorySyncMutex;
+  std::condition_variable directorySyncCondition;
+  size_t directorySyncsRequested = 0;
+  size_t directorySyncsCompleted = 0;
+  bool directorySyncRunning = false;
+
+  void syncDirectory();
+
+public:
+  LocalStorageEngine(const std::string path, const bool sync = true);
+
+  std::string getObjectPath(const std::string &objectName) const;
+  // returns the descriptor of a new file next to the object, its path is set
+  // to `temporaryPath`
+  int createTemporaryFile(
+      const std::string &objectName,
+      std::string &temporaryPath);
+  // syncs and closes the file, then moves it in place of the object
+  void commitFile(
+      int fd,
+      const std::string &temporaryPath,
+      const std::string &objectName);
+
+  std::vector<std::string> listObjects() override;
+  bool isAvailable() override;
+  bool objectExists(const std::string &objectName) override;
+  size_t getObjectSize(const std::string &objectName) override;
+  void renameObject(const std::string &currentName, const std::string &newName)
+      override;
+  std::string
+  writeObject(const std::string &objectName, const std::string &data) override;
+  std::string getObjectData(const std::string &objectName) override;
+  std::shared_ptr<std::istream>
+  openObjectStream(const std::string &objectName) override;
+  std::unique_ptr<MultiPartUpload>
+  startMultiPartUpload(const std::string &objectName) override;
+  void deleteObject(const std::string &objectName) override;
+};
+
+} // namespace network
+} // namespace comm
@@ -1,81 +1,115 @@
+#include "Metrics.h"
 #include "MultiPartUploader.h"
 #include "Tools.h"
 
-#include <aws/core/utils/HashingUtils.h>
-#include <aws/s3/model/CreateMultipartUploadRequest.h>
-#include <aws/s3/model/GetObjectRequest.h>
-#include <aws/s3/model/Object.h>
-#include <aws/s3/model/UploadPartRequest.h>
-
-#include <boost/interprocess/streams/bufferstream.hpp>
-
 namespace comm {
 namespace network {
 
-MultiPartUploader::MultiPartUploader(
-    std::shared_ptr<Aws::S3::S3Client> client,
-    const std::string bucketName,
-    const std::string objectName)
-    : client(client), bucketName(bucketName), objectName(objectName) {
-  this->completeMultipartUploadRequest.SetBucket(this->bucketName);
-  this->completeMultipartUploadRequest.SetKey(this->objectName);
-
-  Aws::S3::Model::CreateMultipartUploadRequest createRequest;
-  createRequest.SetBucket(this->bucketName);
-  createRequest.SetKey(this->objectName);
-  createRequest.SetContentType("text/plain");
+namespace {
 
-  Aws::S3::Model::CreateMultipartUploadOutcome createOutcome =
-      this->client->CreateMultipartUpload(createRequest);
-
-  if (!createOutcome.IsSuccess()) {
-    throw std::runtime_error(createOutcome.GetError().GetMessage());
-  }
-  this->uploadId = createOutcome.GetResult().GetUploadId();
-  this->completeMultipartUploadRequest.SetUploadId(this->uploadId);
+Gauge &getPartsInFlight() {
+  static Gauge &partsInFlight = MetricsRegistry::getInstance().getGauge(
+      "backup_parts_in_flight",
+      "The multipart upload parts being uploaded.");
+  return partsInFlight;
 }
 
-void MultiPartUploader::addPart(const std::string &part) {
-  Aws::S3::Model::UploadPartRequest uploadRequest;
-  uploadRequest.SetBucket(this->bucketName);
-  uploadRequest.SetKey(this->objectName);
-  uploadRequest.SetPartNumber(this->partNumber);
-  uploadRequest.SetUploadId(this->uploadId);
+// counts the part as in flight until its upload returns or throws
+struct PartInFlight {
+  PartInFlight() {
+    getPartsInFlight().add(1);
+  }
+  ~PartInFlight() {
+    getPartsInFlight().add(-1);
+  }
+};
 
-  std::shared_ptr<Aws::IOStream> body = std::shared_ptr<Aws::IOStream>(
-      new boost::interprocess::bufferstream((char *)part.data(), part.size()));
+} // namespace
 
-  uploadRequest.SetBody(body);
+MultiPartUploader::MultiPartUploader(
+    std::unique_ptr<MultiPartUpload> upload,
+    const size_t parallelUploads,
+    TaskSubmitter submit)
+    : upload(std::move(upload)),
+      parallelUploads(parallelUploads),
+      submit(std::move(submit)) {
+}
 
-  Aws::Utils::ByteBuffer partMd5(Aws::Utils::HashingUtils::CalculateMD5(*body));
-  uploadRequest.SetContentMD5(Aws::Utils::HashingUtils::Base64Encode(partMd5));
+void MultiPartUploader::startPartUpload(std::string part, const bool last) {
+  // S3 would only reject the parts when the upload gets completed
+  if (!last && part.size() < AWS_MULTIPART_UPLOAD_MINIMUM_CHUNK_SIZE) {
+    throw invalid_argument_error("too small part detected");
+  }
+  if (part.size() > AWS_MULTIPART_UPLOAD_MAXIMUM_CHUNK_SIZE) {
+    throw invalid_argument_error("too big part detected");
+  }
+  if (this->uploads.size() >= this->parallelUploads) {
+    this->collectOldestUpload();
+  }
+  const size_t partNumber = this->partNumber++;
+  const size_t offset = this->offset;
+  this->offset += part.size();
+  this->partsSizes.push_back(part.size());
+  this->uploads.emplace_back(
+      this->submit, [this, part = std::move(part), partNumber, offset]() {
+        // failed requests are retried by the client, the part is never
+        // retried here so no executor thread sleeps between the attempts
+        PartInFlight inFlight;
+        return this->upload->uploadPart(part, partNumber, offset);
+      });
+}
 
-  uploadRequest.SetContentLength(part.size());
+void MultiPartUploader::collectOldestUpload() {
+  StorageTask<std::string> upload = std::move(this->uploads.front());
+  this->uploads.pop_front();
+  this->partsETags.push_back(upload.get());
+}
 
-  Aws::S3::Model::UploadPartOutcome uploadPartOutcome =
-      this->client->UploadPart(uploadRequest);
-  Aws::S3::Model::CompletedPart completedPart;
-  completedPart.SetPartNumber(this->partNumber);
-  std::string eTag = uploadPartOutcome.GetResult().GetETag();
-  if (eTag.empty()) {
-    throw std::runtime_error("etag empty");
+void MultiPartUploader::flushPendingData() {
+  if (this->pendingData.empty()) {
+    return;
   }
-  completedPart.SetETag(eTag);
-  completedMultipartUpload.AddParts(completedPart);
-  ++this->partNumber;
+  this->startPartUpload(std::move(this->pendingData), false);
+  this->pendingData.clear();
 }
 
-void MultiPartUploader::finishUpload() {
-  this->completeMultipartUploadRequest.SetMultipartUpload(
-      this->completedMultipartUpload);
+void MultiPartUploader::waitForUploads() {
+  while (!this->uploads.empty()) {
+    try {
+      this->collectOldestUpload();
+    } catch (std::runtime_error &) {
+      // the upload is being dropped, its parts don't matter anymore
+    }
+  }
+}
 
-  Aws::S3::Model::CompleteMultipartUploadOutcome completeUploadOutcome =
-      this->client->CompleteMultipartUpload(
-          this->completeMultipartUploadRequest);
+void MultiPartUploader::addPart(const std::string &part) {
+  this->pendingData += part;
+  if (this->pendingData.size() >= AWS_MULTIPART_UPLOAD_MINIMUM_CHUNK_SIZE) {
+    this->flushPendingData();
+  }
+}
 
-  if (!completeUploadOutcome.IsSuccess()) {
-    throw std::runtime_error(completeUploadOutcome.GetError().GetMessage());
+ObjectMetadata MultiPartUploader::finishUpload() {
+  // an upload needs at least one part even if the object is empty
+  if (!this->pendingData.empty() || this->partNumber == 1) {
+    this->startPartUpload(std::move(this->pendingData), true);
+    this->pendingData.clear();
+  }
+  while (!this->uploads.empty()) {
+    this->collectOldestUpload();
   }
+  ObjectMetadata metadata;
+  metadata.eTag = this->upload->complete(this->partsETags);
+  for (const size_t partSize : this->partsSizes) {
+    metadata.size += partSize;
+  }
+  return metadata;
+}
+
+void MultiPartUploader::abortUpload() {
+  this->waitForUploads();
+  this->upload->abort();
 }
 
 } // namespace network
@@ -1,35 +1,54 @@
 #pragma once
 
-#include <aws/core/Aws.h>
-#include <aws/s3/S3Client.h>
-#include <aws/s3/model/CompleteMultipartUploadRequest.h>
+#include "ObjectMetadata.h"
+#include "StorageEngine.h"
+#include "StorageTask.h"
+#include "Tools.h"
 
+#include <deque>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace comm {
 namespace network {
 
+/**
+ * Data passed to addPart is buffered until it reaches the minimum part size,
+ * full parts are uploaded concurrently on the storage executor (at most
+ * parallelUploads at once) and collected in their original order when the
+ * upload gets finished. The rules
+ * of S3 multipart uploads are checked before a part is submitted so every
+ * engine enforces them.
+ */
 class MultiPartUploader {
-  std::shared_ptr<Aws::S3::S3Client> client;
-  const std::string bucketName;
-  const std::string objectName;
-  size_t partCounter = 0;
+  std::unique_ptr<MultiPartUpload> upload;
+  const size_t parallelUploads;
+  const TaskSubmitter submit;
   std::vector<size_t> partsSizes;
-
-  Aws::S3::Model::CompleteMultipartUploadRequest completeMultipartUploadRequest;
-  Aws::S3::Model::CompletedMultipartUpload completedMultipartUpload;
-  std::string uploadId;
+  std::vector<std::string> partsETags;
 
   size_t partNumber = 1;
+  // offset of the next part in the final object
+  size_t offset = 0;
+  std::string pendingData;
+  // uploads in flight, the oldest part first
+  std::deque<StorageTask<std::string>> uploads;
+
+  // only the last part may be smaller than the minimum part size
+  void startPartUpload(std::string part, const bool last);
+  void collectOldestUpload();
+  void flushPendingData();
+  void waitForUploads();
 
 public:
   MultiPartUploader(
-      std::shared_ptr<Aws::S3::S3Client> client,
-      const std::string bucketName,
-      const std::string objectName);
+      std::unique_ptr<MultiPartUpload> upload,
+      const size_t parallelUploads = AWS_PARALLEL_UPLOADS,
+      TaskSubmitter submit = nullptr);
   void addPart(const std::string &part);
-  void finishUpload();
+  ObjectMetadata finishUpload();
+  void abortUpload();
 };
 
 } // namespace network
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Tools.h"
+
+#include <string>
+
+namespace comm {
+namespace network {
+
+struct ObjectMetadata {
+  // number of stored bytes, after compression for compressed objects
+  size_t size = 0;
+  // empty for segmented objects, every segment has its own
+  std::string eTag;
+  // the segments are numbered from `firstSegment`, the numbers of a cleared
+  // object's segments aren't used again
+  size_t firstSegment = 0;
+  size_t segmentsCount = 0;
+  OBJECT_CODEC codec = OBJECT_CODEC::NONE;
+};
+
+} // namespace network
+} // namespace comm
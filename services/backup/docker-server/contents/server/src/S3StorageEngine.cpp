@@ -0,0 +1,289 @@
+#include "S3StorageEngine.h"
+#include "Tools.h"
+
+#include <aws/core/utils/HashingUtils.h>
+#include <aws/s3/model/AbortMultipartUploadRequest.h>
+#include <aws/s3/model/CompleteMultipartUploadRequest.h>
+#include <aws/s3/model/CopyObjectRequest.h>
+#include <aws/s3/model/CreateMultipartUploadRequest.h>
+#include <aws/s3/model/DeleteObjectRequest.h>
+#include <aws/s3/model/GetObjectRequest.h>
+#include <aws/s3/model/HeadBucketRequest.h>
+#include <aws/s3/model/HeadObjectRequest.h>
+#include <aws/s3/model/ListObjectsRequest.h>
+#include <aws/s3/model/Object.h>
+#include <aws/s3/model/PutObjectRequest.h>
+#include <aws/s3/model/UploadPartRequest.h>
+
+#include <boost/interprocess/streams/bufferstream.hpp>
+
+namespace comm {
+namespace network {
+
+namespace {
+
+class S3MultiPartUpload : public MultiPartUpload {
+  std::shared_ptr<Aws::S3::S3Client> client;
+  const std::string bucketName;
+  const std::string objectName;
+  std::string uploadId;
+
+public:
+  S3MultiPartUpload(
+      std::shared_ptr<Aws::S3::S3Client> client,
+      const std::string bucketName,
+      const std::string objectName)
+      : client(client), bucketName(bucketName), objectName(objectName) {
+    Aws::S3::Model::CreateMultipartUploadRequest createRequest;
+    createRequest.SetBucket(this->bucketName);
+    createRequest.SetKey(this->objectName);
+    createRequest.SetContentType("text/plain");
+
+    Aws::S3::Model::CreateMultipartUploadOutcome createOutcome =
+        this->client->CreateMultipartUpload(createRequest);
+
+    if (!createOutcome.IsSuccess()) {
+      throw std::runtime_error(createOutcome.GetError().GetMessage());
+    }
+    this->uploadId = createOutcome.GetResult().GetUploadId();
+  }
+
+  std::string uploadPart(
+      const std::string &part,
+      const size_t partNumber,
+      const size_t offset) override {
+    Aws::S3::Model::UploadPartRequest uploadRequest;
+    uploadRequest.SetBucket(this->bucketName);
+    uploadRequest.SetKey(this->objectName);
+    uploadRequest.SetPartNumber(partNumber);
+    uploadRequest.SetUploadId(this->uploadId);
+
+    std::shared_ptr<Aws::IOStream> body =
+        std::shared_ptr<Aws::IOStream>(new boost::interprocess::bufferstream(
+            (char *)part.data(), part.size()));
+
+    uploadRequest.SetBody(body);
+
+    Aws::Utils::ByteBuffer partMd5(
+        Aws::Utils::HashingUtils::CalculateMD5(*body));
+    uploadRequest.SetContentMD5(
+        Aws::Utils::HashingUtils::Base64Encode(partMd5));
+
+    uploadRequest.SetContentLength(part.size());
+
+    Aws::S3::Model::UploadPartOutcome uploadPartOutcome =
+        this->client->UploadPart(uploadRequest);
+    if (!uploadPartOutcome.IsSuccess()) {
+      throw std::runtime_error(uploadPartOutcome.GetError().GetMessage());
+    }
+    std::string eTag = uploadPartOutcome.GetResult().GetETag();
+    if (eTag.empty()) {
+      throw std::runtime_error("etag empty");
+    }
+    return eTag;
+  }
+
+  std::string complete(const std::vector<std::string> &partsETags) override {
+    Aws::S3::Model::CompletedMultipartUpload completedMultipartUpload;
+    for (size_t i = 0; i < partsETags.size(); ++i) {
+      Aws::S3::Model::CompletedPart completedPart;
+      completedPart.SetPartNumber(i + 1);
+      completedPart.SetETag(partsETags[i]);
+      completedMultipartUpload.AddParts(completedPart);
+    }
+    Aws::S3::Model::CompleteMultipartUploadRequest completeRequest;
+    completeRequest.SetBucket(this->bucketName);
+    completeRequest.SetKey(this->objectName);
+    completeRequest.SetUploadId(this->uploadId);
+    completeRequest.SetMultipartUpload(completedMultipartUpload);
+
+    Aws::S3::Model::CompleteMultipartUploadOutcome completeUploadOutcome =
+        this->client->CompleteMultipartUpload(completeRequest);
+
+    if (!completeUploadOutcome.IsSuccess()) {
+      throw std::runtime_error(completeUploadOutcome.GetError().GetMessage());
+    }
+    return completeUploadOutcome.GetResult().GetETag();
+  }
+
+  void abort() override {
+    Aws::S3::Model::AbortMultipartUploadRequest abortRequest;
+    abortRequest.SetBucket(this->bucketName);
+    abortRequest.SetKey(this->objectName);
+    abortRequest.SetUploadId(this->uploadId);
+
+    Aws::S3::Model::AbortMultipartUploadOutcome abortOutcome =
+        this->client->AbortMultipartUpload(abortRequest);
+    if (!abortOutcome.IsSuccess()) {
+      throw std::runtime_error(abortOutcome.GetError().GetMessage());
+    }
+  }
+};
+
+} // namespace
+
+S3StorageEngine::S3StorageEngine(
+    std::shared_ptr<Aws::S3::S3Client> client,
+    const std::string bucketName)
+    : bucketName(bucketName), client(client) {
+}
+
+std::vector<std::string> S3StorageEngine::listObjects() {
+  Aws::S3::Model::ListObjectsRequest request;
+  request.SetBucket(this->bucketName);
+  std::vector<std::string> result;
+
+  Aws::S3::Model::ListObjectsOutcome outcome =
+      this->client->ListObjects(request);
+  if (!outcome.IsSuccess()) {
+    throw std::runtime_error(outcome.GetError().GetMessage());
+  }
+  Aws::Vector<Aws::S3::Model::Object> objects =
+      outcome.GetResult().GetContents();
+  for (Aws::S3::Model::Object &object : objects) {
+    result.push_back(object.GetKey());
+  }
+  return result;
+}
+
+bool S3StorageEngine::isAvailable() {
+  Aws::S3::Model::HeadBucketRequest headRequest;
+  headRequest.SetBucket(this->bucketName);
+  Aws::S3::Model::HeadBucketOutcome outcome =
+      this->client->HeadBucket(headRequest);
+  return outcome.IsSuccess();
+}
+
+bool S3StorageEngine::objectExists(const std::string &objectName) {
+  Aws::S3::Model::HeadObjectRequest headRequest;
+  headRequest.SetBucket(this->bucketName);
+  headRequest.SetKey(objectName);
+  Aws::S3::Model::HeadObjectOutcome headOutcome =
+      this->client->HeadObject(headRequest);
+  if (headOutcome.IsSuccess()) {
+    return true;
+  }
+  if (headOutcome.GetError().GetResponseCode() ==
+      Aws::Http::HttpResponseCode::NOT_FOUND) {
+    return false;
+  }
+  throw std::runtime_error(headOutcome.GetError().GetMessage());
+}
+
+size_t S3StorageEngine::getObjectSize(const std::string &objectName) {
+  Aws::S3::Model::HeadObjectRequest headRequest;
+  headRequest.SetBucket(this->bucketName);
+  headRequest.SetKey(objectName);
+  Aws::S3::Model::HeadObjectOutcome headOutcome =
+      this->client->HeadObject(headRequest);
+  if (!headOutcome.IsSuccess()) {
+    throw std::runtime_error(headOutcome.GetError().GetMessage());
+  }
+  return headOutcome.GetResultWithOwnership().GetContentLength();
+}
+
+void S3StorageEngine::renameObject(
+    const std::string &currentName,
+    const std::string &newName) {
+  Aws::S3::Model::CopyObjectRequest copyRequest;
+  copyRequest.SetCopySource(this->bucketName + "/" + currentName);
+  copyRequest.SetKey(newName);
+  copyRequest.SetBucket(this->bucketName);
+
+  Aws::S3::Model::CopyObjectOutcome copyOutcome =
+      this->client->CopyObject(copyRequest);
+  if (!copyOutcome.IsSuccess()) {
+    throw std::runtime_error(copyOutcome.GetError().GetMessage());
+  }
+
+  this->deleteObject(currentName);
+}
+
+std::string S3StorageEngine::writeObject(
+    const std::string &objectName,
+    const std::string &data) {
+  // we don't have to handle multiple write here because the GRPC limit is 4MB
+  // and minimum size of data to perform multipart upload is 5MB
+  Aws::S3::Model::PutObjectRequest request;
+  request.SetBucket(this->bucketName);
+  request.SetKey(objectName);
+
+  std::shared_ptr<Aws::IOStream> body = std::shared_ptr<Aws::IOStream>(
+      new boost::interprocess::bufferstream((char *)data.data(), data.size()));
+
+  request.SetBody(body);
+
+  Aws::S3::Model::PutObjectOutcome outcome = this->client->PutObject(request);
+
+  if (!outcome.IsSuccess()) {
+    throw std::runtime_error(outcome.GetError().GetMessage());
+  }
+  return outcome.GetResult().GetETag();
+}
+
+std::string S3StorageEngine::getObjectData(const std::string &objectName) {
+  Aws::S3::Model::GetObjectRequest request;
+  request.SetBucket(this->bucketName);
+  request.SetKey(objectName);
+
+  Aws::S3::Model::GetObjectOutcome outcome = this->client->GetObject(request);
+
+  if (!outcome.IsSuccess()) {
+    throw std::runtime_error(outcome.GetError().GetMessage());
+  }
+
+  // the size comes with the response, no HeadObject needed
+  const size_t size = outcome.GetResult().GetContentLength();
+  if (size > GRPC_CHUNK_SIZE_LIMIT) {
+    throw invalid_argument_error(std::string(
+        "The file is too big(" + std::to_string(size) + " bytes, max is " +
+        std::to_string(GRPC_CHUNK_SIZE_LIMIT) +
+        "bytes), please, use getObjectDataChunks"));
+  }
+  Aws::IOStream &retrievedFile = outcome.GetResultWithOwnership().GetBody();
+
+  std::string result;
+  result.resize(size);
+  retrievedFile.read((char *)result.data(), size);
+
+  return result;
+}
+
+std::shared_ptr<std::istream>
+S3StorageEngine::openObjectStream(const std::string &objectName) {
+  Aws::S3::Model::GetObjectRequest request;
+  request.SetBucket(this->bucketName);
+  request.SetKey(objectName);
+
+  Aws::S3::Model::GetObjectOutcome outcome = this->client->GetObject(request);
+  if (!outcome.IsSuccess()) {
+    throw std::runtime_error(outcome.GetError().GetMessage());
+  }
+  // the body is owned by the result, the returned pointer keeps it alive
+  std::shared_ptr<Aws::S3::Model::GetObjectResult> result =
+      std::make_shared<Aws::S3::Model::GetObjectResult>(
+          outcome.GetResultWithOwnership());
+  return std::shared_ptr<std::istream>(result, &result->GetBody());
+}
+
+std::unique_ptr<MultiPartUpload>
+S3StorageEngine::startMultiPartUpload(const std::string &objectName) {
+  return std::make_unique<S3MultiPartUpload>(
+      this->client, this->bucketName, objectName);
+}
+
+void S3StorageEngine::deleteObject(const std::string &objectName) {
+  Aws::S3::Model::DeleteObjectRequest deleteRequest;
+
+  deleteRequest.SetKey(objectName);
+  deleteRequest.SetBucket(this->bucketName);
+
+  Aws::S3::Model::DeleteObjectOutcome deleteOutcome =
+      this->client->DeleteObject(deleteRequest);
+  if (!deleteOutcome.IsSuccess()) {
+    throw std::runtime_error(deleteOutcome.GetError().GetMessage());
+  }
+}
+
+} // namespace network
+} // namespace comm
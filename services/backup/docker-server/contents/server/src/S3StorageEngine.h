@@ -0,0 +1,41 @@
+#pragma once
+
+#include "StorageEngine.h"
+
+#include <aws/core/Aws.h>
+#include <aws/s3/S3Client.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace comm {
+namespace network {
+
+class S3StorageEngine : public StorageEngine {
+  const std::string bucketName;
+  std::shared_ptr<Aws::S3::S3Client> client;
+
+public:
+  S3StorageEngine(
+      std::shared_ptr<Aws::S3::S3Client> client,
+      const std::string bucketName);
+
+  std::vector<std::string> listObjects() override;
+  bool isAvailable() override;
+  bool objectExists(const std::string &objectName) override;
+  size_t getObjectSize(const std::string &objectName) override;
+  void renameObject(const std::string &currentName, const std::string &newName)
+      override;
+  std::string
+  writeObject(const std::string &objectName, const std::string &data) override;
+  std::string getObjectData(const std::string &objectName) override;
+  std::shared_ptr<std::istream>
+  openObjectStream(const std::string &objectName) override;
+  std::unique_ptr<MultiPartUpload>
+  startMultiPartUpload(const std::string &objectName) override;
+  void deleteObject(const std::string &objectName) override;
+};
+
+} // namespace network
+} // namespace comm
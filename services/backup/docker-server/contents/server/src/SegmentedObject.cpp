@@ -0,0 +1,105 @@
+#include "SegmentedObject.h"
+#include "Compression.h"
+
+namespace comm {
+namespace network {
+
+SegmentedObject::SegmentedObject(
+    AwsS3Bucket bucket,
+    UserIndex &index,
+    const std::string objectName,
+    const OBJECT_CODEC codec)
+    : bucket(bucket), index(index), objectName(objectName), codec(codec) {
+}
+
+std::string SegmentedObject::getSegmentName(const size_t index) const {
+  return this->objectName + "-" + std::to_string(index);
+}
+
+void SegmentedObject::recover() {
+  if (this->index.isRecovered(this->objectName)) {
+    return;
+  }
+  // the first segment is always indexed, without it the codec isn't known
+  if (this->index.hasObjectMetadata(this->objectName)) {
+    ObjectMetadata metadata = this->index.getObjectMetadata(this->objectName);
+    const size_t indexedSegmentsCount = metadata.segmentsCount;
+    std::string segmentName = this->getSegmentName(
+        metadata.firstSegment + metadata.segmentsCount);
+    while (this->bucket.objectExists(segmentName)) {
+      metadata.size += this->bucket.getObjectSize(segmentName);
+      ++metadata.segmentsCount;
+      segmentName = this->getSegmentName(
+          metadata.firstSegment + metadata.segmentsCount);
+    }
+    if (metadata.segmentsCount != indexedSegmentsCount) {
+      this->index.setRecoverableObjectMetadata(this->objectName, metadata);
+    }
+  }
+  this->index.setRecovered(this->objectName);
+}
+
+std::vector<std::string> SegmentedObject::getSegmentsNames() {
+  this->recover();
+  const ObjectMetadata metadata =
+      this->index.getObjectMetadata(this->objectName);
+  std::vector<std::string> result;
+  result.reserve(metadata.segmentsCount);
+  for (size_t i = 0; i < metadata.segmentsCount; ++i) {
+    result.push_back(this->getSegmentName(metadata.firstSegment + i));
+  }
+  return result;
+}
+
+void SegmentedObject::append(const std::string &data) {
+  if (data.empty()) {
+    return;
+  }
+  this->recover();
+  ObjectMetadata metadata = this->index.getObjectMetadata(this->objectName);
+  if (!metadata.segmentsCount) {
+    metadata.codec = this->codec;
+  }
+  const std::string segment =
+      (metadata.codec == OBJECT_CODEC::ZSTD) ? compress(data) : data;
+  const std::string segmentName =
+      this->getSegmentName(metadata.firstSegment + metadata.segmentsCount);
+  this->bucket.writeObject(segmentName, segment);
+  metadata.size += segment.size();
+  ++metadata.segmentsCount;
+  // the segments written between the checkpoints are found by `recover` once
+  // the index is loaded again
+  if ((metadata.segmentsCount - 1) % USER_INDEX_CHECKPOINT_INTERVAL) {
+    this->index.setRecoverableObjectMetadata(this->objectName, metadata);
+    return;
+  }
+  this->index.setObjectMetadata(this->objectName, metadata);
+  try {
+    this->index.store();
+  } catch (std::runtime_error &) {
+    // the append failed, its segment mustn't be recovered later, if it can't
+    // be deleted it's going to be overwritten by the next append
+    try {
+      this->bucket.deleteObject(segmentName);
+    } catch (std::runtime_error &) {
+    }
+    throw;
+  }
+}
+
+void SegmentedObject::clear() {
+  const std::vector<std::string> segmentsNames = this->getSegmentsNames();
+  ObjectMetadata metadata;
+  metadata.firstSegment =
+      this->index.getObjectMetadata(this->objectName).firstSegment +
+      segmentsNames.size();
+  this->index.nextGeneration();
+  this->index.setObjectMetadata(this->objectName, metadata);
+  this->index.store();
+  for (const std::string &segmentName : segmentsNames) {
+    this->bucket.deleteObject(segmentName);
+  }
+}
+
+} // namespace network
+} // namespace comm
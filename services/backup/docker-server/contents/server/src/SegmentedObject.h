@@ -0,0 +1,44 @@
+#pragma once
+
+#include "AwsS3Bucket.h"
+#include "UserIndex.h"
+
+#include <string>
+#include <vector>
+
+namespace comm {
+namespace network {
+
+/**
+ * An append-only object stored as numbered segments, the numbers of the
+ * segments and their total size are kept in the user's index. Appending
+ * writes only the new bytes as the next segment, reading streams the segments
+ * in order. The index is only stored on every USER_INDEX_CHECKPOINT_INTERVAL
+ * appends, the segments written since then are looked up the first time the
+ * object is used after the index is loaded. The caller holds the index lock
+ * while using it. The codec is chosen by the first append, every segment is
+ * then compressed on its own with it.
+ */
+class SegmentedObject {
+  AwsS3Bucket bucket;
+  UserIndex &index;
+  const std::string objectName;
+  const OBJECT_CODEC codec;
+
+  std::string getSegmentName(const size_t index) const;
+  void recover();
+
+public:
+  SegmentedObject(
+      AwsS3Bucket bucket,
+      UserIndex &index,
+      const std::string objectName,
+      const OBJECT_CODEC codec = OBJECT_CODEC::NONE);
+
+  std::vector<std::string> getSegmentsNames();
+  void append(const std::string &data);
+  void clear();
+};
+
+} // namespace network
+} // namespace comm
@@ -0,0 +1,115 @@
+#include "StorageConfig.h"
+
+#include <boost/program_options.hpp>
+
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+
+namespace comm {
+namespace network {
+
+namespace po = boost::program_options;
+
+STORAGE_ENGINE StorageConfig::getDefaultStorageEngine() {
+  const char *devMode = std::getenv("COMM_SERVICES_DEV_MODE");
+  if (devMode != nullptr && std::string(devMode) == "1") {
+    return STORAGE_ENGINE::LOCAL;
+  }
+  return STORAGE_ENGINE::S3;
+}
+
+size_t StorageConfig::getS3MaxConnections() const {
+  return this->s3MaxConnections ? this->s3MaxConnections
+                                : this->executorThreads;
+}
+
+StorageConfig StorageConfig::load() {
+  StorageConfig config;
+  std::string storageEngine =
+      (config.storageEngine == STORAGE_ENGINE::LOCAL) ? "local" : "s3";
+  std::string compression = "none";
+  std::string logLevel = "info";
+  po::options_description description("storage");
+  description.add_options()(
+      "storage_engine", po::value<std::string>(&storageEngine))(
+      "local_storage_path", po::value<std::string>(&config.localStoragePath))(
+      "local_storage_sync", po::value<bool>(&config.localStorageSync))(
+      "region", po::value<std::string>(&config.region))(
+      "s3_max_connections", po::value<size_t>(&config.s3MaxConnections))(
+      "s3_connect_timeout_ms", po::value<long>(&config.s3ConnectTimeoutMs))(
+      "s3_request_timeout_ms", po::value<long>(&config.s3RequestTimeoutMs))(
+      "s3_tcp_keep_alive", po::value<bool>(&config.s3TcpKeepAlive))(
+      "s3_tcp_keep_alive_interval_ms",
+      po::value<unsigned long>(&config.s3TcpKeepAliveIntervalMs))(
+      "s3_max_retries", po::value<long>(&config.s3MaxRetries))(
+      "s3_retry_scale_factor", po::value<long>(&config.s3RetryScaleFactor))(
+      "executor_threads", po::value<size_t>(&config.executorThreads))(
+      "metrics_report_interval_s",
+      po::value<size_t>(&config.metricsReportIntervalS))(
+      "metrics_port", po::value<unsigned short>(&config.metricsPort))(
+      "compression", po::value<std::string>(&compression))(
+      "log_level", po::value<std::string>(&logLevel))(
+      "log_sample_every", po::value<size_t>(&config.logger.sampleEvery))(
+      "log_max_records_per_second",
+      po::value<size_t>(&config.logger.maxRecordsPerSecond))(
+      "log_payloads", po::value<bool>(&config.logger.logPayloads));
+
+  const std::string prefix = "COMM_BACKUP_";
+  po::variables_map values;
+  try {
+    // only the variables of known settings are taken, values stored first
+    // aren't overwritten so the environment is parsed before the file
+    po::store(
+        po::parse_environment(
+            description,
+            [&description, &prefix](const std::string &variable) {
+              // docker-compose passes the unset variables as empty ones
+              const char *value = std::getenv(variable.c_str());
+              if (variable.find(prefix) != 0 || value == nullptr ||
+                  *value == '\0') {
+                return std::string();
+              }
+              std::string name = variable.substr(prefix.size());
+              for (char &c : name) {
+                c = std::tolower(c);
+              }
+              return description.find_nothrow(name, false) ? name
+                                                           : std::string();
+            }),
+        values);
+    const char *path = std::getenv("COMM_BACKUP_CONFIG");
+    if (path != nullptr) {
+      std::ifstream file(path);
+      if (!file.is_open()) {
+        throw std::runtime_error(
+            "config file " + std::string(path) + " can't be opened");
+      }
+      po::store(po::parse_config_file(file, description), values);
+    }
+    po::notify(values);
+  } catch (po::error &e) {
+    throw std::runtime_error(std::string("invalid config: ") + e.what());
+  }
+
+  if (storageEngine == "s3") {
+    config.storageEngine = STORAGE_ENGINE::S3;
+  } else if (storageEngine == "local") {
+    config.storageEngine = STORAGE_ENGINE::LOCAL;
+  } else {
+    throw std::runtime_error("unknown storage engine " + storageEngine);
+  }
+  if (compression == "zstd") {
+    config.codec = OBJECT_CODEC::ZSTD;
+  } else if (compression != "none") {
+    throw std::runtime_error("unknown compression " + compression);
+  }
+  config.logger.level = parseLogLevel(logLevel);
+  if (!config.executorThreads) {
+    throw std::runtime_error("executor threads can't be 0");
+  }
+  return config;
+}
+
+} // namespace network
+} // namespace comm
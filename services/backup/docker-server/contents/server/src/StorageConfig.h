@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Logger.h"
+#include "Tools.h"
+
+#include <string>
+
+namespace comm {
+namespace network {
+
+enum class STORAGE_ENGINE {
+  S3 = 0,
+  LOCAL = 1,
+};
+
+/**
+ * Settings of the storage layer. Every setting can be given in the file
+ * pointed by COMM_BACKUP_CONFIG (as `name = value` lines) or as an
+ * environment variable with the COMM_BACKUP_ prefix (e.g.
+ * COMM_BACKUP_S3_MAX_CONNECTIONS), the environment takes precedence.
+ */
+struct StorageConfig {
+  // the dev mode uses the local engine unless it's configured otherwise
+  STORAGE_ENGINE storageEngine = getDefaultStorageEngine();
+  // every bucket is a directory in here
+  std::string localStoragePath = "/tmp/comm";
+  bool localStorageSync = true;
+  std::string region = "us-east-2";
+  // every request is made by an executor thread, including the parallel
+  // parts which run on their waiter's thread when the executor is busy, so
+  // by default there's a connection per thread, see `getS3MaxConnections`
+  size_t s3MaxConnections = 0;
+  long s3ConnectTimeoutMs = 1000;
+  long s3RequestTimeoutMs = 10000;
+  bool s3TcpKeepAlive = true;
+  unsigned long s3TcpKeepAliveIntervalMs = 30000;
+  long s3MaxRetries = 3;
+  long s3RetryScaleFactor = 25;
+  size_t executorThreads = AWS_EXECUTOR_THREADS;
+  // 0 disables the periodic report of the storage metrics to the log
+  size_t metricsReportIntervalS = 0;
+  // the port of the HTTP metrics endpoint, 0 disables it
+  unsigned short metricsPort = 0;
+  OBJECT_CODEC codec = OBJECT_CODEC::NONE;
+  // log_level, log_sample_every, log_max_records_per_second, log_payloads
+  LoggerConfig logger;
+
+  size_t getS3MaxConnections() const;
+
+  static STORAGE_ENGINE getDefaultStorageEngine();
+  static StorageConfig load();
+};
+
+} // namespace network
+} // namespace comm
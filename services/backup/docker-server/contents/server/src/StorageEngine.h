@@ -0,0 +1,59 @@
+#pragma once
+
+#include <istream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace comm {
+namespace network {
+
+/**
+ * One multipart upload of an engine. Parts are numbered from 1 and uploaded
+ * concurrently, the offset of every part in the final object is known up
+ * front because parts are started in order. The object appears only once the
+ * upload is completed.
+ */
+class MultiPartUpload {
+public:
+  virtual ~MultiPartUpload() = default;
+
+  // returns the etag of the part
+  virtual std::string uploadPart(
+      const std::string &part,
+      const size_t partNumber,
+      const size_t offset) = 0;
+  // takes the etags of all of the parts in order, returns the object's etag
+  virtual std::string complete(const std::vector<std::string> &partsETags) = 0;
+  virtual void abort() = 0;
+};
+
+/**
+ * Storage of the objects of one bucket. AwsS3Bucket builds chunked reads and
+ * buffered multipart uploads on top of these operations so every
+ * engine behaves the same way.
+ */
+class StorageEngine {
+public:
+  virtual ~StorageEngine() = default;
+
+  virtual std::vector<std::string> listObjects() = 0;
+  virtual bool isAvailable() = 0;
+  virtual bool objectExists(const std::string &objectName) = 0;
+  virtual size_t getObjectSize(const std::string &objectName) = 0;
+  virtual void
+  renameObject(const std::string &currentName, const std::string &newName) = 0;
+  // returns the etag of the object
+  virtual std::string
+  writeObject(const std::string &objectName, const std::string &data) = 0;
+  // throws invalid_argument_error for objects bigger than a gRPC chunk
+  virtual std::string getObjectData(const std::string &objectName) = 0;
+  virtual std::shared_ptr<std::istream>
+  openObjectStream(const std::string &objectName) = 0;
+  virtual std::unique_ptr<MultiPartUpload>
+  startMultiPartUpload(const std::string &objectName) = 0;
+  virtual void deleteObject(const std::string &objectName) = 0;
+};
+
+} // namespace network
+} // namespace comm
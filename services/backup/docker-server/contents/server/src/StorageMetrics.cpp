@@ -0,0 +1,196 @@
+#include "StorageMetrics.h"
+#include "Logger.h"
+
+#include <aws/core/monitoring/HttpClientMetrics.h>
+#include <aws/core/monitoring/MonitoringInterface.h>
+
+#include <algorithm>
+
+namespace comm {
+namespace network {
+
+namespace {
+
+const char *MONITORING_TAG = "StorageMetrics";
+
+using Clock = std::chrono::steady_clock;
+
+class StorageMonitoring : public Aws::Monitoring::MonitoringInterface {
+  void recordResult(
+      const Aws::String &requestName,
+      const bool succeeded,
+      const Aws::Monitoring::CoreMetricsCollection &metricsFromCore,
+      void *context) const {
+    const Clock::time_point *start = static_cast<Clock::time_point *>(context);
+    StorageMetrics::getInstance().recordRequest(
+        requestName.c_str(),
+        succeeded,
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            Clock::now() - *start));
+    // the http client reports whether the request got a pooled connection
+    auto reused = metricsFromCore.httpClientMetrics.find(
+        Aws::Monitoring::GetHttpClientMetricNameByType(
+            Aws::Monitoring::HttpClientMetricsType::ConnectionReused));
+    if (reused != metricsFromCore.httpClientMetrics.end()) {
+      StorageMetrics::getInstance().recordConnection(reused->second != 0);
+    }
+  }
+
+public:
+  void *OnRequestStarted(
+      const Aws::String &serviceName,
+      const Aws::String &requestName,
+      const std::shared_ptr<const Aws::Http::HttpRequest> &request)
+      const override {
+    return new Clock::time_point(Clock::now());
+  }
+
+  void OnRequestSucceeded(
+      const Aws::String &serviceName,
+      const Aws::String &requestName,
+      const std::shared_ptr<const Aws::Http::HttpRequest> &request,
+      const Aws::Client::HttpResponseOutcome &outcome,
+      const Aws::Monitoring::CoreMetricsCollection &metricsFromCore,
+      void *context) const override {
+    this->recordResult(requestName, true, metricsFromCore, context);
+  }
+
+  void OnRequestFailed(
+      const Aws::String &serviceName,
+      const Aws::String &requestName,
+      const std::shared_ptr<const Aws::Http::HttpRequest> &request,
+      const Aws::Client::HttpResponseOutcome &outcome,
+      const Aws::Monitoring::CoreMetricsCollection &metricsFromCore,
+      void *context) const override {
+    this->recordResult(requestName, false, metricsFromCore, context);
+  }
+
+  void OnRequestRetry(
+      const Aws::String &serviceName,
+      const Aws::String &requestName,
+      const std::shared_ptr<const Aws::Http::HttpRequest> &request,
+      void *context) const override {
+    StorageMetrics::getInstance().recordRetry(requestName.c_str());
+    // the latency of every attempt is measured separately
+    *static_cast<Clock::time_point *>(context) = Clock::now();
+  }
+
+  void OnFinish(
+      const Aws::String &serviceName,
+      const Aws::String &requestName,
+      const std::shared_ptr<const Aws::Http::HttpRequest> &request,
+      void *context) const override {
+    delete static_cast<Clock::time_point *>(context);
+  }
+};
+
+class StorageMonitoringFactory : public Aws::Monitoring::MonitoringFactory {
+public:
+  Aws::UniquePtr<Aws::Monitoring::MonitoringInterface>
+  CreateMonitoringInstance() const override {
+    return Aws::MakeUnique<StorageMonitoring>(MONITORING_TAG);
+  }
+};
+
+} // namespace
+
+StorageMetrics::StorageMetrics()
+    : exportedReusedConnections(MetricsRegistry::getInstance().getCounter(
+          "backup_storage_connections_total",
+          "The connections taken by the storage requests.",
+          {{"reused", "true"}})),
+      exportedNewConnections(MetricsRegistry::getInstance().getCounter(
+          "backup_storage_connections_total",
+          "The connections taken by the storage requests.",
+          {{"reused", "false"}})) {
+}
+
+StorageMetrics::OperationMetrics &
+StorageMetrics::getOperation(const std::string &operation) {
+  OperationMetrics &metrics = this->operations[operation];
+  if (metrics.exportedLatency == nullptr) {
+    MetricsRegistry &registry = MetricsRegistry::getInstance();
+    metrics.exportedLatency = &registry.getHistogram(
+        "backup_storage_request_duration_microseconds",
+        "The latency of a single attempt of a storage request.",
+        LATENCY_BUCKETS,
+        {{"operation", operation}});
+    metrics.exportedFailures = &registry.getCounter(
+        "backup_storage_request_failures_total",
+        "The failed attempts of the storage requests.",
+        {{"operation", operation}});
+    metrics.exportedRetries = &registry.getCounter(
+        "backup_storage_request_retries_total",
+        "The retried attempts of the storage requests.",
+        {{"operation", operation}});
+  }
+  return metrics;
+}
+
+StorageMetrics &StorageMetrics::getInstance() {
+  static StorageMetrics instance;
+  return instance;
+}
+
+Aws::UniquePtr<Aws::Monitoring::MonitoringFactory>
+StorageMetrics::createMonitoringFactory() {
+  return Aws::MakeUnique<StorageMonitoringFactory>(MONITORING_TAG);
+}
+
+void StorageMetrics::recordRequest(
+    const std::string &operation,
+    const bool succeeded,
+    const std::chrono::microseconds latency) {
+  std::lock_guard<std::mutex> lock(this->mutex);
+  OperationMetrics &metrics = this->getOperation(operation);
+  ++metrics.requests;
+  if (!succeeded) {
+    ++metrics.failures;
+    metrics.exportedFailures->increment();
+  }
+  metrics.totalLatency += latency;
+  metrics.maxLatency = std::max(metrics.maxLatency, latency);
+  metrics.exportedLatency->observe(latency.count());
+}
+
+void StorageMetrics::recordRetry(const std::string &operation) {
+  std::lock_guard<std::mutex> lock(this->mutex);
+  OperationMetrics &metrics = this->getOperation(operation);
+  ++metrics.retries;
+  metrics.exportedRetries->increment();
+}
+
+void StorageMetrics::recordConnection(const bool reused) {
+  if (reused) {
+    ++this->reusedConnections;
+    this->exportedReusedConnections.increment();
+  } else {
+    ++this->newConnections;
+    this->exportedNewConnections.increment();
+  }
+}
+
+void StorageMetrics::report() {
+  Logger &logger = Logger::getInstance();
+  logger.info(
+      "storage connections",
+      {{"reused", this->reusedConnections.load()},
+       {"created", this->newConnections.load()}});
+  std::lock_guard<std::mutex> lock(this->mutex);
+  for (const auto &operation : this->operations) {
+    const OperationMetrics &metrics = operation.second;
+    // a retried request may not have finished yet
+    const size_t requests = std::max<size_t>(metrics.requests, 1);
+    logger.info(
+        "storage requests",
+        {{"operation", operation.first},
+         {"requests", metrics.requests},
+         {"failures", metrics.failures},
+         {"retries", metrics.retries},
+         {"average_latency_us", (metrics.totalLatency / requests).count()},
+         {"max_latency_us", metrics.maxLatency.count()}});
+  }
+}
+
+} // namespace network
+} // namespace comm
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Metrics.h"
+
+#include <aws/core/monitoring/MonitoringFactory.h>
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace comm {
+namespace network {
+
+/**
+ * Counters of the requests made by the S3 client, collected through the
+ * SDK's monitoring interface so every operation is covered without touching
+ * the call sites. The factory is registered in the SDK options before
+ * Aws::InitAPI. The requests are also exported to the metrics registry.
+ */
+class StorageMetrics {
+  struct OperationMetrics {
+    size_t requests = 0;
+    size_t failures = 0;
+    size_t retries = 0;
+    std::chrono::microseconds totalLatency{0};
+    std::chrono::microseconds maxLatency{0};
+    // owned by the metrics registry
+    Histogram *exportedLatency = nullptr;
+    Counter *exportedFailures = nullptr;
+    Counter *exportedRetries = nullptr;
+  };
+
+  std::mutex mutex;
+  std::map<std::string, OperationMetrics> operations;
+  std::atomic<size_t> reusedConnections{0};
+  std::atomic<size_t> newConnections{0};
+  Counter &exportedReusedConnections;
+  Counter &exportedNewConnections;
+
+  StorageMetrics();
+  // has to be called with the mutex locked
+  OperationMetrics &getOperation(const std::string &operation);
+
+public:
+  static StorageMetrics &getInstance();
+  static Aws::UniquePtr<Aws::Monitoring::MonitoringFactory>
+  createMonitoringFactory();
+
+  void recordRequest(
+      const std::string &operation,
+      const bool succeeded,
+      const std::chrono::microseconds latency);
+  void recordRetry(const std::string &operation);
+  void recordConnection(const bool reused);
+  // logs the counters, one record for the connections and one per operation
+  void report();
+};
+
+} // namespace network
+} // namespace comm
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
+#include <utility>
+
+namespace comm {
+namespace network {
+
+// hands a task to the storage manager's executor
+using TaskSubmitter = std::function<void(std::function<void()>)>;
+
+/**
+ * A part or a range transferred on the storage manager's executor on behalf
+ * of a storage task which waits for it. The executor is bounded and its
+ * threads may all be busy with tasks waiting for their parts, so a waiter
+ * whose task hasn't been picked up yet runs it on its own thread instead of
+ * blocking. Without a submitter the task is run by the waiter. Like a future
+ * of std::async the task is waited for when it gets destroyed.
+ */
+template <typename T> class StorageTask {
+  struct State {
+    std::atomic<bool> started{false};
+    std::packaged_task<T()> task;
+
+    void run() {
+      if (!this->started.exchange(true)) {
+        this->task();
+      }
+    }
+  };
+
+  std::shared_ptr<State> state;
+  std::future<T> result;
+
+  void wait() {
+    if (this->result.valid()) {
+      this->state->run();
+      this->result.wait();
+    }
+  }
+
+public:
+  StorageTask() = default;
+
+  StorageTask(const TaskSubmitter &submit, std::function<T()> function)
+      : state(std::make_shared<State>()) {
+    this->state->task = std::packaged_task<T()>(std::move(function));
+    this->result = this->state->task.get_future();
+    if (submit) {
+      std::shared_ptr<State> state = this->state;
+      submit([state]() { state->run(); });
+    }
+  }
+
+  StorageTask(StorageTask &&other) = default;
+
+  StorageTask &operator=(StorageTask &&other) {
+    this->wait();
+    this->state = std::move(other.state);
+    this->result = std::move(other.result);
+    return *this;
+  }
+
+  ~StorageTask() {
+    this->wait();
+  }
+
+  T get() {
+    this->state->run();
+    return this->result.get();
+  }
+};
+
+} // namespace network
+} // namespace comm
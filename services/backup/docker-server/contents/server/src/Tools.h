@@ -1,5 +1,8 @@
 #pragma once
 
+#include <stdexcept>
+#include <string>
+
 namespace comm {
 namespace network {
 
@@ -9,12 +12,36 @@ const size_t GRPC_CHUNK_SIZE_LIMIT = 4 * 1024 * 1024;
 // 5MB limit
 const size_t AWS_MULTIPART_UPLOAD_MINIMUM_CHUNK_SIZE = 5 * 1024 * 1024;
 
+// 5GB limit
+const size_t AWS_MULTIPART_UPLOAD_MAXIMUM_CHUNK_SIZE =
+    5ull * 1024 * 1024 * 1024;
+
+const size_t AWS_PARALLEL_UPLOADS = 4;
+
+// threads that run the storage operations of all of the RPCs
+const size_t AWS_EXECUTOR_THREADS = 16;
+
+// the indexes of this many users are kept in memory
+const size_t USER_INDEX_CACHE_SIZE = 10000;
+
+// the index is stored on every this many appends to a segmented object
+const size_t USER_INDEX_CHECKPOINT_INTERVAL = 16;
+
 enum class OBJECT_TYPE {
   ENCRYPTED_BACKUP_KEY = 0,
   TRANSACTION_LOGS = 1,
   COMPACTION = 2,
+  INDEX = 3,
+};
+
+enum class OBJECT_CODEC {
+  NONE = 0,
+  ZSTD = 1,
 };
 
+// a fast level, the service compresses on the request path
+const int ZSTD_COMPRESSION_LEVEL = 3;
+
 class invalid_argument_error : public std::runtime_error {
 public:
   invalid_argument_error(std::string errorMessage)
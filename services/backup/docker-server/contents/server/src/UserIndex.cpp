@@ -0,0 +1,130 @@
+#include "UserIndex.h"
+
+#include <sstream>
+
+namespace comm {
+namespace network {
+
+// every object is stored in one line:
+// name <TAB> size <TAB> etag <TAB> first segment <TAB> segments count <TAB>
+// codec, the line doesn't grow with the number of segments
+UserIndex::UserIndex(AwsS3Bucket bucket, const std::string indexName)
+    : bucket(bucket), indexName(indexName) {
+  this->load();
+}
+
+void UserIndex::load() {
+  if (!this->bucket.objectExists(this->indexName)) {
+    return;
+  }
+  std::istringstream index(this->bucket.getObjectData(this->indexName));
+  std::string line;
+  while (std::getline(index, line)) {
+    std::istringstream fields(line);
+    std::string name, size, firstSegment, segmentsCount, codec;
+    ObjectMetadata metadata;
+    std::getline(fields, name, '\t');
+    std::getline(fields, size, '\t');
+    std::getline(fields, metadata.eTag, '\t');
+    std::getline(fields, firstSegment, '\t');
+    std::getline(fields, segmentsCount, '\t');
+    std::getline(fields, codec, '\t');
+    try {
+      metadata.size = std::stoull(size);
+      metadata.firstSegment = std::stoull(firstSegment);
+      metadata.segmentsCount = std::stoull(segmentsCount);
+      metadata.codec = static_cast<OBJECT_CODEC>(std::stoi(codec));
+    } catch (std::logic_error &) {
+      throw std::runtime_error(
+          "invalid entry in index " + this->indexName + ": [" + line + "]");
+    }
+    this->objects[name] = metadata;
+  }
+}
+
+std::unique_lock<std::mutex> UserIndex::lock() {
+  return std::unique_lock<std::mutex>(this->mutex);
+}
+
+bool UserIndex::hasObjectMetadata(const std::string &objectName) const {
+  return this->objects.find(objectName) != this->objects.end();
+}
+
+ObjectMetadata
+UserIndex::getObjectMetadata(const std::string &objectName) const {
+  auto it = this->objects.find(objectName);
+  if (it == this->objects.end()) {
+    return ObjectMetadata();
+  }
+  return it->second;
+}
+
+void UserIndex::setObjectMetadata(
+    const std::string &objectName,
+    const ObjectMetadata &metadata) {
+  if (objectName.find_first_of("\t\n") != std::string::npos) {
+    throw invalid_argument_error(
+        "object name [" + objectName + "] can't be indexed");
+  }
+  if (this->unstoredChanges.find(objectName) == this->unstoredChanges.end()) {
+    auto it = this->objects.find(objectName);
+    this->unstoredChanges[objectName] = (it == this->objects.end())
+        ? std::nullopt
+        : std::optional<ObjectMetadata>(it->second);
+  }
+  this->objects[objectName] = metadata;
+}
+
+void UserIndex::setRecoverableObjectMetadata(
+    const std::string &objectName,
+    const ObjectMetadata &metadata) {
+  auto change = this->unstoredChanges.find(objectName);
+  if (change != this->unstoredChanges.end()) {
+    change->second = metadata;
+  }
+  this->objects[objectName] = metadata;
+}
+
+bool UserIndex::isRecovered(const std::string &objectName) const {
+  return this->recoveredObjects.find(objectName) !=
+      this->recoveredObjects.end();
+}
+
+void UserIndex::setRecovered(const std::string &objectName) {
+  this->recoveredObjects.insert(objectName);
+}
+
+void UserIndex::store() {
+  std::ostringstream index;
+  for (const auto &object : this->objects) {
+    index << object.first << '\t' << object.second.size << '\t'
+          << object.second.eTag << '\t' << object.second.firstSegment << '\t'
+          << object.second.segmentsCount << '\t'
+          << static_cast<int>(object.second.codec) << '\n';
+  }
+  try {
+    this->bucket.writeObject(this->indexName, index.str());
+  } catch (std::runtime_error &) {
+    for (const auto &change : this->unstoredChanges) {
+      if (change.second.has_value()) {
+        this->objects[change.first] = change.second.value();
+      } else {
+        this->objects.erase(change.first);
+      }
+    }
+    this->unstoredChanges.clear();
+    throw;
+  }
+  this->unstoredChanges.clear();
+}
+
+uint64_t UserIndex::getGeneration() const {
+  return this->generation;
+}
+
+void UserIndex::nextGeneration() {
+  ++this->generation;
+}
+
+} // namespace network
+} // namespace comm
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "AwsS3Bucket.h"
+#include "ObjectMetadata.h"
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace comm {
+namespace network {
+
+/**
+ * Metadata of all of the objects of one user, persisted as a single index
+ * object. Instances are meant to be cached and shared between the calls of
+ * the same user so the hot paths don't need HeadObject requests. Callers
+ * hold the lock for the whole read-modify-store sequence. When the index can't
+ * be stored the changes made since the last store are reverted, the cached
+ * index never differs from the stored one after a store except for the
+ * recoverable changes. A user's objects have a single writer: every user is
+ * served by one backup instance which keeps one index instance per user, the
+ * cached index is never revalidated against the storage.
+ */
+class UserIndex {
+  AwsS3Bucket bucket;
+  const std::string indexName;
+  std::unordered_map<std::string, ObjectMetadata> objects;
+  // the stored metadata of the objects changed since the last store, empty
+  // for the objects which weren't indexed
+  std::unordered_map<std::string, std::optional<ObjectMetadata>>
+      unstoredChanges;
+  // bumped whenever indexed objects get replaced or deleted
+  uint64_t generation = 0;
+  // the objects whose recoverable changes have been recovered since the load
+  std::unordered_set<std::string> recoveredObjects;
+  std::mutex mutex;
+
+  void load();
+
+public:
+  UserIndex(AwsS3Bucket bucket, const std::string indexName);
+
+  std::unique_lock<std::mutex> lock();
+  bool hasObjectMetadata(const std::string &objectName) const;
+  ObjectMetadata getObjectMetadata(const std::string &objectName) const;
+  // the index is a text file with a line per object and tab separated fields,
+  // names with tabs or newlines are rejected
+  void setObjectMetadata(
+      const std::string &objectName,
+      const ObjectMetadata &metadata);
+  // for the changes the owner of the object recovers from the storage after
+  // the index is loaded, they don't have to be stored and aren't reverted
+  // when a store fails
+  void setRecoverableObjectMetadata(
+      const std::string &objectName,
+      const ObjectMetadata &metadata);
+  bool isRecovered(const std::string &objectName) const;
+  void setRecovered(const std::string &objectName);
+  void store();
+  // readers which open the listed objects one by one check, with the lock
+  // held, that the generation hasn't changed since the listing
+  uint64_t getGeneration() const;
+  void nextGeneration();
+};
+
+} // namespace network
+} // namespace comm
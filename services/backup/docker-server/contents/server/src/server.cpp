@@ -1,28 +1,51 @@
 #include "BackupServiceImpl.h"
+#include "Logger.h"
+#include "MetricsServer.h"
+#include "StorageConfig.h"
+#include "StorageMetrics.h"
 
 #include <grpcpp/grpcpp.h>
 
-#include <iostream>
+#include <chrono>
 #include <memory>
 #include <string>
+#include <thread>
 
 namespace comm {
 namespace network {
 
 void RunServer() {
   std::string server_address = "0.0.0.0:50051";
-  BackupServiceImpl backupService;
+  const StorageConfig config = StorageConfig::load();
+  Logger::getInstance().configure(config.logger);
+  BackupServiceImpl backupService(config);
+
+  if (config.metricsReportIntervalS) {
+    std::thread([interval = config.metricsReportIntervalS]() {
+      while (true) {
+        std::this_thread::sleep_for(std::chrono::seconds(interval));
+        StorageMetrics::getInstance().report();
+      }
+    }).detach();
+  }
+
+  std::unique_ptr<MetricsServer> metricsServer;
+  if (config.metricsPort) {
+    metricsServer =
+        std::make_unique<MetricsServer>("0.0.0.0", config.metricsPort);
+  }
 
   grpc::EnableDefaultHealthCheckService(true);
   grpc::ServerBuilder builder;
   // Listen on the given address without any authentication mechanism.
   builder.AddListeningPort(server_address, grpc::InsecureServerCredentials());
   // Register "service" as the instance through which we'll communicate with
-  // clients. In this case it corresponds to an *synchronous* service.
+  // clients. In this case it corresponds to a *callback* service.
   builder.RegisterService(&backupService);
   // Finally assemble the server.
   std::unique_ptr<grpc::Server> server(builder.BuildAndStart());
-  std::cout << "Server listening" << std::endl;
+  Logger::getInstance().info(
+      "Server listening", {{"address", server_address}});
 
   // Wait for the server to shutdown. Note that some other thread must be
   // responsible for shutting down the server for this call to ever return.
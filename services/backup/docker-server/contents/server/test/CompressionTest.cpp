@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include "Compression.h"
+
+#include <memory>
+#include <sstream>
+#include <string>
+
+using namespace comm::network;
+
+namespace {
+
+std::string readAll(std::istream &stream, const size_t chunkSize) {
+  std::string result;
+  std::string buffer;
+  buffer.resize(chunkSize);
+  while (stream.read((char *)buffer.data(), chunkSize)) {
+    result += buffer;
+  }
+  result.append(buffer.data(), stream.gcount());
+  return result;
+}
+
+std::string createLogs(const size_t count) {
+  std::string result;
+  for (size_t i = 0; i < count; ++i) {
+    result += "{\"id\":" + std::to_string(i) + ",\"type\":\"message\"}\n";
+  }
+  return result;
+}
+
+} // namespace
+
+TEST(CompressionTest, StreamedCompressionRoundTrip) {
+  const std::string data = createLogs(100000);
+  ZstdCompressor compressor;
+  std::string compressed;
+  for (size_t offset = 0; offset < data.size(); offset += 1000) {
+    compressed += compressor.compress(data.substr(offset, 1000));
+  }
+  compressed += compressor.finish();
+  EXPECT_LT(compressed.size(), data.size());
+
+  ZstdInputStream stream(std::make_shared<std::istringstream>(compressed));
+  EXPECT_EQ(readAll(stream, 4096), data);
+}
+
+TEST(CompressionTest, ConcatenatedFramesRoundTrip) {
+  const std::string first = createLogs(10);
+  const std::string second = createLogs(20);
+  ZstdInputStream stream(std::make_shared<std::istringstream>(
+      compress(first) + compress(second)));
+  EXPECT_EQ(readAll(stream, 7), first + second);
+}
+
+TEST(CompressionTest, UncompressedStreamIsNotDecoded) {
+  std::shared_ptr<std::istream> source =
+      std::make_shared<std::istringstream>("data");
+  EXPECT_EQ(decodeStream(source, OBJECT_CODEC::NONE), source);
+}
+
+TEST(CompressionTest, ThrowingTruncatedData) {
+  const std::string compressed = compress(createLogs(1000));
+  ZstdInputStream stream(std::make_shared<std::istringstream>(
+      compressed.substr(0, compressed.size() / 2)));
+  EXPECT_THROW(readAll(stream, 4096), std::runtime_error);
+}
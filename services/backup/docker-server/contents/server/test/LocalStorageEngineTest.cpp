@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+
+#include "LocalStorageEngine.h"
+#include "MultiPartUploader.h"
+#include "Tools.h"
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace comm::network;
+
+class LocalStorageEngineTest : public testing::Test {
+protected:
+  const std::string path = "/tmp/comm-local-storage-test";
+  std::shared_ptr<LocalStorageEngine> engine;
+
+  virtual void SetUp() {
+    std::filesystem::remove_all(path);
+    engine = std::make_shared<LocalStorageEngine>(path);
+  }
+
+  virtual void TearDown() {
+    engine = nullptr;
+    std::filesystem::remove_all(path);
+  }
+};
+
+TEST_F(LocalStorageEngineTest, OverwriteAndDelete) {
+  engine->writeObject("object", "first version");
+  engine->writeObject("object", "second");
+  EXPECT_EQ(engine->getObjectData("object"), "second");
+  EXPECT_EQ(engine->getObjectSize("object"), 6);
+
+  engine->deleteObject("object");
+  EXPECT_FALSE(engine->objectExists("object"));
+  EXPECT_THROW(engine->writeObject("../object", ""), std::runtime_error);
+}
+
+TEST_F(LocalStorageEngineTest, ConcurrentWritesLeaveNoTemporaryFiles) {
+  std::vector<std::thread> writers;
+  for (size_t i = 0; i < 8; ++i) {
+    writers.emplace_back([this, i]() {
+      for (size_t j = 0; j < 20; ++j) {
+        engine->writeObject("object-" + std::to_string(i), std::to_string(j));
+      }
+    });
+  }
+  for (std::thread &writer : writers) {
+    writer.join();
+  }
+  std::vector<std::string> objects = engine->listObjects();
+  EXPECT_EQ(objects.size(), 8);
+  EXPECT_EQ(
+      std::distance(
+          std::filesystem::directory_iterator(path),
+          std::filesystem::directory_iterator()),
+      8);
+  EXPECT_EQ(engine->getObjectData("object-3"), "19");
+}
+
+TEST_F(LocalStorageEngineTest, MultiPartUploadReplacesTheObjectOnCompletion) {
+  const std::string data(3 * AWS_MULTIPART_UPLOAD_MINIMUM_CHUNK_SIZE, 'A');
+  engine->writeObject("object", "x");
+  MultiPartUploader uploader(engine->startMultiPartUpload("object"), 3);
+  uploader.addPart(data);
+  uploader.addPart("x");
+  EXPECT_EQ(engine->getObjectData("object"), "x");
+  EXPECT_EQ(engine->listObjects().size(), 1);
+  EXPECT_EQ(uploader.finishUpload().size, data.size() + 1);
+
+  std::shared_ptr<std::istream> stream = engine->openObjectStream("object");
+  std::string result;
+  result.resize(data.size() + 10);
+  stream->read((char *)result.data(), result.size());
+  result.resize(stream->gcount());
+  EXPECT_EQ(result, data + "x");
+}
+
+TEST_F(LocalStorageEngineTest, AbortedUploadKeepsTheObject) {
+  engine->writeObject("object", "x");
+  MultiPartUploader uploader(engine->startMultiPartUpload("object"));
+  uploader.addPart(std::string(AWS_MULTIPART_UPLOAD_MINIMUM_CHUNK_SIZE, 'A'));
+  uploader.abortUpload();
+  EXPECT_EQ(engine->getObjectData("object"), "x");
+  EXPECT_EQ(
+      std::distance(
+          std::filesystem::directory_iterator(path),
+          std::filesystem::directory_iterator()),
+      1);
+}
+
+TEST_F(LocalStorageEngineTest, LeftoverTemporaryFilesAreRemoved) {
+  engine->writeObject("object", "x");
+  std::ofstream(path + "/.object.0.tmp") << "partial";
+  engine = std::make_shared<LocalStorageEngine>(path);
+  EXPECT_EQ(engine->getObjectData("object"), "x");
+  EXPECT_EQ(
+      std::distance(
+          std::filesystem::directory_iterator(path),
+          std::filesystem::directory_iterator()),
+      1);
+}
@@ -7,7 +7,6 @@
 #include "Tools.h"
 
 #include <aws/core/Aws.h>
-#include <aws/s3/S3Client.h>
 
 #include <string>
 
@@ -15,19 +14,18 @@ using namespace comm::network;
 
 class MultiPartUploadTest : public testing::Test {
 protected:
-  std::shared_ptr<Aws::S3::S3Client> s3Client;
+  std::unique_ptr<AwsStorageManager> storageManager;
   const std::string bucketName = "commapp-test";
-  std::unique_ptr<AwsS3Bucket> bucket;
+  AwsS3Bucket *bucket;
 
   virtual void SetUp() {
     Aws::InitAPI({});
-    Aws::Client::ClientConfiguration config;
-    config.region = "us-east-2";
-    s3Client = std::make_shared<Aws::S3::S3Client>(config);
-    bucket = std::make_unique<AwsS3Bucket>(bucketName, s3Client);
+    storageManager = std::make_unique<AwsStorageManager>();
+    bucket = &storageManager->getBucket(bucketName);
   }
 
   virtual void TearDown() {
+    storageManager = nullptr;
     Aws::ShutdownAPI({});
   }
 };
@@ -39,28 +37,59 @@ std::string generateNByes(const size_t n) {
   return result;
 }
 
-TEST_F(MultiPartUploadTest, ThrowingTooSmallPart) {
+TEST_F(MultiPartUploadTest, BufferingSmallParts) {
   std::string objectName = createObject(*bucket);
-  MultiPartUploader mpu(s3Client, bucketName, objectName);
-  mpu.addPart("xxx");
-  mpu.addPart("xxx");
-  EXPECT_THROW(mpu.finishUpload(), std::runtime_error);
+  std::unique_ptr<MultiPartUploader> mpu =
+      bucket->startMultiPartUpload(objectName);
+  mpu->addPart("xxx");
+  mpu->addPart("xxx");
+  mpu->finishUpload();
+  EXPECT_TRUE(bucket->getObjectData(objectName) == "xxxxxx");
+  bucket->deleteObject(objectName);
+}
+
+TEST_F(MultiPartUploadTest, BufferingSmallPartsOneByte) {
+  std::string objectName = createObject(*bucket);
+  std::unique_ptr<MultiPartUploader> mpu =
+      bucket->startMultiPartUpload(objectName);
+  mpu->addPart(generateNByes(AWS_MULTIPART_UPLOAD_MINIMUM_CHUNK_SIZE - 1));
+  mpu->addPart("xxx");
+  mpu->finishUpload();
+  EXPECT_EQ(
+      bucket->getObjectSize(objectName),
+      AWS_MULTIPART_UPLOAD_MINIMUM_CHUNK_SIZE + 2);
+  bucket->deleteObject(objectName);
 }
 
-TEST_F(MultiPartUploadTest, ThrowingTooSmallPartOneByte) {
+TEST_F(MultiPartUploadTest, SuccessfulParallelWriteInOrder) {
   std::string objectName = createObject(*bucket);
-  MultiPartUploader mpu(s3Client, bucketName, objectName);
-  mpu.addPart(generateNByes(AWS_MULTIPART_UPLOAD_MINIMUM_CHUNK_SIZE - 1));
-  mpu.addPart("xxx");
-  EXPECT_THROW(mpu.finishUpload(), std::runtime_error);
+  std::string data;
+  for (size_t i = 0; i < 3 * AWS_MULTIPART_UPLOAD_MINIMUM_CHUNK_SIZE + 3; ++i) {
+    data.push_back('A' + i % 26);
+  }
+  std::unique_ptr<MultiPartUploader> mpu =
+      bucket->startMultiPartUpload(objectName, 3);
+  for (size_t offset = 0; offset < data.size();
+       offset += GRPC_CHUNK_SIZE_LIMIT) {
+    mpu->addPart(data.substr(offset, GRPC_CHUNK_SIZE_LIMIT));
+  }
+  mpu->finishUpload();
+
+  std::string result;
+  std::function<void(const std::string &)> callback =
+      [&result](const std::string &chunk) { result += chunk; };
+  bucket->getObjectDataChunks(objectName, callback, GRPC_CHUNK_SIZE_LIMIT);
+  EXPECT_TRUE(result == data);
+  bucket->deleteObject(objectName);
 }
 
 TEST_F(MultiPartUploadTest, SuccessfulWriteMultipleChunks) {
   std::string objectName = createObject(*bucket);
-  MultiPartUploader mpu(s3Client, bucketName, objectName);
-  mpu.addPart(generateNByes(AWS_MULTIPART_UPLOAD_MINIMUM_CHUNK_SIZE));
-  mpu.addPart("xxx");
-  mpu.finishUpload();
+  std::unique_ptr<MultiPartUploader> mpu =
+      bucket->startMultiPartUpload(objectName);
+  mpu->addPart(generateNByes(AWS_MULTIPART_UPLOAD_MINIMUM_CHUNK_SIZE));
+  mpu->addPart("xxx");
+  mpu->finishUpload();
   EXPECT_THROW(bucket->getObjectData(objectName), invalid_argument_error);
   EXPECT_EQ(
       bucket->getObjectSize(objectName),
@@ -70,9 +99,22 @@ TEST_F(MultiPartUploadTest, SuccessfulWriteMultipleChunks) {
 
 TEST_F(MultiPartUploadTest, SuccessfulWriteOneChunk) {
   std::string objectName = createObject(*bucket);
-  MultiPartUploader mpu(s3Client, bucketName, objectName);
-  mpu.addPart("xxx");
-  mpu.finishUpload();
+  std::unique_ptr<MultiPartUploader> mpu =
+      bucket->startMultiPartUpload(objectName);
+  mpu->addPart("xxx");
+  mpu->finishUpload();
   EXPECT_EQ(bucket->getObjectSize(objectName), 3);
   bucket->deleteObject(objectName);
 }
+
+TEST_F(MultiPartUploadTest, AbortedUploadKeepsTheObject) {
+  std::string objectName = createObject(*bucket);
+  bucket->writeObject(objectName, "xxx");
+  std::unique_ptr<MultiPartUploader> mpu =
+      bucket->startMultiPartUpload(objectName);
+  mpu->addPart(generateNByes(AWS_MULTIPART_UPLOAD_MINIMUM_CHUNK_SIZE));
+  mpu->addPart("yyy");
+  mpu->abortUpload();
+  EXPECT_TRUE(bucket->getObjectData(objectName) == "xxx");
+  bucket->deleteObject(objectName);
+}
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#include "AwsStorageManager.h"
+#include "SegmentedObject.h"
+#include "TestTools.h"
+#include "UserIndex.h"
+
+#include <aws/core/Aws.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace comm::network;
+
+class SegmentedObjectTest : public testing::Test {
+protected:
+  std::unique_ptr<AwsStorageManager> storageManager;
+  const std::string bucketName = "commapp-test";
+
+  virtual void SetUp() {
+    Aws::InitAPI({});
+    if (storageManager == nullptr) {
+      storageManager = std::make_unique<AwsStorageManager>();
+    }
+  }
+
+  virtual void TearDown() {
+    Aws::ShutdownAPI({});
+  }
+
+  // reads the segments the way PullCompaction does
+  std::string readObject(
+      AwsS3Bucket &bucket,
+      UserIndex &index,
+      const std::string &objectName) {
+    const OBJECT_CODEC codec = index.getObjectMetadata(objectName).codec;
+    std::string result;
+    std::function<void(const std::string &)> callback =
+        [&result](const std::string &chunk) { result += chunk; };
+    for (const std::string &segmentName :
+         SegmentedObject(bucket, index, objectName).getSegmentsNames()) {
+      bucket.getObjectDataChunks(segmentName, callback, 4, codec);
+    }
+    return result;
+  }
+};
+
+TEST_F(SegmentedObjectTest, AppendAndReadInOrder) {
+  AwsS3Bucket bucket = storageManager->getBucket(bucketName);
+  const std::string objectName = createObject(bucket);
+  UserIndex index(bucket, objectName + "-index");
+  SegmentedObject object(bucket, index, objectName);
+  const std::vector<std::string> logs = {"first", "second", "", "third"};
+
+  std::string expected;
+  for (const std::string &log : logs) {
+    object.append(log);
+    expected += log;
+  }
+
+  EXPECT_EQ(readObject(bucket, index, objectName), expected);
+
+  // only the first append has been stored in the index, a freshly loaded
+  // index finds the other segments
+  UserIndex loadedIndex(bucket, objectName + "-index");
+  EXPECT_EQ(loadedIndex.getObjectMetadata(objectName).segmentsCount, 1);
+  EXPECT_EQ(readObject(bucket, loadedIndex, objectName), expected);
+  EXPECT_EQ(loadedIndex.getObjectMetadata(objectName).size, expected.size());
+  EXPECT_EQ(loadedIndex.getObjectMetadata(objectName).segmentsCount, 3);
+
+  // the segments of a cleared object aren't found again
+  object.clear();
+  EXPECT_TRUE(readObject(bucket, index, objectName).empty());
+  object.append("fourth");
+  UserIndex reloadedIndex(bucket, objectName + "-index");
+  EXPECT_EQ(readObject(bucket, reloadedIndex, objectName), "fourth");
+  object.clear();
+  bucket.deleteObject(objectName + "-index");
+}
+
+TEST_F(SegmentedObjectTest, CompressedAppendAndRead) {
+  AwsS3Bucket bucket = storageManager->getBucket(bucketName);
+  const std::string objectName = createObject(bucket);
+  UserIndex index(bucket, objectName + "-index");
+  SegmentedObject object(bucket, index, objectName, OBJECT_CODEC::ZSTD);
+  const std::string log(1000, 'A');
+
+  object.append(log);
+  object.append(log);
+  EXPECT_EQ(index.getObjectMetadata(objectName).codec, OBJECT_CODEC::ZSTD);
+  EXPECT_LT(index.getObjectMetadata(objectName).size, 2 * log.size());
+
+  // the codec recorded in the index is used for reading
+  UserIndex loadedIndex(bucket, objectName + "-index");
+  EXPECT_EQ(readObject(bucket, loadedIndex, objectName), log + log);
+
+  object.clear();
+  bucket.deleteObject(objectName + "-index");
+}
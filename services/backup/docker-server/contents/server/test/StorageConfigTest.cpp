@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include "StorageConfig.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+using namespace comm::network;
+
+class StorageConfigTest : public testing::Test {
+protected:
+  const std::string configPath = "/tmp/storage-config-test.cfg";
+
+  virtual void TearDown() {
+    unsetenv("COMM_BACKUP_CONFIG");
+    unsetenv("COMM_BACKUP_S3_MAX_CONNECTIONS");
+    unsetenv("COMM_BACKUP_COMPRESSION");
+    unsetenv("COMM_BACKUP_LOG_LEVEL");
+    std::remove(configPath.c_str());
+  }
+};
+
+TEST_F(StorageConfigTest, EnvironmentOverridesFile) {
+  std::ofstream(configPath) << "region = eu-west-1\n"
+                            << "s3_max_connections = 8\n"
+                            << "s3_tcp_keep_alive = false\n"
+                            << "log_sample_every = 10\n";
+  setenv("COMM_BACKUP_CONFIG", configPath.c_str(), 1);
+  setenv("COMM_BACKUP_S3_MAX_CONNECTIONS", "128", 1);
+  setenv("COMM_BACKUP_COMPRESSION", "zstd", 1);
+  setenv("COMM_BACKUP_LOG_LEVEL", "debug", 1);
+
+  const StorageConfig config = StorageConfig::load();
+  EXPECT_EQ(config.region, "eu-west-1");
+  EXPECT_EQ(config.s3MaxConnections, 128);
+  EXPECT_FALSE(config.s3TcpKeepAlive);
+  EXPECT_EQ(config.codec, OBJECT_CODEC::ZSTD);
+  EXPECT_EQ(config.executorThreads, AWS_EXECUTOR_THREADS);
+  EXPECT_EQ(config.logger.level, LOG_LEVEL::DEBUG);
+  EXPECT_EQ(config.logger.sampleEvery, 10);
+  EXPECT_FALSE(config.logger.logPayloads);
+}
+
+TEST_F(StorageConfigTest, ThrowingInvalidValue) {
+  setenv("COMM_BACKUP_COMPRESSION", "lz4", 1);
+  EXPECT_THROW(StorageConfig::load(), std::runtime_error);
+  setenv("COMM_BACKUP_COMPRESSION", "none", 1);
+  setenv("COMM_BACKUP_S3_MAX_CONNECTIONS", "many", 1);
+  EXPECT_THROW(StorageConfig::load(), std::runtime_error);
+  unsetenv("COMM_BACKUP_S3_MAX_CONNECTIONS");
+  setenv("COMM_BACKUP_LOG_LEVEL", "verbose", 1);
+  EXPECT_THROW(StorageConfig::load(), std::runtime_error);
+}
+
+TEST_F(StorageConfigTest, EmptyVariablesAreIgnored) {
+  setenv("COMM_BACKUP_COMPRESSION", "", 1);
+  setenv("COMM_BACKUP_S3_MAX_CONNECTIONS", "", 1);
+
+  const StorageConfig config = StorageConfig::load();
+  EXPECT_EQ(config.codec, OBJECT_CODEC::NONE);
+  EXPECT_EQ(config.s3MaxConnections, StorageConfig().s3MaxConnections);
+}
+
+TEST_F(StorageConfigTest, ConnectionsFollowExecutorThreads) {
+  std::ofstream(configPath) << "executor_threads = 6\n";
+  setenv("COMM_BACKUP_CONFIG", configPath.c_str(), 1);
+  EXPECT_EQ(StorageConfig::load().getS3MaxConnections(), 6);
+  setenv("COMM_BACKUP_S3_MAX_CONNECTIONS", "10", 1);
+  EXPECT_EQ(StorageConfig::load().getS3MaxConnections(), 10);
+}
@@ -71,3 +71,26 @@ TEST_F(StorageManagerTest, ObjectOperationsTest) {
       storageManager->getBucket(bucketName).getObjectData(objectName),
       std::runtime_error);
 }
+
+TEST_F(StorageManagerTest, ChunksOfBinaryDataTest) {
+  std::string objectName = createObject(storageManager->getBucket(bucketName));
+  std::string binaryData;
+  for (size_t i = 0; i < 1000; ++i) {
+    binaryData.push_back(static_cast<char>(i % 256));
+  }
+  storageManager->getBucket(bucketName).writeObject(objectName, binaryData);
+
+  for (const size_t chunkSize : {size_t(1), size_t(7), size_t(1000)}) {
+    std::string chunkedData;
+    std::function<void(const std::string &)> callback =
+        [&chunkedData, chunkSize](const std::string &chunk) {
+          EXPECT_LE(chunk.size(), chunkSize);
+          chunkedData += chunk;
+        };
+    storageManager->getBucket(bucketName)
+        .getObjectDataChunks(objectName, callback, chunkSize);
+    EXPECT_TRUE(binaryData == chunkedData);
+  }
+
+  storageManager->getBucket(bucketName).deleteObject(objectName);
+}
@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+
+#include "AwsStorageManager.h"
+#include "TestTools.h"
+#include "UserIndex.h"
+
+#include <aws/core/Aws.h>
+
+#include <memory>
+#include <string>
+
+using namespace comm::network;
+
+class UserIndexTest : public testing::Test {
+protected:
+  std::unique_ptr<AwsStorageManager> storageManager;
+  const std::string bucketName = "commapp-test";
+
+  virtual void SetUp() {
+    Aws::InitAPI({});
+    if (storageManager == nullptr) {
+      storageManager = std::make_unique<AwsStorageManager>();
+    }
+  }
+
+  virtual void TearDown() {
+    Aws::ShutdownAPI({});
+  }
+};
+
+TEST_F(UserIndexTest, StoreAndLoad) {
+  AwsS3Bucket bucket = storageManager->getBucket(bucketName);
+  const std::string indexName = createObject(bucket);
+
+  ObjectMetadata plain;
+  plain.size = 42;
+  plain.eTag = "\"d41d8cd98f00b204e9800998ecf8427e\"";
+  ObjectMetadata segmented;
+  segmented.size = 6;
+  segmented.firstSegment = 2;
+  segmented.segmentsCount = 3;
+  {
+    UserIndex index(bucket, indexName);
+    EXPECT_FALSE(index.hasObjectMetadata("plain"));
+    index.setObjectMetadata("plain", plain);
+    index.setObjectMetadata("segmented", segmented);
+    index.store();
+  }
+
+  UserIndex index(bucket, indexName);
+  EXPECT_TRUE(index.hasObjectMetadata("plain"));
+  EXPECT_EQ(index.getObjectMetadata("plain").size, plain.size);
+  EXPECT_EQ(index.getObjectMetadata("plain").eTag, plain.eTag);
+  EXPECT_EQ(index.getObjectMetadata("plain").segmentsCount, 0);
+  EXPECT_EQ(index.getObjectMetadata("segmented").size, segmented.size);
+  EXPECT_EQ(
+      index.getObjectMetadata("segmented").firstSegment,
+      segmented.firstSegment);
+  EXPECT_EQ(
+      index.getObjectMetadata("segmented").segmentsCount,
+      segmented.segmentsCount);
+  EXPECT_EQ(index.getObjectMetadata("missing").size, 0);
+
+  bucket.deleteObject(indexName);
+}
+
+TEST_F(UserIndexTest, RejectsNamesBreakingTheFormat) {
+  AwsS3Bucket bucket = storageManager->getBucket(bucketName);
+  UserIndex index(bucket, createObject(bucket));
+  EXPECT_THROW(
+      index.setObjectMetadata("name\twith tab", ObjectMetadata()),
+      invalid_argument_error);
+  EXPECT_THROW(
+      index.setObjectMetadata("name\nwith newline", ObjectMetadata()),
+      invalid_argument_error);
+  EXPECT_FALSE(index.hasObjectMetadata("name\twith tab"));
+}
@@ -0,0 +1,283 @@
+#include "Logger.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <stdexcept>
+
+namespace comm {
+namespace network {
+
+namespace {
+
+// how long the writer sleeps when there's nothing to write
+const std::chrono::milliseconds WRITER_IDLE_SLEEP(5);
+// the writer's output is flushed at least this often under a steady load
+const size_t MAX_BATCH_SIZE = 64 * 1024;
+
+const char *getLevelName(const LOG_LEVEL level) {
+  switch (level) {
+    case LOG_LEVEL::DEBUG:
+      return "debug";
+    case LOG_LEVEL::INFO:
+      return "info";
+    case LOG_LEVEL::WARNING:
+      return "warning";
+    case LOG_LEVEL::ERROR:
+      return "error";
+  }
+  return "unknown";
+}
+
+// the values with spaces, quotes or equal signs are quoted and escaped
+void appendValue(std::string &output, const std::string &value) {
+  bool quoted = value.empty();
+  for (const char c : value) {
+    if (c <= ' ' || c == '"' || c == '=' || c == '\\') {
+      quoted = true;
+      break;
+    }
+  }
+  if (!quoted) {
+    output += value;
+    return;
+  }
+  output += '"';
+  for (const char c : value) {
+    if (c == '"' || c == '\\') {
+      output += '\\';
+      output += c;
+    } else if (c == '\n') {
+      output += "\\n";
+    } else if (c == '\r') {
+      output += "\\r";
+    } else if (c == '\t') {
+      output += "\\t";
+    } else {
+      output += c;
+    }
+  }
+  output += '"';
+}
+
+// in UTC with milliseconds, e.g. 2022-05-05T10:15:30.123Z
+void appendTime(
+    std::string &output,
+    const std::chrono::system_clock::time_point time) {
+  const std::time_t seconds = std::chrono::system_clock::to_time_t(time);
+  const long milliseconds =
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          time.time_since_epoch())
+          .count() %
+      1000;
+  std::tm parts;
+  gmtime_r(&seconds, &parts);
+  char buffer[32];
+  const size_t length =
+      std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%S", &parts);
+  output.append(buffer, length);
+  std::snprintf(buffer, sizeof(buffer), ".%03ldZ", milliseconds);
+  output += buffer;
+}
+
+} // namespace
+
+LOG_LEVEL parseLogLevel(const std::string &name) {
+  if (name == "debug") {
+    return LOG_LEVEL::DEBUG;
+  }
+  if (name == "info") {
+    return LOG_LEVEL::INFO;
+  }
+  if (name == "warning") {
+    return LOG_LEVEL::WARNING;
+  }
+  if (name == "error") {
+    return LOG_LEVEL::ERROR;
+  }
+  throw std::runtime_error("unknown log level " + name);
+}
+
+Logger &Logger::getInstance() {
+  static Logger instance(std::cout);
+  return instance;
+}
+
+Logger::Logger(
+    std::ostream &output,
+    const LoggerConfig &config,
+    const size_t capacity)
+    : output(output),
+      records(capacity),
+      bufferFullDrops(MetricsRegistry::getInstance().getCounter(
+          "comm_log_records_dropped_total",
+          "The log records dropped instead of blocking the caller.",
+          {{"reason", "buffer_full"}})),
+      rateLimitDrops(MetricsRegistry::getInstance().getCounter(
+          "comm_log_records_dropped_total",
+          "The log records dropped instead of blocking the caller.",
+          {{"reason", "rate_limit"}})) {
+  this->configure(config);
+  this->writer = std::thread([this]() { this->run(); });
+}
+
+Logger::~Logger() {
+  this->stopped = true;
+  this->writer.join();
+}
+
+void Logger::configure(const LoggerConfig &config) {
+  this->level.store(config.level, std::memory_order_relaxed);
+  this->sampleEvery.store(
+      std::max<size_t>(config.sampleEvery, 1), std::memory_order_relaxed);
+  this->maxRecordsPerSecond.store(
+      config.maxRecordsPerSecond, std::memory_order_relaxed);
+  this->logPayloads.store(config.logPayloads, std::memory_order_relaxed);
+}
+
+bool Logger::isEnabled(const LOG_LEVEL level) const {
+  return level >= this->level.load(std::memory_order_relaxed);
+}
+
+std::string Logger::payload(const std::string &data) const {
+  if (this->logPayloads.load(std::memory_order_relaxed)) {
+    return data;
+  }
+  return "<redacted " + std::to_string(data.size()) + " bytes>";
+}
+
+bool Logger::isSampled(const LOG_LEVEL level) {
+  const size_t sampleEvery = this->sampleEvery.load(std::memory_order_relaxed);
+  if (level >= LOG_LEVEL::WARNING || sampleEvery == 1) {
+    return true;
+  }
+  return this->sampleCounter.fetch_add(1, std::memory_order_relaxed) %
+      sampleEvery ==
+      0;
+}
+
+bool Logger::isWithinRate(const LOG_LEVEL level) {
+  const size_t limit =
+      this->maxRecordsPerSecond.load(std::memory_order_relaxed);
+  if (level >= LOG_LEVEL::WARNING || limit == 0) {
+    return true;
+  }
+  const int64_t second =
+      std::chrono::duration_cast<std::chrono::seconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count();
+  // the first record of a second starts counting anew, the records counted by
+  // the other threads around the switch make the limit approximate
+  int64_t counted = this->rateSecond.load(std::memory_order_relaxed);
+  if (counted != second &&
+      this->rateSecond.compare_exchange_strong(
+          counted, second, std::memory_order_relaxed)) {
+    this->rateCounter.store(0, std::memory_order_relaxed);
+  }
+  return this->rateCounter.fetch_add(1, std::memory_order_relaxed) < limit;
+}
+
+void Logger::log(
+    const LOG_LEVEL level,
+    std::string message,
+    std::vector<LogField> fields) {
+  if (!this->isEnabled(level) || !this->isSampled(level)) {
+    return;
+  }
+  if (!this->isWithinRate(level)) {
+    this->rateLimitDrops.increment();
+    this->unreportedDrops.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  if (!this->records.push(
+          {std::chrono::system_clock::now(),
+           level,
+           std::move(message),
+           std::move(fields)})) {
+    this->bufferFullDrops.increment();
+    this->unreportedDrops.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void Logger::debug(std::string message, std::vector<LogField> fields) {
+  this->log(LOG_LEVEL::DEBUG, std::move(message), std::move(fields));
+}
+
+void Logger::info(std::string message, std::vector<LogField> fields) {
+  this->log(LOG_LEVEL::INFO, std::move(message), std::move(fields));
+}
+
+void Logger::warning(std::string message, std::vector<LogField> fields) {
+  this->log(LOG_LEVEL::WARNING, std::move(message), std::move(fields));
+}
+
+void Logger::error(std::string message, std::vector<LogField> fields) {
+  this->log(LOG_LEVEL::ERROR, std::move(message), std::move(fields));
+}
+
+void Logger::flush() {
+  const uint64_t request = this->flushRequests.fetch_add(1) + 1;
+  while (this->completedFlushes.load() < request) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+}
+
+void Logger::run() {
+  std::string batch;
+  while (true) {
+    // everything logged before these are read gets written in this round
+    const uint64_t flushRequest = this->flushRequests.load();
+    const bool stopping = this->stopped.load();
+    const size_t written = this->writeRecords(batch);
+    this->completedFlushes.store(flushRequest);
+    if (stopping) {
+      return;
+    }
+    if (!written) {
+      std::this_thread::sleep_for(WRITER_IDLE_SLEEP);
+    }
+  }
+}
+
+size_t Logger::writeRecords(std::string &batch) {
+  size_t written = 0;
+  Record record;
+  while (true) {
+    const bool popped = this->records.pop(record);
+    if (popped) {
+      batch += "time=";
+      appendTime(batch, record.time);
+      batch += " level=";
+      batch += getLevelName(record.level);
+      batch += " msg=";
+      appendValue(batch, record.message);
+      for (const LogField &field : record.fields) {
+        batch += ' ';
+        batch += field.key;
+        batch += '=';
+        appendValue(batch, field.value);
+      }
+      batch += '\n';
+      ++written;
+    } else {
+      const uint64_t drops = this->unreportedDrops.exchange(0);
+      if (drops) {
+        batch += "time=";
+        appendTime(batch, std::chrono::system_clock::now());
+        batch += " level=warning msg=\"log records dropped\" count=" +
+            std::to_string(drops) + "\n";
+      }
+    }
+    if ((!popped && !batch.empty()) || batch.size() >= MAX_BATCH_SIZE) {
+      this->output.write(batch.data(), batch.size());
+      this->output.flush();
+      batch.clear();
+    }
+    if (!popped) {
+      return written;
+    }
+  }
+}
+
+} // namespace network
+} // namespace comm
@@ -0,0 +1,137 @@
+#pragma once
+
+#include "Metrics.h"
+#include "RingBuffer.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace comm {
+namespace network {
+
+enum class LOG_LEVEL {
+  DEBUG = 0,
+  INFO = 1,
+  WARNING = 2,
+  ERROR = 3,
+};
+
+// the records waiting for the writer, a power of two
+const size_t LOG_BUFFER_CAPACITY = 8192;
+
+// accepts debug, info, warning and error
+LOG_LEVEL parseLogLevel(const std::string &name);
+
+// a key of a structured record, the keys are expected to be literals
+struct LogField {
+  const char *key;
+  std::string value;
+
+  LogField(const char *key, std::string value)
+      : key(key), value(std::move(value)) {
+  }
+  LogField(const char *key, const char *value) : key(key), value(value) {
+  }
+  template <
+      typename Number,
+      typename = std::enable_if_t<std::is_arithmetic<Number>::value>>
+  LogField(const char *key, const Number value)
+      : key(key), value(std::to_string(value)) {
+  }
+};
+
+struct LoggerConfig {
+  LOG_LEVEL level = LOG_LEVEL::INFO;
+  // only one of this many debug and info records is kept, the warnings and
+  // the errors aren't sampled
+  size_t sampleEvery = 1;
+  // the debug and info records accepted within a second, above it they're
+  // dropped, the warnings and the errors aren't limited, 0 disables the limit
+  size_t maxRecordsPerSecond = 1000;
+  // the request and response payloads are redacted unless this is set
+  bool logPayloads = false;
+};
+
+/**
+ * Writes structured records (a message and key=value fields, in the logfmt
+ * format) without blocking the threads which log. A record is moved into a
+ * lock-free ring buffer and a background thread formats and writes the
+ * records in batches, with one flush of the output per batch. The records
+ * which don't fit in the buffer or exceed the rate limit are dropped, the
+ * writer reports how many got lost.
+ */
+class Logger {
+  struct Record {
+    std::chrono::system_clock::time_point time;
+    LOG_LEVEL level;
+    std::string message;
+    std::vector<LogField> fields;
+  };
+
+  std::ostream &output;
+  RingBuffer<Record> records;
+
+  std::atomic<LOG_LEVEL> level{LOG_LEVEL::INFO};
+  std::atomic<size_t> sampleEvery{1};
+  std::atomic<size_t> maxRecordsPerSecond{0};
+  std::atomic<bool> logPayloads{false};
+
+  std::atomic<uint64_t> sampleCounter{0};
+  // the second the rate is counted for and the records accepted in it
+  std::atomic<int64_t> rateSecond{0};
+  std::atomic<uint64_t> rateCounter{0};
+  // dropped since the writer reported the previous drops
+  std::atomic<uint64_t> unreportedDrops{0};
+  Counter &bufferFullDrops;
+  Counter &rateLimitDrops;
+
+  std::atomic<uint64_t> flushRequests{0};
+  std::atomic<uint64_t> completedFlushes{0};
+  std::atomic<bool> stopped{false};
+  std::thread writer;
+
+  bool isSampled(const LOG_LEVEL level);
+  bool isWithinRate(const LOG_LEVEL level);
+  void run();
+  size_t writeRecords(std::string &batch);
+
+public:
+  static Logger &getInstance();
+
+  Logger(
+      std::ostream &output,
+      const LoggerConfig &config = LoggerConfig(),
+      const size_t capacity = LOG_BUFFER_CAPACITY);
+  // writes the records still in the buffer
+  ~Logger();
+  Logger(const Logger &) = delete;
+  Logger &operator=(const Logger &) = delete;
+
+  void configure(const LoggerConfig &config);
+  // lets the callers skip building fields which would be filtered anyway
+  bool isEnabled(const LOG_LEVEL level) const;
+  // the data itself only when the payloads are logged, its size otherwise
+  std::string payload(const std::string &data) const;
+
+  void log(
+      const LOG_LEVEL level,
+      std::string message,
+      std::vector<LogField> fields = {});
+  void debug(std::string message, std::vector<LogField> fields = {});
+  void info(std::string message, std::vector<LogField> fields = {});
+  void warning(std::string message, std::vector<LogField> fields = {});
+  void error(std::string message, std::vector<LogField> fields = {});
+
+  // waits until the records logged before it are written
+  void flush();
+};
+
+} // namespace network
+} // namespace comm
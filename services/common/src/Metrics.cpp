@@ -0,0 +1,248 @@
+#include "Metrics.h"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+namespace comm {
+namespace network {
+
+namespace {
+
+std::string escapeLabelValue(const std::string &value) {
+  std::string result;
+  result.reserve(value.size());
+  for (const char c : value) {
+    if (c == '\\' || c == '"') {
+      result += '\\';
+      result += c;
+    } else if (c == '\n') {
+      result += "\\n";
+    } else {
+      result += c;
+    }
+  }
+  return result;
+}
+
+// the labels without the braces, so more of them can be appended
+std::string renderLabels(const MetricLabels &labels) {
+  std::string result;
+  for (const auto &label : labels) {
+    if (!result.empty()) {
+      result += ',';
+    }
+    result += label.first + "=\"" + escapeLabelValue(label.second) + "\"";
+  }
+  return result;
+}
+
+std::string withBraces(const std::string &labels) {
+  return labels.empty() ? "" : "{" + labels + "}";
+}
+
+} // namespace
+
+void Counter::increment(const uint64_t amount) {
+  this->value.fetch_add(amount, std::memory_order_relaxed);
+}
+
+uint64_t Counter::get() const {
+  return this->value.load(std::memory_order_relaxed);
+}
+
+void Gauge::set(const int64_t value) {
+  this->value.store(value, std::memory_order_relaxed);
+}
+
+void Gauge::add(const int64_t amount) {
+  this->value.fetch_add(amount, std::memory_order_relaxed);
+}
+
+int64_t Gauge::get() const {
+  return this->value.load(std::memory_order_relaxed);
+}
+
+Histogram::Histogram(const std::vector<uint64_t> &bounds)
+    : bounds(bounds),
+      buckets(new std::atomic<uint64_t>[bounds.size() + 1]()) {
+  if (!std::is_sorted(this->bounds.begin(), this->bounds.end())) {
+    throw std::runtime_error("the histogram bounds have to be sorted");
+  }
+}
+
+void Histogram::observe(const uint64_t value) {
+  // a bucket counts the values up to its bound, inclusive
+  const size_t bucket =
+      std::lower_bound(this->bounds.begin(), this->bounds.end(), value) -
+      this->bounds.begin();
+  this->buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+  this->count.fetch_add(1, std::memory_order_relaxed);
+  this->sum.fetch_add(value, std::memory_order_relaxed);
+}
+
+void Histogram::observeSince(
+    const std::chrono::steady_clock::time_point start) {
+  this->observe(std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - start)
+                    .count());
+}
+
+const std::vector<uint64_t> &Histogram::getBounds() const {
+  return this->bounds;
+}
+
+std::vector<uint64_t> Histogram::getBuckets() const {
+  std::vector<uint64_t> result(this->bounds.size() + 1);
+  for (size_t i = 0; i < result.size(); ++i) {
+    result[i] = this->buckets[i].load(std::memory_order_relaxed);
+  }
+  return result;
+}
+
+uint64_t Histogram::getCount() const {
+  return this->count.load(std::memory_order_relaxed);
+}
+
+uint64_t Histogram::getSum() const {
+  return this->sum.load(std::memory_order_relaxed);
+}
+
+MetricsRegistry &MetricsRegistry::getInstance() {
+  static MetricsRegistry instance;
+  return instance;
+}
+
+MetricsRegistry::Family &MetricsRegistry::getFamily(
+    const std::string &name,
+    const std::string &help,
+    const Type type) {
+  auto it = this->families.find(name);
+  if (it == this->families.end()) {
+    it = this->families.emplace(name, Family()).first;
+    it->second.type = type;
+    it->second.help = help;
+  } else if (it->second.type != type) {
+    throw std::runtime_error(
+        "metric " + name + " is already registered with another type");
+  }
+  return it->second;
+}
+
+Counter &MetricsRegistry::getCounter(
+    const std::string &name,
+    const std::string &help,
+    const MetricLabels &labels) {
+  std::lock_guard<std::mutex> lock(this->mutex);
+  std::unique_ptr<Counter> &counter =
+      this->getFamily(name, help, Type::COUNTER).counters[renderLabels(labels)];
+  if (counter == nullptr) {
+    counter = std::make_unique<Counter>();
+  }
+  return *counter;
+}
+
+Gauge &MetricsRegistry::getGauge(
+    const std::string &name,
+    const std::string &help,
+    const MetricLabels &labels) {
+  std::lock_guard<std::mutex> lock(this->mutex);
+  std::unique_ptr<Gauge> &gauge =
+      this->getFamily(name, help, Type::GAUGE).gauges[renderLabels(labels)];
+  if (gauge == nullptr) {
+    gauge = std::make_unique<Gauge>();
+  }
+  return *gauge;
+}
+
+Histogram &MetricsRegistry::getHistogram(
+    const std::string &name,
+    const std::string &help,
+    const std::vector<uint64_t> &bounds,
+    const MetricLabels &labels) {
+  std::lock_guard<std::mutex> lock(this->mutex);
+  std::unique_ptr<Histogram> &histogram =
+      this->getFamily(name, help, Type::HISTOGRAM)
+          .histograms[renderLabels(labels)];
+  if (histogram == nullptr) {
+    histogram = std::make_unique<Histogram>(bounds);
+  }
+  return *histogram;
+}
+
+std::string MetricsRegistry::render() {
+  std::ostringstream result;
+  std::lock_guard<std::mutex> lock(this->mutex);
+  for (const auto &item : this->families) {
+    const std::string &name = item.first;
+    const Family &family = item.second;
+    result << "# HELP " << name << " " << family.help << "\n";
+    switch (family.type) {
+      case Type::COUNTER:
+        result << "# TYPE " << name << " counter\n";
+        for (const auto &counter : family.counters) {
+          result << name << withBraces(counter.first) << " "
+                 << counter.second->get() << "\n";
+        }
+        break;
+      case Type::GAUGE:
+        result << "# TYPE " << name << " gauge\n";
+        for (const auto &gauge : family.gauges) {
+          result << name << withBraces(gauge.first) << " "
+                 << gauge.second->get() << "\n";
+        }
+        break;
+      case Type::HISTOGRAM:
+        result << "# TYPE " << name << " histogram\n";
+        for (const auto &histogram : family.histograms) {
+          const std::string prefix =
+              histogram.first.empty() ? "" : histogram.first + ",";
+          const std::vector<uint64_t> &bounds =
+              histogram.second->getBounds();
+          const std::vector<uint64_t> buckets =
+              histogram.second->getBuckets();
+          // the buckets are read one by one while being updated, the total
+          // is taken from them so the output stays consistent
+          uint64_t cumulative = 0;
+          for (size_t i = 0; i < bounds.size(); ++i) {
+            cumulative += buckets[i];
+            result << name << "_bucket{" << prefix << "le=\"" << bounds[i]
+                   << "\"} " << cumulative << "\n";
+          }
+          cumulative += buckets.back();
+          result << name << "_bucket{" << prefix << "le=\"+Inf\"} "
+                 << cumulative << "\n";
+          result << name << "_sum" << withBraces(histogram.first) << " "
+                 << histogram.second->getSum() << "\n";
+          result << name << "_count" << withBraces(histogram.first) << " "
+                 << cumulative << "\n";
+        }
+        break;
+    }
+  }
+  return result.str();
+}
+
+RpcMetrics::RpcMetrics(const std::string &service, const std::string &method)
+    : duration(MetricsRegistry::getInstance().getHistogram(
+          "comm_rpc_duration_microseconds",
+          "The time from receiving an RPC until it's finished.",
+          LATENCY_BUCKETS,
+          {{"service", service}, {"method", method}})),
+      failures(MetricsRegistry::getInstance().getCounter(
+          "comm_rpc_failures_total",
+          "The RPCs finished with an error.",
+          {{"service", service}, {"method", method}})) {
+}
+
+void RpcMetrics::record(
+    const std::chrono::steady_clock::time_point start,
+    const bool succeeded) {
+  this->duration.observeSince(start);
+  if (!succeeded) {
+    this->failures.increment();
+  }
+}
+
+} // namespace network
+} // namespace comm
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace comm {
+namespace network {
+
+using MetricLabels = std::vector<std::pair<std::string, std::string>>;
+
+// in microseconds, from a cached read to a slow storage request
+const std::vector<uint64_t> LATENCY_BUCKETS = {
+    100,
+    250,
+    500,
+    1000,
+    2500,
+    5000,
+    10000,
+    25000,
+    50000,
+    100000,
+    250000,
+    500000,
+    1000000,
+    2500000,
+    5000000,
+    10000000,
+};
+
+/**
+ * The metrics are updated with relaxed atomics only, without any lock, so
+ * recording one is cheap enough for every call of a hot path.
+ */
+class Counter {
+  std::atomic<uint64_t> value{0};
+
+public:
+  void increment(const uint64_t amount = 1);
+  uint64_t get() const;
+};
+
+class Gauge {
+  std::atomic<int64_t> value{0};
+
+public:
+  void set(const int64_t value);
+  void add(const int64_t amount);
+  int64_t get() const;
+};
+
+// the observations are counted in buckets with fixed upper bounds, the values
+// are integers in the unit named by the metric (microseconds, bytes...)
+class Histogram {
+  const std::vector<uint64_t> bounds;
+  // one more than the bounds, the last one counts the values above them all
+  std::unique_ptr<std::atomic<uint64_t>[]> buckets;
+  std::atomic<uint64_t> count{0};
+  std::atomic<uint64_t> sum{0};
+
+public:
+  Histogram(const std::vector<uint64_t> &bounds);
+
+  void observe(const uint64_t value);
+  void observeSince(const std::chrono::steady_clock::time_point start);
+  const std::vector<uint64_t> &getBounds() const;
+  // not cumulative, with the overflow bucket last
+  std::vector<uint64_t> getBuckets() const;
+  uint64_t getCount() const;
+  uint64_t getSum() const;
+};
+
+/**
+ * Keeps the metrics of the process and renders them in the Prometheus text
+ * format. Looking a metric up takes a lock, so the hot paths keep the
+ * references they get, the metrics live as long as the process.
+ */
+class MetricsRegistry {
+  enum class Type {
+    COUNTER,
+    GAUGE,
+    HISTOGRAM,
+  };
+
+  struct Family {
+    Type type;
+    std::string help;
+    // by the rendered labels, so the output is sorted
+    std::map<std::string, std::unique_ptr<Counter>> counters;
+    std::map<std::string, std::unique_ptr<Gauge>> gauges;
+    std::map<std::string, std::unique_ptr<Histogram>> histograms;
+  };
+
+  std::mutex mutex;
+  std::map<std::string, Family> families;
+
+  Family &
+  getFamily(const std::string &name, const std::string &help, const Type type);
+
+public:
+  static MetricsRegistry &getInstance();
+
+  Counter &getCounter(
+      const std::string &name,
+      const std::string &help,
+      const MetricLabels &labels = {});
+  Gauge &getGauge(
+      const std::string &name,
+      const std::string &help,
+      const MetricLabels &labels = {});
+  // the bounds of a histogram are fixed by its first lookup
+  Histogram &getHistogram(
+      const std::string &name,
+      const std::string &help,
+      const std::vector<uint64_t> &bounds = LATENCY_BUCKETS,
+      const MetricLabels &labels = {});
+
+  std::string render();
+};
+
+// the duration of the calls of a single RPC method and its failures
+class RpcMetrics {
+  Histogram &duration;
+  Counter &failures;
+
+public:
+  RpcMetrics(const std::string &service, const std::string &method);
+  void record(
+      const std::chrono::steady_clock::time_point start,
+      const bool succeeded);
+};
+
+} // namespace network
+} // namespace comm
@@ -0,0 +1,141 @@
+#include "MetricsServer.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+namespace comm {
+namespace network {
+
+namespace {
+
+// the accept loop checks for the shutdown this often
+const int POLL_INTERVAL_MS = 200;
+// a client that doesn't send its request in time is dropped
+const time_t REQUEST_TIMEOUT_S = 1;
+const size_t MAX_REQUEST_SIZE = 8192;
+
+void sendAll(const int connection, const std::string &data) {
+  size_t sent = 0;
+  while (sent < data.size()) {
+    const ssize_t result = send(
+        connection, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+    if (result <= 0) {
+      return;
+    }
+    sent += result;
+  }
+}
+
+} // namespace
+
+MetricsServer::MetricsServer(
+    const std::string &address,
+    const int port,
+    MetricsRegistry &registry)
+    : registry(registry) {
+  sockaddr_in socketAddress{};
+  socketAddress.sin_family = AF_INET;
+  socketAddress.sin_port = htons(port);
+  if (inet_pton(AF_INET, address.c_str(), &socketAddress.sin_addr) != 1) {
+    throw std::runtime_error("invalid metrics address " + address);
+  }
+  this->socket = ::socket(AF_INET, SOCK_STREAM, 0);
+  if (this->socket < 0) {
+    throw std::runtime_error(
+        std::string("metrics socket failed: ") + std::strerror(errno));
+  }
+  const int reuse = 1;
+  setsockopt(
+      this->socket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+  socklen_t length = sizeof(socketAddress);
+  if (bind(
+          this->socket,
+          reinterpret_cast<sockaddr *>(&socketAddress),
+          sizeof(socketAddress)) != 0 ||
+      listen(this->socket, 16) != 0 ||
+      getsockname(
+          this->socket,
+          reinterpret_cast<sockaddr *>(&socketAddress),
+          &length) != 0) {
+    const std::string error = std::strerror(errno);
+    close(this->socket);
+    throw std::runtime_error(
+        "metrics server can't listen on " + address + ":" +
+        std::to_string(port) + ": " + error);
+  }
+  this->port = ntohs(socketAddress.sin_port);
+  this->thread = std::thread([this]() { this->run(); });
+}
+
+MetricsServer::~MetricsServer() {
+  this->stopped = true;
+  this->thread.join();
+  close(this->socket);
+}
+
+int MetricsServer::getPort() const {
+  return this->port;
+}
+
+void MetricsServer::run() {
+  pollfd listening{this->socket, POLLIN, 0};
+  while (!this->stopped) {
+    if (poll(&listening, 1, POLL_INTERVAL_MS) <= 0) {
+      continue;
+    }
+    const int connection = accept(this->socket, nullptr, nullptr);
+    if (connection < 0) {
+      continue;
+    }
+    this->serve(connection);
+    close(connection);
+  }
+}
+
+void MetricsServer::serve(const int connection) {
+  timeval timeout{REQUEST_TIMEOUT_S, 0};
+  setsockopt(connection, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+  // only the request line matters, the headers are read and ignored
+  std::string request;
+  char buffer[1024];
+  while (request.find("\r\n\r\n") == std::string::npos &&
+         request.size() < MAX_REQUEST_SIZE) {
+    const ssize_t received = recv(connection, buffer, sizeof(buffer), 0);
+    if (received <= 0) {
+      return;
+    }
+    request.append(buffer, received);
+  }
+  const std::string requestLine = request.substr(0, request.find("\r\n"));
+
+  std::string status = "200 OK";
+  std::string body;
+  if (requestLine.compare(0, 13, "GET /metrics ") == 0) {
+    body = this->registry.render();
+  } else {
+    status = "404 Not Found";
+    body = "only GET /metrics is served\n";
+  }
+  sendAll(
+      connection,
+      "HTTP/1.1 " + status +
+          "\r\n"
+          "Content-Type: text/plain; version=0.0.4\r\n"
+          "Content-Length: " +
+          std::to_string(body.size()) +
+          "\r\n"
+          "Connection: close\r\n\r\n" +
+          body);
+}
+
+} // namespace network
+} // namespace comm
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Metrics.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+namespace comm {
+namespace network {
+
+/**
+ * Serves the metrics of the registry over plain HTTP (GET /metrics) on its
+ * own thread, one connection at a time, for a Prometheus scraper or curl.
+ * It's meant for a port reachable only from inside the deployment.
+ */
+class MetricsServer {
+  MetricsRegistry &registry;
+  int socket = -1;
+  int port = 0;
+  std::atomic<bool> stopped{false};
+  std::thread thread;
+
+  void run();
+  void serve(const int connection);
+
+public:
+  // the port 0 picks a free one, see getPort
+  MetricsServer(
+      const std::string &address,
+      const int port,
+      MetricsRegistry &registry = MetricsRegistry::getInstance());
+  ~MetricsServer();
+  MetricsServer(const MetricsServer &) = delete;
+  MetricsServer &operator=(const MetricsServer &) = delete;
+
+  int getPort() const;
+};
+
+} // namespace network
+} // namespace comm
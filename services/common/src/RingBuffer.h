@@ -0,0 +1,86 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace comm {
+namespace network {
+
+/**
+ * A bounded queue for many producers and a single consumer, without locks.
+ * Every slot carries a sequence number which tells whether it's free for the
+ * producer of a given position or published for the consumer, the producers
+ * only race for the tail position. When the buffer is full a push fails right
+ * away instead of waiting for the consumer.
+ */
+template <typename T> class RingBuffer {
+  struct Slot {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  const size_t mask;
+  std::unique_ptr<Slot[]> slots;
+  std::atomic<size_t> tail{0};
+  // keeps the producers' tail and the consumer's head on separate cache lines
+  char padding[64];
+  size_t head = 0;
+
+public:
+  // the capacity has to be a power of two
+  explicit RingBuffer(const size_t capacity)
+      : mask(capacity - 1), slots(new Slot[capacity]) {
+    if (capacity == 0 || (capacity & (capacity - 1)) != 0) {
+      throw std::runtime_error(
+          "the ring buffer capacity has to be a power of 2");
+    }
+    for (size_t i = 0; i < capacity; ++i) {
+      this->slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  RingBuffer(const RingBuffer &) = delete;
+  RingBuffer &operator=(const RingBuffer &) = delete;
+
+  bool push(T &&value) {
+    size_t position = this->tail.load(std::memory_order_relaxed);
+    Slot *slot;
+    while (true) {
+      slot = &this->slots[position & this->mask];
+      const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+      const ptrdiff_t difference = static_cast<ptrdiff_t>(sequence - position);
+      if (difference == 0) {
+        if (this->tail.compare_exchange_weak(
+                position, position + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (difference < 0) {
+        // the slot still holds the value pushed a whole lap ago
+        return false;
+      } else {
+        position = this->tail.load(std::memory_order_relaxed);
+      }
+    }
+    slot->value = std::move(value);
+    slot->sequence.store(position + 1, std::memory_order_release);
+    return true;
+  }
+
+  // may be called only from the consumer's thread
+  bool pop(T &value) {
+    Slot &slot = this->slots[this->head & this->mask];
+    if (slot.sequence.load(std::memory_order_acquire) != this->head + 1) {
+      return false;
+    }
+    value = std::move(slot.value);
+    slot.sequence.store(this->head + this->mask + 1, std::memory_order_release);
+    ++this->head;
+    return true;
+  }
+};
+
+} // namespace network
+} // namespace comm
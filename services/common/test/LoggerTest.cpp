@@ -0,0 +1,204 @@
+#include <gtest/gtest.h>
+
+#include "Logger.h"
+#include "RingBuffer.h"
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace comm::network;
+
+namespace {
+
+std::vector<std::string> getLines(const std::string &output) {
+  std::vector<std::string> lines;
+  std::stringstream stream(output);
+  std::string line;
+  while (std::getline(stream, line)) {
+    lines.push_back(line);
+  }
+  return lines;
+}
+
+// the line without the timestamp which precedes the level
+std::string withoutTime(const std::string &line) {
+  return line.substr(line.find(" level="));
+}
+
+} // namespace
+
+TEST(RingBufferTest, ConcurrentPushesAreNotLost) {
+  RingBuffer<size_t> buffer(1024);
+  const size_t threadsCount = 8;
+  const size_t pushesCount = 100000;
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < threadsCount; ++i) {
+    threads.emplace_back([&buffer, i]() {
+      for (size_t j = 0; j < pushesCount; ++j) {
+        size_t value = i * pushesCount + j;
+        while (!buffer.push(std::move(value))) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  // every producer's values come out in the order they were pushed
+  std::vector<size_t> next(threadsCount, 0);
+  size_t popped = 0;
+  size_t value;
+  while (popped < threadsCount * pushesCount) {
+    if (!buffer.pop(value)) {
+      std::this_thread::yield();
+      continue;
+    }
+    const size_t producer = value / pushesCount;
+    ASSERT_EQ(value % pushesCount, next[producer]);
+    ++next[producer];
+    ++popped;
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  EXPECT_FALSE(buffer.pop(value));
+}
+
+TEST(RingBufferTest, PushFailsWhenFull) {
+  RingBuffer<int> buffer(2);
+  EXPECT_TRUE(buffer.push(1));
+  EXPECT_TRUE(buffer.push(2));
+  EXPECT_FALSE(buffer.push(3));
+  int value;
+  EXPECT_TRUE(buffer.pop(value));
+  EXPECT_EQ(value, 1);
+  EXPECT_TRUE(buffer.push(3));
+  EXPECT_THROW(RingBuffer<int>(3), std::runtime_error);
+}
+
+TEST(LoggerTest, WritesStructuredRecords) {
+  std::ostringstream output;
+  Logger logger(output);
+  logger.info("SendLog", {{"user_id", "abc"}, {"bytes", 12}});
+  logger.error("storage failed", {{"error", "no \"such\" key\n"}, {"id", ""}});
+  logger.flush();
+
+  const std::vector<std::string> lines = getLines(output.str());
+  ASSERT_EQ(lines.size(), 2);
+  EXPECT_EQ(lines[0].compare(0, 5, "time="), 0);
+  EXPECT_EQ(
+      withoutTime(lines[0]), " level=info msg=SendLog user_id=abc bytes=12");
+  EXPECT_EQ(
+      withoutTime(lines[1]),
+      " level=error msg=\"storage failed\" "
+      "error=\"no \\\"such\\\" key\\n\" id=\"\"");
+}
+
+TEST(LoggerTest, RedactsPayloadsByDefault) {
+  std::ostringstream output;
+  Logger logger(output);
+  EXPECT_EQ(logger.payload("secret"), "<redacted 6 bytes>");
+  LoggerConfig config;
+  config.logPayloads = true;
+  logger.configure(config);
+  EXPECT_EQ(logger.payload("secret"), "secret");
+}
+
+TEST(LoggerTest, FiltersLevelsAndSamples) {
+  std::ostringstream output;
+  LoggerConfig config;
+  config.level = LOG_LEVEL::INFO;
+  config.sampleEvery = 10;
+  config.maxRecordsPerSecond = 0;
+  Logger logger(output, config);
+  EXPECT_FALSE(logger.isEnabled(LOG_LEVEL::DEBUG));
+  for (size_t i = 0; i < 100; ++i) {
+    logger.debug("skipped");
+    logger.info("sampled");
+    logger.warning("kept");
+  }
+  logger.flush();
+
+  size_t sampled = 0;
+  size_t kept = 0;
+  for (const std::string &line : getLines(output.str())) {
+    sampled += line.find("msg=sampled") != std::string::npos;
+    kept += line.find("msg=kept") != std::string::npos;
+    EXPECT_EQ(line.find("msg=skipped"), std::string::npos);
+  }
+  EXPECT_EQ(sampled, 10);
+  EXPECT_EQ(kept, 100);
+}
+
+TEST(LoggerTest, ReportsDroppedRecords) {
+  std::ostringstream output;
+  LoggerConfig config;
+  config.maxRecordsPerSecond = 0;
+  Logger logger(output, config, 4);
+  // logged faster than the writer wakes up, the buffer overflows
+  for (size_t i = 0; i < 1000; ++i) {
+    logger.info("record");
+  }
+  logger.flush();
+
+  size_t written = 0;
+  size_t reportedDrops = 0;
+  for (const std::string &line : getLines(output.str())) {
+    if (line.find("msg=record") != std::string::npos) {
+      ++written;
+    } else {
+      const size_t count = line.find(" count=");
+      ASSERT_NE(count, std::string::npos);
+      reportedDrops += std::stoul(line.substr(count + 7));
+    }
+  }
+  EXPECT_GE(written, 4);
+  EXPECT_EQ(written + reportedDrops, 1000);
+}
+
+TEST(LoggerTest, LimitsTheRate) {
+  std::ostringstream output;
+  LoggerConfig config;
+  config.maxRecordsPerSecond = 5;
+  Logger logger(output, config);
+  for (size_t i = 0; i < 100; ++i) {
+    logger.info("record");
+  }
+  logger.flush();
+
+  const std::string text = output.str();
+  size_t written = 0;
+  for (size_t position = text.find("msg=record"); position != std::string::npos;
+       position = text.find("msg=record", position + 1)) {
+    ++written;
+  }
+  // a second may pass while logging, the next one has its own limit
+  EXPECT_GE(written, 5);
+  EXPECT_LE(written, 10);
+  EXPECT_NE(text.find("msg=\"log records dropped\""), std::string::npos);
+}
+
+TEST(LoggerTest, DoesNotLimitWarningsAndErrors) {
+  std::ostringstream output;
+  LoggerConfig config;
+  config.maxRecordsPerSecond = 5;
+  Logger logger(output, config);
+  for (size_t i = 0; i < 100; ++i) {
+    logger.info("record");
+    if (i % 10 == 0) {
+      logger.warning("warning");
+      logger.error("error");
+    }
+  }
+  logger.flush();
+
+  const std::string text = output.str();
+  size_t written = 0;
+  for (const char *message : {"msg=warning", "msg=error"}) {
+    for (size_t position = text.find(message); position != std::string::npos;
+         position = text.find(message, position + 1)) {
+      ++written;
+    }
+  }
+  EXPECT_EQ(written, 20);
+}
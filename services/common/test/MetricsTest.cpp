@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+
+#include "Metrics.h"
+#include "MetricsServer.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace comm::network;
+
+class MetricsTest : public testing::Test {
+protected:
+  MetricsRegistry registry;
+
+  // sends the request line to the server and returns the whole response
+  std::string get(const int port, const std::string &path) {
+    const int connection = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    inet_pton(AF_INET, "127.0.0.1", &address.sin_addr);
+    if (connect(
+            connection,
+            reinterpret_cast<sockaddr *>(&address),
+            sizeof(address)) != 0) {
+      close(connection);
+      throw std::runtime_error("can't connect to the metrics server");
+    }
+    const std::string request = "GET " + path + " HTTP/1.1\r\n\r\n";
+    send(connection, request.data(), request.size(), 0);
+    std::string response;
+    char buffer[1024];
+    ssize_t received;
+    while ((received = recv(connection, buffer, sizeof(buffer), 0)) > 0) {
+      response.append(buffer, received);
+    }
+    close(connection);
+    return response;
+  }
+};
+
+TEST_F(MetricsTest, ConcurrentUpdatesAreNotLost) {
+  Counter &counter = this->registry.getCounter("test_total", "test");
+  Histogram &histogram =
+      this->registry.getHistogram("test_duration", "test", {10, 100});
+  const size_t threadsCount = 8;
+  const size_t updatesCount = 100000;
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < threadsCount; ++i) {
+    threads.emplace_back([&]() {
+      for (size_t j = 0; j < updatesCount; ++j) {
+        counter.increment();
+        histogram.observe(j % 200);
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(counter.get(), threadsCount * updatesCount);
+  EXPECT_EQ(histogram.getCount(), threadsCount * updatesCount);
+  EXPECT_EQ(
+      histogram.getBuckets(),
+      std::vector<uint64_t>(
+          {threadsCount * updatesCount / 200 * 11,
+           threadsCount * updatesCount / 200 * 90,
+           threadsCount * updatesCount / 200 * 99}));
+}
+
+TEST_F(MetricsTest, SameNameAndLabelsGiveTheSameMetric) {
+  Counter &first = this->registry.getCounter("requests", "", {{"a", "1"}});
+  Counter &second = this->registry.getCounter("requests", "", {{"a", "1"}});
+  Counter &other = this->registry.getCounter("requests", "", {{"a", "2"}});
+  EXPECT_EQ(&first, &second);
+  EXPECT_NE(&first, &other);
+  EXPECT_THROW(this->registry.getGauge("requests", ""), std::runtime_error);
+}
+
+TEST_F(MetricsTest, RendersThePrometheusFormat) {
+  this->registry.getCounter("requests_total", "Requests.", {{"method", "A"}})
+      .increment(3);
+  this->registry.getGauge("queue_depth", "Queued tasks.").set(-2);
+  Histogram &histogram = this->registry.getHistogram(
+      "latency", "Latency.", {10, 100}, {{"path", "a\"b"}});
+  histogram.observe(5);
+  histogram.observe(50);
+  histogram.observe(500);
+
+  EXPECT_EQ(
+      this->registry.render(),
+      "# HELP latency Latency.\n"
+      "# TYPE latency histogram\n"
+      "latency_bucket{path=\"a\\\"b\",le=\"10\"} 1\n"
+      "latency_bucket{path=\"a\\\"b\",le=\"100\"} 2\n"
+      "latency_bucket{path=\"a\\\"b\",le=\"+Inf\"} 3\n"
+      "latency_sum{path=\"a\\\"b\"} 555\n"
+      "latency_count{path=\"a\\\"b\"} 3\n"
+      "# HELP queue_depth Queued tasks.\n"
+      "# TYPE queue_depth gauge\n"
+      "queue_depth -2\n"
+      "# HELP requests_total Requests.\n"
+      "# TYPE requests_total counter\n"
+      "requests_total{method=\"A\"} 3\n");
+}
+
+TEST_F(MetricsTest, ServerServesTheMetrics) {
+  this->registry.getCounter("served_total", "Served.").increment();
+  MetricsServer server("127.0.0.1", 0, this->registry);
+
+  const std::string response = this->get(server.getPort(), "/metrics");
+  EXPECT_EQ(response.compare(0, 15, "HTTP/1.1 200 OK"), 0);
+  EXPECT_NE(response.find("\r\n\r\n# HELP served_total"), std::string::npos);
+  EXPECT_NE(response.find("served_total 1\n"), std::string::npos);
+
+  const std::string missing = this->get(server.getPort(), "/other");
+  EXPECT_EQ(missing.compare(0, 22, "HTTP/1.1 404 Not Found"), 0);
+}
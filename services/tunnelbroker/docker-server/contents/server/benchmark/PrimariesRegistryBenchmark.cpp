@@ -0,0 +1,160 @@
+#include "PrimariesRegistry.h"
+
+#include <malloc.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace comm::network;
+
+// every heap allocation is counted so the registry's footprint can be measured
+// precisely, including the allocator's rounding
+std::atomic<size_t> allocatedBytes{0};
+
+void *operator new(size_t size) {
+  void *pointer = std::malloc(size);
+  if (pointer == nullptr) {
+    throw std::bad_alloc();
+  }
+  allocatedBytes += malloc_usable_size(pointer);
+  return pointer;
+}
+
+void operator delete(void *pointer) noexcept {
+  if (pointer != nullptr) {
+    allocatedBytes -= malloc_usable_size(pointer);
+  }
+  std::free(pointer);
+}
+
+void operator delete(void *pointer, size_t) noexcept {
+  operator delete(pointer);
+}
+
+std::string getUserId(const size_t i) {
+  return std::to_string(100000 + i);
+}
+
+// the length of an APNs device token
+std::string getDeviceToken(const size_t i) {
+  std::string token = std::to_string(i);
+  token.resize(64, 'f');
+  return token;
+}
+
+void measureMemory(const size_t devicesCount) {
+  const size_t before = allocatedBytes;
+  std::unique_ptr<PrimariesRegistry> registry =
+      std::make_unique<PrimariesRegistry>();
+  for (size_t i = 0; i < devicesCount; ++i) {
+    registry->becomePrimary(getUserId(i), getDeviceToken(i));
+  }
+  const size_t idle = allocatedBytes - before;
+
+  // a check that has to ping the device allocates its ping state
+  for (size_t i = 0; i < devicesCount; ++i) {
+    registry->check(
+        getUserId(i),
+        "other",
+        std::chrono::milliseconds(0),
+        [](ping::ClientState) {});
+    registry->markSeen(getUserId(i), getDeviceToken(i));
+  }
+  const size_t pinged = allocatedBytes - before;
+
+  std::cout << "registered devices: " << devicesCount << std::endl;
+  std::cout << "bytes per idle device: " << idle / devicesCount << std::endl;
+  std::cout << "bytes per pinged device: " << pinged / devicesCount
+            << std::endl;
+}
+
+// every thread checks random users from another device, a tenth of the
+// operations are pongs that write to the registry
+void measureLookups(const size_t devicesCount) {
+  const size_t operationsPerThread = 1000000;
+  PrimariesRegistry registry;
+  std::vector<std::string> ids;
+  std::vector<std::string> tokens;
+  for (size_t i = 0; i < devicesCount; ++i) {
+    ids.push_back(getUserId(i));
+    tokens.push_back(getDeviceToken(i));
+    registry.becomePrimary(ids[i], tokens[i]);
+    registry.markSeen(ids[i], tokens[i]);
+  }
+
+  std::cout << std::setw(10) << "threads" << std::setw(16) << "lookups/s"
+            << std::endl;
+  for (const size_t threadsCount : {1, 4, 16}) {
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < threadsCount; ++i) {
+      threads.emplace_back([&, i]() {
+        std::mt19937_64 random(i);
+        for (size_t j = 0; j < operationsPerThread; ++j) {
+          const size_t device = random() % devicesCount;
+          if (j % 10 == 0) {
+            registry.markSeen(ids[device], tokens[device]);
+            continue;
+          }
+          registry.check(
+              ids[device],
+              "other",
+              std::chrono::hours(1),
+              [](ping::ClientState) {});
+        }
+      });
+    }
+    for (std::thread &thread : threads) {
+      thread.join();
+    }
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    std::cout << std::setw(10) << threadsCount << std::setw(16) << std::fixed
+              << std::setprecision(0)
+              << threadsCount * operationsPerThread / elapsed.count()
+              << std::endl;
+  }
+}
+
+// a restarted instance warms up by loading the snapshot
+void measureSnapshot(const size_t devicesCount) {
+  const std::string path = "/tmp/comm-primaries-benchmark.snapshot";
+  PrimariesRegistry registry;
+  for (size_t i = 0; i < devicesCount; ++i) {
+    registry.becomePrimary(getUserId(i), getDeviceToken(i));
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  registry.saveSnapshot(path);
+  const std::chrono::duration<double, std::milli> saved =
+      std::chrono::steady_clock::now() - start;
+
+  PrimariesRegistry restored;
+  start = std::chrono::steady_clock::now();
+  restored.loadSnapshot(path);
+  const std::chrono::duration<double, std::milli> loaded =
+      std::chrono::steady_clock::now() - start;
+
+  std::cout << std::fixed << std::setprecision(0)
+            << "snapshot saved in: " << saved.count() << "ms" << std::endl;
+  std::cout << "snapshot loaded in: " << loaded.count() << "ms" << std::endl;
+  std::remove(path.c_str());
+}
+
+int main(int argc, char **argv) {
+  const size_t devicesCount = 1000000;
+  measureMemory(devicesCount);
+  measureLookups(devicesCount);
+  measureSnapshot(devicesCount);
+  return 0;
+}
@@ -0,0 +1,623 @@
+#include "Timer.h"
+#include "Tools.h"
+#include "TunnelBrokerServiceImpl.h"
+
+#include <grpcpp/grpcpp.h>
+
+#include "../_generated/tunnelbroker.grpc.pb.h"
+#include "../_generated/tunnelbroker.pb.h"
+
+#include <signal.h>
+#include <sys/prctl.h>
+#include <sys/resource.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Simulates a population of primary devices and measures how fast the
+ * tunnelbroker answers the checks of their users' other devices.
+ *
+ * Every simulated device registers with BecomeNewPrimaryDevice and then either
+ * keeps a device channel open, answering the pings pushed through it with the
+ * configured latency and drop rate, or (a share of them) only sends periodic
+ * SendPong heartbeats like the devices without a channel. The checks are sent
+ * at a fixed rate regardless of how fast they're answered, so the latency of a
+ * check is measured from the moment it should have been sent and a stalled
+ * server can't hide its stalls by slowing the load down.
+ *
+ * Without --target a server is started in a child process (after forking,
+ * before gRPC is initialized) and its threads and CPU time are reported. A
+ * server started elsewhere on the same host can be measured with --server_pid.
+ *
+ * Usage: TunnelBrokerLoadGenerator [--name=value...], see Options for the
+ * names and the defaults.
+ */
+
+using namespace comm::network;
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+  // the server to load, empty starts one in a child process
+  std::string target;
+  // the process of the server, to report its threads and CPU usage
+  pid_t serverPid = 0;
+  size_t devices = 1000;
+  // the checks per second of all the devices together
+  double rate = 2000;
+  uint64_t durationS = 10;
+  uint64_t pongLatencyMs = 0;
+  // the share of the pings that are never answered
+  double dropRate = 0;
+  // the share of the devices sending SendPong heartbeats without a channel
+  double sendPongShare = 0;
+  uint64_t sendPongIntervalMs = 1000;
+  // used by the server started here
+  uint64_t livenessTtlMs = DEFAULT_LIVENESS_TTL.count();
+};
+
+Options parseOptions(int argc, char **argv) {
+  std::map<std::string, std::string> values;
+  for (int i = 1; i < argc; ++i) {
+    const std::string argument = argv[i];
+    const size_t separator = argument.find('=');
+    if (argument.compare(0, 2, "--") != 0 || separator == std::string::npos) {
+      throw std::runtime_error("expected --name=value, got " + argument);
+    }
+    values[argument.substr(2, separator - 2)] =
+        argument.substr(separator + 1);
+  }
+
+  Options options;
+  auto take = [&values](const std::string &name, auto &option) {
+    auto it = values.find(name);
+    if (it == values.end()) {
+      return;
+    }
+    std::istringstream stream(it->second);
+    if (!(stream >> option) || !stream.eof()) {
+      throw std::runtime_error("invalid value of --" + name);
+    }
+    values.erase(it);
+  };
+  take("target", options.target);
+  take("server_pid", options.serverPid);
+  take("devices", options.devices);
+  take("rate", options.rate);
+  take("duration_s", options.durationS);
+  take("pong_latency_ms", options.pongLatencyMs);
+  take("drop_rate", options.dropRate);
+  take("send_pong_share", options.sendPongShare);
+  take("send_pong_interval_ms", options.sendPongIntervalMs);
+  take("liveness_ttl_ms", options.livenessTtlMs);
+  if (!values.empty()) {
+    throw std::runtime_error("unknown option --" + values.begin()->first);
+  }
+  if (options.devices == 0 || options.rate <= 0) {
+    throw std::runtime_error("--devices and --rate have to be positive");
+  }
+  return options;
+}
+
+std::string getUserId(const size_t i) {
+  return "load-user-" + std::to_string(i);
+}
+
+std::string getDeviceToken(const size_t i) {
+  return "load-device-" + std::to_string(i);
+}
+
+// the server runs in its own process so its threads and CPU time can be told
+// apart from the load generator's, the chosen port is sent through the pipe
+pid_t startServer(const Options &options, std::string &address) {
+  int fds[2];
+  if (pipe(fds) != 0) {
+    throw std::runtime_error("pipe failed");
+  }
+  const pid_t pid = fork();
+  if (pid < 0) {
+    throw std::runtime_error("fork failed");
+  }
+  if (pid == 0) {
+    prctl(PR_SET_PDEATHSIG, SIGKILL);
+    close(fds[0]);
+    TunnelBrokerServiceImpl service(
+        std::chrono::milliseconds(options.livenessTtlMs));
+    int port = 0;
+    grpc::ServerBuilder builder;
+    builder.AddListeningPort(
+        "127.0.0.1:0", grpc::InsecureServerCredentials(), &port);
+    builder.RegisterService(&service);
+    std::unique_ptr<grpc::Server> server(builder.BuildAndStart());
+    if (write(fds[1], &port, sizeof(port)) != sizeof(port)) {
+      std::_Exit(1);
+    }
+    close(fds[1]);
+    server->Wait();
+    std::_Exit(0);
+  }
+  close(fds[1]);
+  int port = 0;
+  const ssize_t received = read(fds[0], &port, sizeof(port));
+  close(fds[0]);
+  if (received != sizeof(port) || port == 0) {
+    throw std::runtime_error("the server didn't start");
+  }
+  address = "127.0.0.1:" + std::to_string(port);
+  return pid;
+}
+
+struct ProcessUsage {
+  double cpuSeconds = 0;
+  size_t threads = 0;
+};
+
+// reads utime, stime and num_threads from /proc/<pid>/stat
+bool readProcessUsage(const pid_t pid, ProcessUsage &usage) {
+  std::ifstream file("/proc/" + std::to_string(pid) + "/stat");
+  std::string stat;
+  if (!std::getline(file, stat)) {
+    return false;
+  }
+  // the command name may contain spaces, the fields are counted after it
+  std::istringstream stream(stat.substr(stat.rfind(')') + 2));
+  std::vector<std::string> fields;
+  std::string field;
+  while (stream >> field) {
+    fields.push_back(field);
+  }
+  if (fields.size() < 18) {
+    return false;
+  }
+  const double ticks = sysconf(_SC_CLK_TCK);
+  usage.cpuSeconds =
+      (std::stoull(fields[11]) + std::stoull(fields[12])) / ticks;
+  usage.threads = std::stoull(fields[17]);
+  return true;
+}
+
+// samples the server process while the load runs
+class UsageSampler {
+  const pid_t pid;
+  std::atomic<bool> stopped{false};
+  std::thread thread;
+
+public:
+  ProcessUsage start;
+  ProcessUsage end;
+  size_t peakThreads = 0;
+  bool available = false;
+
+  UsageSampler(const pid_t pid) : pid(pid) {
+    if (pid == 0 || !readProcessUsage(pid, this->start)) {
+      return;
+    }
+    this->available = true;
+    this->peakThreads = this->start.threads;
+    this->thread = std::thread([this]() {
+      ProcessUsage usage;
+      while (!this->stopped) {
+        if (readProcessUsage(this->pid, usage)) {
+          this->peakThreads = std::max(this->peakThreads, usage.threads);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      }
+    });
+  }
+
+  void stop() {
+    if (!this->available) {
+      return;
+    }
+    this->stopped = true;
+    this->thread.join();
+    readProcessUsage(this->pid, this->end);
+    this->peakThreads = std::max(this->peakThreads, this->end.threads);
+  }
+};
+
+/**
+ * A primary device keeping its channel open. The pings are read on gRPC's
+ * threads and the delayed pongs are written from the timer, a hold keeps the
+ * stream alive until the device is closed so such writes stay valid.
+ */
+class SimulatedDevice : public grpc::ClientBidiReactor<
+                            tunnelbroker::DeviceMessage,
+                            tunnelbroker::ServerMessage> {
+  const Options &options;
+  Timer &timer;
+  grpc::ClientContext context;
+  tunnelbroker::DeviceMessage hello;
+  tunnelbroker::DeviceMessage pong;
+  tunnelbroker::ServerMessage message;
+  // only used from the read callbacks
+  std::mt19937_64 random;
+
+  std::mutex mutex;
+  std::condition_variable condition;
+  bool writing = false;
+  size_t pongsPending = 0;
+  bool closing = false;
+  bool released = false;
+  bool done = false;
+
+  // has to be called with the mutex locked
+  void writeOrRelease() {
+    if (this->writing) {
+      return;
+    }
+    if (this->closing) {
+      if (!this->released) {
+        this->released = true;
+        this->RemoveHold();
+      }
+      return;
+    }
+    if (this->pongsPending > 0) {
+      --this->pongsPending;
+      this->writing = true;
+      this->StartWrite(&this->pong);
+    }
+  }
+
+  void sendPong() {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    ++this->pongsPending;
+    this->writeOrRelease();
+  }
+
+public:
+  std::atomic<size_t> pings{0};
+  std::atomic<size_t> dropped{0};
+
+  SimulatedDevice(
+      tunnelbroker::TunnelBrokerService::Stub &stub,
+      const Options &options,
+      Timer &timer,
+      const size_t i)
+      : options(options), timer(timer), random(i) {
+    this->hello.mutable_hello()->set_userid(getUserId(i));
+    this->hello.mutable_hello()->set_devicetoken(getDeviceToken(i));
+    this->pong.mutable_pong();
+    stub.async()->OpenDeviceChannel(&this->context, this);
+    this->writing = true;
+    this->StartWrite(&this->hello);
+    this->StartRead(&this->message);
+    this->AddHold();
+    this->StartCall();
+  }
+
+  void close() {
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->closing = true;
+      this->writeOrRelease();
+    }
+    this->context.TryCancel();
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->condition.wait(lock, [this]() { return this->done; });
+  }
+
+  void OnReadDone(bool ok) override {
+    if (!ok) {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->closing = true;
+      this->writeOrRelease();
+      return;
+    }
+    if (this->message.has_ping()) {
+      ++this->pings;
+      if (std::uniform_real_distribution<double>()(this->random) <
+          this->options.dropRate) {
+        ++this->dropped;
+      } else if (this->options.pongLatencyMs == 0) {
+        this->sendPong();
+      } else {
+        this->timer.schedule(
+            std::chrono::milliseconds(this->options.pongLatencyMs),
+            [this]() { this->sendPong(); });
+      }
+    }
+    this->StartRead(&this->message);
+  }
+
+  void OnWriteDone(bool ok) override {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->writing = false;
+    if (!ok) {
+      this->closing = true;
+    }
+    this->writeOrRelease();
+  }
+
+  void OnDone(const grpc::Status &) override {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->done = true;
+    this->condition.notify_all();
+  }
+};
+
+// the latencies of the finished checks, in microseconds
+struct CheckResults {
+  Clock::time_point start;
+  Clock::time_point sent;
+  Clock::time_point answered;
+  std::mutex mutex;
+  std::vector<uint64_t> latencies;
+  std::map<tunnelbroker::CheckResponseType, size_t> responses;
+  size_t errors = 0;
+};
+
+struct CheckCall {
+  grpc::ClientContext context;
+  tunnelbroker::CheckRequest request;
+  tunnelbroker::CheckResponse response;
+  Clock::time_point scheduled;
+};
+
+void registerDevices(
+    tunnelbroker::TunnelBrokerService::Stub &stub,
+    const size_t devices) {
+  const size_t threadsCount = 8;
+  std::atomic<size_t> failures{0};
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < threadsCount; ++t) {
+    threads.emplace_back([&, t]() {
+      for (size_t i = t; i < devices; i += threadsCount) {
+        grpc::ClientContext context;
+        tunnelbroker::NewPrimaryRequest request;
+        tunnelbroker::NewPrimaryResponse response;
+        request.set_userid(getUserId(i));
+        request.set_devicetoken(getDeviceToken(i));
+        if (!stub.BecomeNewPrimaryDevice(&context, request, &response).ok() ||
+            !response.success()) {
+          ++failures;
+        }
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  if (failures > 0) {
+    throw std::runtime_error(
+        std::to_string(failures) + " devices failed to register");
+  }
+}
+
+// the devices without a channel are only seen when they send a pong
+void sendPongs(
+    tunnelbroker::TunnelBrokerService::Stub &stub,
+    const Options &options,
+    const size_t firstDevice,
+    const std::atomic<bool> &stopped) {
+  struct PongCall {
+    grpc::ClientContext context;
+    tunnelbroker::PongRequest request;
+    google::protobuf::Empty response;
+  };
+  std::atomic<size_t> inFlight{0};
+  Clock::time_point next = Clock::now();
+  while (!stopped) {
+    for (size_t i = firstDevice; i < options.devices; ++i) {
+      PongCall *call = new PongCall();
+      call->request.set_userid(getUserId(i));
+      call->request.set_devicetoken(getDeviceToken(i));
+      ++inFlight;
+      stub.async()->SendPong(
+          &call->context,
+          &call->request,
+          &call->response,
+          [call, &inFlight](grpc::Status) {
+            delete call;
+            --inFlight;
+          });
+    }
+    next += std::chrono::milliseconds(options.sendPongIntervalMs);
+    std::this_thread::sleep_until(next);
+  }
+  while (inFlight > 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+}
+
+// the checks are sent on schedule, even if the previous ones aren't answered,
+// returns when all of them are answered
+void sendChecks(
+    tunnelbroker::TunnelBrokerService::Stub &stub,
+    const Options &options,
+    CheckResults &results) {
+  results.start = Clock::now();
+  const size_t checksCount = options.rate * options.durationS;
+  const std::chrono::duration<double> interval(1 / options.rate);
+  std::atomic<size_t> inFlight{0};
+  std::mt19937_64 random(0);
+  for (size_t i = 0; i < checksCount; ++i) {
+    const Clock::time_point scheduled =
+        results.start +
+        std::chrono::duration_cast<Clock::duration>(interval * i);
+    std::this_thread::sleep_until(scheduled);
+
+    CheckCall *call = new CheckCall();
+    call->request.set_userid(getUserId(random() % options.devices));
+    call->request.set_devicetoken("load-checking-device");
+    call->scheduled = scheduled;
+    ++inFlight;
+    stub.async()->CheckIfPrimaryDeviceOnline(
+        &call->context,
+        &call->request,
+        &call->response,
+        [call, &results, &inFlight](grpc::Status status) {
+          const uint64_t latency =
+              std::chrono::duration_cast<std::chrono::microseconds>(
+                  Clock::now() - call->scheduled)
+                  .count();
+          {
+            std::lock_guard<std::mutex> lock(results.mutex);
+            if (status.ok()) {
+              results.latencies.push_back(latency);
+              ++results.responses[call->response.checkresponsetype()];
+            } else {
+              ++results.errors;
+            }
+          }
+          delete call;
+          --inFlight;
+        });
+  }
+  results.sent = Clock::now();
+  while (inFlight > 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  results.answered = Clock::now();
+}
+
+double getPercentile(const std::vector<uint64_t> &sorted, const double p) {
+  if (sorted.empty()) {
+    return 0;
+  }
+  const size_t rank = std::ceil(p * sorted.size());
+  return sorted[std::max<size_t>(rank, 1) - 1] / 1000.0;
+}
+
+void run(const Options &options) {
+  std::string target = options.target;
+  pid_t serverPid = options.serverPid;
+  pid_t childPid = 0;
+  if (target.empty()) {
+    childPid = serverPid = startServer(options, target);
+  }
+
+  std::shared_ptr<grpc::Channel> channel =
+      grpc::CreateChannel(target, grpc::InsecureChannelCredentials());
+  std::unique_ptr<tunnelbroker::TunnelBrokerService::Stub> stub =
+      tunnelbroker::TunnelBrokerService::NewStub(channel);
+  if (!channel->WaitForConnected(
+          std::chrono::system_clock::now() + std::chrono::seconds(10))) {
+    throw std::runtime_error("couldn't connect to " + target);
+  }
+
+  auto start = Clock::now();
+  registerDevices(*stub, options.devices);
+  const std::chrono::duration<double> registration = Clock::now() - start;
+
+  // the first devices keep a channel, the rest send heartbeats
+  const double channelsShare =
+      std::max(0.0, std::min(1.0, 1 - options.sendPongShare));
+  const size_t channelsCount = std::lround(options.devices * channelsShare);
+  std::vector<std::unique_ptr<SimulatedDevice>> devices;
+  // destroyed before the devices, the pending pongs refer to them
+  Timer timer;
+  for (size_t i = 0; i < channelsCount; ++i) {
+    devices.push_back(
+        std::make_unique<SimulatedDevice>(*stub, options, timer, i));
+  }
+  std::atomic<bool> pongsStopped{false};
+  std::thread pongs([&]() {
+    sendPongs(*stub, options, channelsCount, pongsStopped);
+  });
+  // lets the hellos arrive before the first checks
+  std::this_thread::sleep_for(std::chrono::seconds(1));
+
+  UsageSampler sampler(serverPid);
+  rusage usageBefore;
+  getrusage(RUSAGE_SELF, &usageBefore);
+  CheckResults results;
+  sendChecks(*stub, options, results);
+  const std::chrono::duration<double> elapsed =
+      results.answered - results.start;
+  const std::chrono::duration<double> sending = results.sent - results.start;
+  const std::chrono::duration<double> draining =
+      results.answered - results.sent;
+  sampler.stop();
+  rusage usageAfter;
+  getrusage(RUSAGE_SELF, &usageAfter);
+
+  pongsStopped = true;
+  pongs.join();
+  size_t pings = 0;
+  size_t dropped = 0;
+  for (std::unique_ptr<SimulatedDevice> &device : devices) {
+    device->close();
+    pings += device->pings;
+    dropped += device->dropped;
+  }
+  if (childPid != 0) {
+    kill(childPid, SIGKILL);
+    waitpid(childPid, nullptr, 0);
+  }
+
+  std::sort(results.latencies.begin(), results.latencies.end());
+  const size_t answered = results.latencies.size();
+  std::cout << std::fixed << std::setprecision(2);
+  std::cout << "devices: " << options.devices << " (" << channelsCount
+            << " with a channel, " << options.devices - channelsCount
+            << " sending pongs)" << std::endl;
+  std::cout << "registered in: " << registration.count() << "s ("
+            << options.devices / registration.count() << " devices/s)"
+            << std::endl;
+  std::cout << "checks: " << answered + results.errors << " sent in "
+            << sending.count() << "s ("
+            << (answered + results.errors) / sending.count() << "/s), "
+            << results.errors << " failed, the last answered "
+            << draining.count() << "s after sending" << std::endl;
+  std::cout << "responses: online "
+            << results.responses[tunnelbroker::PRIMARY_ONLINE] << ", offline "
+            << results.responses[tunnelbroker::PRIMARY_OFFLINE]
+            << ", doesn't exist "
+            << results.responses[tunnelbroker::PRIMARY_DOESNT_EXIST]
+            << std::endl;
+  std::cout << "pings: " << pings << " received, " << dropped << " dropped"
+            << std::endl;
+  std::cout << "latency ms: p50 " << getPercentile(results.latencies, 0.5)
+            << ", p99 " << getPercentile(results.latencies, 0.99) << ", p999 "
+            << getPercentile(results.latencies, 0.999) << ", max "
+            << getPercentile(results.latencies, 1) << std::endl;
+  if (sampler.available) {
+    const double cpu = sampler.end.cpuSeconds - sampler.start.cpuSeconds;
+    std::cout << "server: " << sampler.end.threads << " threads ("
+              << sampler.peakThreads << " at peak), " << cpu
+              << " CPU seconds, " << cpu / elapsed.count() << " cores busy"
+              << std::endl;
+  } else {
+    std::cout << "server: usage not available, pass --server_pid"
+              << std::endl;
+  }
+  const double clientCpu =
+      (usageAfter.ru_utime.tv_sec - usageBefore.ru_utime.tv_sec) +
+      (usageAfter.ru_stime.tv_sec - usageBefore.ru_stime.tv_sec) +
+      (usageAfter.ru_utime.tv_usec - usageBefore.ru_utime.tv_usec +
+       usageAfter.ru_stime.tv_usec - usageBefore.ru_stime.tv_usec) /
+          1e6;
+  std::cout << "load generator: " << clientCpu / elapsed.count()
+            << " cores busy" << std::endl;
+}
+
+int main(int argc, char **argv) {
+  try {
+    run(parseOptions(argc, argv));
+  } catch (std::exception &e) {
+    std::cout << "error: " << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,67 @@
+#include "Cluster.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace comm {
+namespace network {
+
+Cluster::Cluster(
+    const std::string &selfAddress,
+    const std::vector<std::string> &peers,
+    const std::string &secret)
+    : selfAddress(selfAddress), secret(secret) {
+  if (peers.empty()) {
+    return;
+  }
+  if (secret.empty()) {
+    throw std::runtime_error("the peers require a cluster secret");
+  }
+  if (std::find(peers.begin(), peers.end(), selfAddress) == peers.end()) {
+    throw std::runtime_error(
+        "the peers don't include this instance (" + selfAddress + ")");
+  }
+  this->ring = std::make_unique<HashRing>(peers);
+}
+
+bool Cluster::isLocal(const std::string &userId) const {
+  return this->ring == nullptr || this->getOwner(userId) == this->selfAddress;
+}
+
+const std::string &Cluster::getSecret() const {
+  return this->secret;
+}
+
+// compares every byte so the time doesn't reveal the matching prefix
+bool Cluster::isForwardedByPeer(const grpc::string_ref &value) const {
+  if (this->secret.empty() || value.size() != this->secret.size()) {
+    return false;
+  }
+  unsigned char difference = 0;
+  for (size_t i = 0; i < value.size(); ++i) {
+    difference |= value.data()[i] ^ this->secret[i];
+  }
+  return difference == 0;
+}
+
+const std::string &Cluster::getOwner(const std::string &userId) const {
+  if (this->ring == nullptr) {
+    return this->selfAddress;
+  }
+  return this->ring->getOwner(userId);
+}
+
+tunnelbroker::TunnelBrokerService::Stub &
+Cluster::getStub(const std::string &address) {
+  std::lock_guard<std::mutex> lock(this->stubsMutex);
+  std::unique_ptr<tunnelbroker::TunnelBrokerService::Stub> &stub =
+      this->stubs[address];
+  if (stub == nullptr) {
+    stub = tunnelbroker::TunnelBrokerService::NewStub(
+        grpc::CreateChannel(address, grpc::InsecureChannelCredentials()));
+  }
+  return *stub;
+}
+
+} // namespace network
+} // namespace comm
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <grpcpp/grpcpp.h>
+
+#include "../_generated/tunnelbroker.grpc.pb.h"
+
+#include "HashRing.h"
+#include "Tools.h"
+
+namespace comm {
+namespace network {
+
+// set to the cluster's secret on the requests forwarded between the
+// instances, such a request is always served where it arrives so the
+// instances that disagree about the owner (while the list of peers is being
+// changed) can't loop it forever
+const std::string FORWARDED_METADATA = "comm-tunnelbroker-forwarded";
+// the owner's address sent back with a device channel opened on another
+// instance, the device is expected to reopen the channel there
+const std::string OWNER_METADATA = "comm-tunnelbroker-owner";
+// a forwarded check may wait for the whole ping timeout on the owner
+const std::chrono::milliseconds FORWARD_TIMEOUT =
+    PING_TIMEOUT + std::chrono::seconds(2);
+
+/**
+ * The tunnelbroker instances split the users by consistent hashing of their
+ * ids, the state of a user only lives on the instance owning it. The requests
+ * for other users are forwarded to their owners. Without any peers the
+ * instance owns all the users. The instances share a secret which proves a
+ * request was forwarded by one of them, the clients reach the same port.
+ */
+class Cluster {
+  const std::string selfAddress;
+  const std::string secret;
+  std::unique_ptr<HashRing> ring;
+
+  std::mutex stubsMutex;
+  std::unordered_map<
+      std::string,
+      std::unique_ptr<tunnelbroker::TunnelBrokerService::Stub>>
+      stubs;
+
+public:
+  // the peers have to include the instance itself, with the same address the
+  // other instances use to reach it, the secret is required with peers
+  Cluster(
+      const std::string &selfAddress = "",
+      const std::vector<std::string> &peers = {},
+      const std::string &secret = "");
+
+  bool isLocal(const std::string &userId) const;
+  const std::string &getSecret() const;
+  // whether the value of FORWARDED_METADATA comes from an instance
+  bool isForwardedByPeer(const grpc::string_ref &value) const;
+  const std::string &getOwner(const std::string &userId) const;
+  tunnelbroker::TunnelBrokerService::Stub &getStub(const std::string &address);
+};
+
+} // namespace network
+} // namespace comm
@@ -0,0 +1,145 @@
+#include "DeviceChannel.h"
+#include "Logger.h"
+#include "Metrics.h"
+
+namespace comm {
+namespace network {
+
+namespace {
+
+Gauge &getOpenChannels() {
+  static Gauge &openChannels = MetricsRegistry::getInstance().getGauge(
+      "tunnelbroker_open_channels", "The device channels currently open.");
+  return openChannels;
+}
+
+} // namespace
+
+DeviceChannel::DeviceChannel(
+    grpc::CallbackServerContext *context,
+    PrimariesRegistry &primaries,
+    Cluster &cluster)
+    : context(context), primaries(primaries), cluster(cluster) {
+  this->pingMessage.mutable_ping();
+}
+
+DeviceChannel *DeviceChannel::create(
+    grpc::CallbackServerContext *context,
+    PrimariesRegistry &primaries,
+    Cluster &cluster) {
+  std::shared_ptr<DeviceChannel> channel(
+      new DeviceChannel(context, primaries, cluster));
+  channel->self = channel;
+  getOpenChannels().add(1);
+  channel->StartRead(&channel->request);
+  return channel.get();
+}
+
+void DeviceChannel::ping() {
+  std::lock_guard<std::mutex> lock(this->writeMutex);
+  if (this->finishing) {
+    return;
+  }
+  if (this->writing) {
+    this->pingPending = true;
+    return;
+  }
+  this->writing = true;
+  this->StartWrite(&this->pingMessage);
+}
+
+void DeviceChannel::handleHello() {
+  if (!this->request.has_hello()) {
+    this->finish(grpc::Status(
+        grpc::StatusCode::INVALID_ARGUMENT,
+        "the channel has to be opened with a hello"));
+    return;
+  }
+  this->id = this->request.hello().userid();
+  this->deviceToken = this->request.hello().devicetoken();
+
+  if (!this->cluster.isLocal(this->id)) {
+    this->context->AddTrailingMetadata(
+        OWNER_METADATA, this->cluster.getOwner(this->id));
+    this->finish(grpc::Status(
+        grpc::StatusCode::UNAVAILABLE,
+        "the user is served by another instance"));
+    return;
+  }
+
+  // the hello is a sign of life too, it answers the checks started before the
+  // channel got opened
+  if (!this->primaries.attachChannel(
+          this->id, this->deviceToken, this->shared_from_this())) {
+    this->finish(grpc::Status(
+        grpc::StatusCode::FAILED_PRECONDITION,
+        "the device is not the primary device"));
+    return;
+  }
+  this->identified = true;
+  this->StartRead(&this->request);
+}
+
+void DeviceChannel::finish(const grpc::Status &status) {
+  std::lock_guard<std::mutex> lock(this->writeMutex);
+  if (this->finishing) {
+    return;
+  }
+  this->finishing = true;
+  if (!status.ok()) {
+    Logger::getInstance().debug(
+        "device channel closed",
+        {{"user_id", this->id},
+         {"code", static_cast<int>(status.error_code())},
+         {"error", status.error_message()}});
+  }
+  // a write in flight finishes the stream when it's done
+  if (this->writing) {
+    this->finishStatus = status;
+    return;
+  }
+  this->Finish(status);
+}
+
+void DeviceChannel::OnReadDone(bool ok) {
+  if (!ok) {
+    // the device closed the channel or the call got cancelled
+    this->finish(grpc::Status::OK);
+    return;
+  }
+  if (!this->identified) {
+    this->handleHello();
+    return;
+  }
+  // every message on the channel keeps the device fresh, not only the pongs
+  if (!this->primaries.markSeen(this->id, this->deviceToken)) {
+    this->finish(grpc::Status(
+        grpc::StatusCode::FAILED_PRECONDITION,
+        "the device is no longer the primary device"));
+    return;
+  }
+  this->StartRead(&this->request);
+}
+
+void DeviceChannel::OnWriteDone(bool ok) {
+  std::lock_guard<std::mutex> lock(this->writeMutex);
+  this->writing = false;
+  if (this->finishing) {
+    this->Finish(this->finishStatus);
+    return;
+  }
+  if (ok && this->pingPending) {
+    this->pingPending = false;
+    this->writing = true;
+    this->StartWrite(&this->pingMessage);
+  }
+}
+
+void DeviceChannel::OnDone() {
+  getOpenChannels().add(-1);
+  // may destroy the channel, nothing can be accessed after this
+  this->self.reset();
+}
+
+} // namespace network
+} // namespace comm
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <grpcpp/grpcpp.h>
+
+#include "../_generated/tunnelbroker.grpc.pb.h"
+#include "../_generated/tunnelbroker.pb.h"
+
+#include "Cluster.h"
+#include "PrimariesRegistry.h"
+
+namespace comm {
+namespace network {
+
+/**
+ * Serves a single OpenDeviceChannel stream of the primary device. The channel
+ * is attached to the device in the registry so the checks can push pings
+ * through it right away, the pongs coming back answer the waiting checks.
+ *
+ * The reactor owns itself until gRPC is done with it, the registry only keeps
+ * a weak reference. A device of a user owned by another instance is sent the
+ * owner's address in the trailing metadata.
+ */
+class DeviceChannel : public grpc::ServerBidiReactor<
+                          tunnelbroker::DeviceMessage,
+                          tunnelbroker::ServerMessage>,
+                      public std::enable_shared_from_this<DeviceChannel> {
+  grpc::CallbackServerContext *context;
+  PrimariesRegistry &primaries;
+  Cluster &cluster;
+  std::shared_ptr<DeviceChannel> self;
+  // set by the hello, only accessed from the read callbacks
+  bool identified = false;
+  std::string id;
+  std::string deviceToken;
+  tunnelbroker::DeviceMessage request;
+  tunnelbroker::ServerMessage pingMessage;
+
+  // only a single write may be in flight, pings requested meanwhile are
+  // coalesced into one as any pong answers all the waiting checks
+  std::mutex writeMutex;
+  bool writing = false;
+  bool pingPending = false;
+  bool finishing = false;
+  grpc::Status finishStatus;
+
+  DeviceChannel(
+      grpc::CallbackServerContext *context,
+      PrimariesRegistry &primaries,
+      Cluster &cluster);
+
+  void handleHello();
+  void finish(const grpc::Status &status);
+
+public:
+  static DeviceChannel *create(
+      grpc::CallbackServerContext *context,
+      PrimariesRegistry &primaries,
+      Cluster &cluster);
+
+  void ping();
+
+  void OnReadDone(bool ok) override;
+  void OnWriteDone(bool ok) override;
+  void OnDone() override;
+};
+
+} // namespace network
+} // namespace comm
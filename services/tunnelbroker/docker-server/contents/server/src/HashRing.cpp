@@ -0,0 +1,63 @@
+#include "HashRing.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace comm {
+namespace network {
+
+const size_t HashRing::VIRTUAL_NODES;
+
+// FNV-1a followed by the splitmix64 finalizer, FNV alone spreads similar keys
+// (like the virtual node names) poorly over the ring
+uint64_t HashRing::hash(const std::string &key) {
+  uint64_t result = 14695981039346656037ULL;
+  for (const char c : key) {
+    result ^= static_cast<uint8_t>(c);
+    result *= 1099511628211ULL;
+  }
+  result ^= result >> 30;
+  result *= 0xbf58476d1ce4e5b9ULL;
+  result ^= result >> 27;
+  result *= 0x94d049bb133111ebULL;
+  result ^= result >> 31;
+  return result;
+}
+
+HashRing::HashRing(const std::vector<std::string> &nodes) : nodes(nodes) {
+  if (this->nodes.empty()) {
+    throw std::runtime_error("the hash ring needs at least one node");
+  }
+  std::sort(this->nodes.begin(), this->nodes.end());
+  if (std::adjacent_find(this->nodes.begin(), this->nodes.end()) !=
+      this->nodes.end()) {
+    throw std::runtime_error("the hash ring nodes have to be unique");
+  }
+  this->points.reserve(this->nodes.size() * VIRTUAL_NODES);
+  for (size_t i = 0; i < this->nodes.size(); ++i) {
+    for (size_t j = 0; j < VIRTUAL_NODES; ++j) {
+      this->points.emplace_back(
+          hash(this->nodes[i] + "#" + std::to_string(j)), i);
+    }
+  }
+  std::sort(this->points.begin(), this->points.end());
+}
+
+const std::string &HashRing::getOwner(const std::string &key) const {
+  const uint64_t point = hash(key);
+  auto iterator = std::lower_bound(
+      this->points.begin(),
+      this->points.end(),
+      std::make_pair(point, size_t(0)));
+  if (iterator == this->points.end()) {
+    iterator = this->points.begin();
+  }
+  return this->nodes[iterator->second];
+}
+
+const std::vector<std::string> &HashRing::getNodes() const {
+  return this->nodes;
+}
+
+} // namespace network
+} // namespace comm
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace comm {
+namespace network {
+
+/**
+ * Consistent hashing of the user ids onto the tunnelbroker instances. Every
+ * instance is placed on the ring many times (virtual nodes) so the users are
+ * spread evenly, adding or removing an instance only moves the users of the
+ * ranges it owns.
+ *
+ * The hash doesn't depend on the platform or the build so all the instances
+ * agree on the owners as long as they're given the same list of nodes.
+ */
+class HashRing {
+  std::vector<std::string> nodes;
+  // sorted by the point, the second value is the index of the node
+  std::vector<std::pair<uint64_t, size_t>> points;
+
+public:
+  static const size_t VIRTUAL_NODES = 128;
+
+  static uint64_t hash(const std::string &key);
+
+  HashRing(const std::vector<std::string> &nodes);
+
+  const std::string &getOwner(const std::string &key) const;
+  const std::vector<std::string> &getNodes() const;
+};
+
+} // namespace network
+} // namespace comm
@@ -0,0 +1,591 @@
+#include "PrimariesRegistry.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace comm {
+namespace network {
+
+namespace {
+
+// the snapshot is only meant to be read back on the same machine so it's kept
+// in the native byte order and layout, the version has to be bumped whenever
+// any of the structures below changes
+//
+// layout: header, index of the sections (shards count + 1 offsets, the last
+// one is the end of the file), the sections, each of them being a section
+// header, the records and the strings they point to
+const char SNAPSHOT_MAGIC[8] = {'T', 'B', 'P', 'R', 'I', 'M', 'S', 'N'};
+const uint32_t SNAPSHOT_VERSION = 1;
+
+struct SnapshotHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t shardsCount;
+};
+
+struct SnapshotSectionHeader {
+  uint64_t recordsCount;
+  uint64_t stringsSize;
+};
+
+struct SnapshotRecord {
+  // the id is followed by the device token, relative to the section's strings
+  uint64_t stringsOffset;
+  uint32_t lastActive;
+  uint16_t idLength;
+  uint16_t deviceTokenLength;
+  uint8_t lastState;
+  uint8_t reserved[7];
+};
+
+// the lengths are kept in 16 bits, anything longer isn't a valid id or token
+// anyway so it's left out of the snapshot
+bool fitsSnapshot(const std::string &id, const std::string &deviceToken) {
+  return id.size() <= UINT16_MAX && deviceToken.size() <= UINT16_MAX;
+}
+
+uint32_t getUnixTime() {
+  return std::chrono::duration_cast<std::chrono::seconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+size_t alignTo8(const size_t size) {
+  return (size + 7) & ~size_t(7);
+}
+
+void throwSystemError(const std::string &message, const std::string &path) {
+  throw std::runtime_error(
+      message + " " + path + ": " + std::string(std::strerror(errno)));
+}
+
+void writeAll(const int fd, const char *data, size_t size) {
+  while (size > 0) {
+    const ssize_t written = ::write(fd, data, size);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw std::runtime_error(
+          "writing the snapshot failed: " + std::string(std::strerror(errno)));
+    }
+    data += written;
+    size -= written;
+  }
+}
+
+class MappedFile {
+  void *data = MAP_FAILED;
+  size_t size = 0;
+
+public:
+  MappedFile(const std::string &path) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      throwSystemError("opening the snapshot", path);
+    }
+    struct stat fileStat;
+    if (::fstat(fd, &fileStat) != 0) {
+      ::close(fd);
+      throwSystemError("reading the snapshot", path);
+    }
+    this->size = fileStat.st_size;
+    if (this->size > 0) {
+      this->data =
+          ::mmap(nullptr, this->size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    ::close(fd);
+    if (this->size > 0 && this->data == MAP_FAILED) {
+      throwSystemError("mapping the snapshot", path);
+    }
+    if (this->size > 0) {
+      ::madvise(this->data, this->size, MADV_WILLNEED);
+    }
+  }
+
+  ~MappedFile() {
+    if (this->data != MAP_FAILED) {
+      ::munmap(this->data, this->size);
+    }
+  }
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  const char *getData() const {
+    return static_cast<const char *>(this->data);
+  }
+
+  size_t getSize() const {
+    return this->size;
+  }
+};
+
+} // namespace
+
+PrimariesRegistry::Shard &PrimariesRegistry::getShard(const std::string &id) {
+  return this->shards[std::hash<std::string>()(id) & (PRIMARIES_SHARDS - 1)];
+}
+
+std::vector<PrimariesRegistry::Answer>
+PrimariesRegistry::recordSeen(PrimaryDevice &device) {
+  device.lastSeen = std::chrono::steady_clock::now();
+  device.lastState = ping::ClientState::ONLINE;
+  device.lastActive = getUnixTime();
+  std::vector<Answer> waiters;
+  if (device.ping != nullptr) {
+    waiters.swap(device.ping->waiters);
+  }
+  return waiters;
+}
+
+PrimaryCheck PrimariesRegistry::check(
+    const std::string &id,
+    const std::string &deviceToken,
+    const std::chrono::milliseconds livenessTtl,
+    Answer answer) {
+  PrimaryCheck result;
+  Shard &shard = this->getShard(id);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+
+  auto iterator = shard.devices.find(id);
+  if (iterator == shard.devices.end()) {
+    result.status = PrimaryStatus::DOESNT_EXIST;
+    return result;
+  }
+  PrimaryDevice &device = iterator->second;
+  if (device.deviceToken == deviceToken) {
+    result.status = PrimaryStatus::CURRENT_IS_PRIMARY;
+    return result;
+  }
+  if (device.lastSeen != std::chrono::steady_clock::time_point() &&
+      std::chrono::steady_clock::now() - device.lastSeen < livenessTtl) {
+    result.status = PrimaryStatus::ONLINE;
+    return result;
+  }
+
+  result.status = PrimaryStatus::WAITING;
+  if (device.ping == nullptr) {
+    device.ping = std::make_unique<PingState>();
+  }
+  // the checks arriving while a ping is in flight wait for the same pong
+  result.startPing = device.ping->waiters.empty();
+  device.ping->waiters.push_back(std::move(answer));
+  if (result.startPing) {
+    device.ping->pingId = ++shard.lastPingId;
+    result.pingId = device.ping->pingId;
+    result.channel = device.ping->channel.lock();
+  }
+  return result;
+}
+
+bool PrimariesRegistry::becomePrimary(
+    const std::string &id,
+    const std::string &deviceToken) {
+  std::vector<Answer> waiters;
+  {
+    Shard &shard = this->getShard(id);
+    // the state is read and the new primary stored under a single lock, so of
+    // the devices racing for the user exactly one wins
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto iterator = shard.devices.find(id);
+    if (iterator == shard.devices.end()) {
+      PrimaryDevice &device = shard.devices[id];
+      device.deviceToken = deviceToken;
+      device.lastActive = getUnixTime();
+      return true;
+    }
+    PrimaryDevice &device = iterator->second;
+    if (device.deviceToken == deviceToken) {
+      device.lastActive = getUnixTime();
+      return true;
+    }
+    if (device.lastState == ping::ClientState::ONLINE) {
+      return false;
+    }
+    if (device.ping != nullptr) {
+      waiters.swap(device.ping->waiters);
+    }
+    device = PrimaryDevice();
+    device.deviceToken = deviceToken;
+    device.lastActive = getUnixTime();
+  }
+  // the checks still waiting for the replaced primary won't get its pong
+  for (const Answer &answer : waiters) {
+    answer(ping::ClientState::OFFLINE);
+  }
+  return true;
+}
+
+bool PrimariesRegistry::markSeen(
+    const std::string &id,
+    const std::string &deviceToken) {
+  std::vector<Answer> waiters;
+  {
+    Shard &shard = this->getShard(id);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto iterator = shard.devices.find(id);
+    if (iterator == shard.devices.end() ||
+        iterator->second.deviceToken != deviceToken) {
+      return false;
+    }
+    waiters = recordSeen(iterator->second);
+  }
+  for (const Answer &answer : waiters) {
+    answer(ping::ClientState::ONLINE);
+  }
+  return true;
+}
+
+bool PrimariesRegistry::attachChannel(
+    const std::string &id,
+    const std::string &deviceToken,
+    std::weak_ptr<DeviceChannel> channel) {
+  std::vector<Answer> waiters;
+  {
+    Shard &shard = this->getShard(id);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto iterator = shard.devices.find(id);
+    if (iterator == shard.devices.end() ||
+        iterator->second.deviceToken != deviceToken) {
+      return false;
+    }
+    PrimaryDevice &device = iterator->second;
+    if (device.ping == nullptr) {
+      device.ping = std::make_unique<PingState>();
+    }
+    device.ping->channel = std::move(channel);
+    // opening the channel is a sign of life too, it answers the checks
+    // started before
+    waiters = recordSeen(device);
+  }
+  for (const Answer &answer : waiters) {
+    answer(ping::ClientState::ONLINE);
+  }
+  return true;
+}
+
+void PrimariesRegistry::expirePing(
+    const std::string &id,
+    const uint64_t pingId) {
+  std::vector<Answer> waiters;
+  {
+    Shard &shard = this->getShard(id);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto iterator = shard.devices.find(id);
+    if (iterator == shard.devices.end()) {
+      return;
+    }
+    PrimaryDevice &device = iterator->second;
+    if (device.ping == nullptr || device.ping->pingId != pingId ||
+        device.ping->waiters.empty()) {
+      return;
+    }
+    device.lastState = ping::ClientState::OFFLINE;
+    waiters.swap(device.ping->waiters);
+  }
+  for (const Answer &answer : waiters) {
+    answer(ping::ClientState::OFFLINE);
+  }
+}
+
+size_t PrimariesRegistry::evictIdle(const std::chrono::seconds idleTtl) {
+  const uint32_t now = getUnixTime();
+  size_t evicted = 0;
+  // shard by shard so the checks are only blocked for a single shard's scan
+  for (Shard &shard : this->shards) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    for (auto iterator = shard.devices.begin();
+         iterator != shard.devices.end();) {
+      const PrimaryDevice &device = iterator->second;
+      const bool busy = device.ping != nullptr &&
+          (!device.ping->waiters.empty() || !device.ping->channel.expired());
+      // written this way so a clock set back doesn't evict everything
+      if (busy || uint64_t(device.lastActive) + idleTtl.count() > now) {
+        ++iterator;
+        continue;
+      }
+      iterator = shard.devices.erase(iterator);
+      ++evicted;
+    }
+  }
+  return evicted;
+}
+
+size_t PrimariesRegistry::size() {
+  size_t result = 0;
+  for (Shard &shard : this->shards) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    result += shard.devices.size();
+  }
+  return result;
+}
+
+void PrimariesRegistry::saveSnapshot(const std::string &path) {
+  const std::string temporaryPath = path + ".tmp";
+  const int fd = ::open(
+      temporaryPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+  if (fd < 0) {
+    throwSystemError("creating the snapshot", temporaryPath);
+  }
+  try {
+    SnapshotHeader header;
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    header.version = SNAPSHOT_VERSION;
+    header.shardsCount = PRIMARIES_SHARDS;
+    std::vector<uint64_t> sectionOffsets(PRIMARIES_SHARDS + 1);
+    writeAll(fd, reinterpret_cast<const char *>(&header), sizeof(header));
+    // the index is filled in once the sections are written
+    writeAll(
+        fd,
+        reinterpret_cast<const char *>(sectionOffsets.data()),
+        sectionOffsets.size() * sizeof(uint64_t));
+    uint64_t offset = sizeof(header) + sectionOffsets.size() * sizeof(uint64_t);
+
+    std::string section;
+    for (size_t i = 0; i < PRIMARIES_SHARDS; ++i) {
+      section.clear();
+      {
+        Shard &shard = this->shards[i];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        SnapshotSectionHeader sectionHeader;
+        sectionHeader.recordsCount = 0;
+        sectionHeader.stringsSize = 0;
+        for (const auto &entry : shard.devices) {
+          if (fitsSnapshot(entry.first, entry.second.deviceToken)) {
+            ++sectionHeader.recordsCount;
+            sectionHeader.stringsSize +=
+                entry.first.size() + entry.second.deviceToken.size();
+          }
+        }
+        const size_t recordsSize =
+            sectionHeader.recordsCount * sizeof(SnapshotRecord);
+        section.resize(alignTo8(
+            sizeof(sectionHeader) + recordsSize + sectionHeader.stringsSize));
+        char *data = &section[0];
+        std::memcpy(data, &sectionHeader, sizeof(sectionHeader));
+        SnapshotRecord *records =
+            reinterpret_cast<SnapshotRecord *>(data + sizeof(sectionHeader));
+        char *strings = data + sizeof(sectionHeader) + recordsSize;
+        uint64_t stringsOffset = 0;
+        for (const auto &entry : shard.devices) {
+          const std::string &id = entry.first;
+          const PrimaryDevice &device = entry.second;
+          if (!fitsSnapshot(id, device.deviceToken)) {
+            continue;
+          }
+          SnapshotRecord &record = *records++;
+          std::memset(&record, 0, sizeof(record));
+          record.stringsOffset = stringsOffset;
+          record.lastActive = device.lastActive;
+          record.idLength = id.size();
+          record.deviceTokenLength = device.deviceToken.size();
+          record.lastState = static_cast<uint8_t>(device.lastState);
+          std::memcpy(strings + stringsOffset, id.data(), id.size());
+          stringsOffset += id.size();
+          std::memcpy(
+              strings + stringsOffset,
+              device.deviceToken.data(),
+              device.deviceToken.size());
+          stringsOffset += device.deviceToken.size();
+        }
+      }
+      sectionOffsets[i] = offset;
+      writeAll(fd, section.data(), section.size());
+      offset += section.size();
+    }
+    sectionOffsets[PRIMARIES_SHARDS] = offset;
+
+    const size_t indexSize = sectionOffsets.size() * sizeof(uint64_t);
+    if (::pwrite(
+            fd,
+            sectionOffsets.data(),
+            indexSize,
+            sizeof(header)) != static_cast<ssize_t>(indexSize)) {
+      throwSystemError("writing the snapshot", temporaryPath);
+    }
+    if (::fdatasync(fd) != 0) {
+      throwSystemError("syncing the snapshot", temporaryPath);
+    }
+  } catch (...) {
+    ::close(fd);
+    ::unlink(temporaryPath.c_str());
+    throw;
+  }
+  ::close(fd);
+
+  if (::rename(temporaryPath.c_str(), path.c_str()) != 0) {
+    ::unlink(temporaryPath.c_str());
+    throwSystemError("replacing the snapshot", path);
+  }
+  const size_t separator = path.rfind('/');
+  const std::string directory =
+      (separator == std::string::npos) ? "." : path.substr(0, separator + 1);
+  const int directoryFd =
+      ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  if (directoryFd >= 0) {
+    ::fsync(directoryFd);
+    ::close(directoryFd);
+  }
+}
+
+size_t PrimariesRegistry::loadSnapshot(const std::string &path) {
+  const MappedFile file(path);
+  const char *data = file.getData();
+  const size_t size = file.getSize();
+
+  SnapshotHeader header;
+  if (size < sizeof(header)) {
+    throw std::runtime_error("invalid snapshot " + path + ": too short");
+  }
+  std::memcpy(&header, data, sizeof(header));
+  if (std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0 ||
+      header.version != SNAPSHOT_VERSION) {
+    throw std::runtime_error(
+        "invalid snapshot " + path + ": unknown format or version");
+  }
+  const size_t indexSize = (size_t(header.shardsCount) + 1) * sizeof(uint64_t);
+  if (size - sizeof(header) < indexSize) {
+    throw std::runtime_error("invalid snapshot " + path + ": truncated index");
+  }
+  const uint64_t *sectionOffsets =
+      reinterpret_cast<const uint64_t *>(data + sizeof(header));
+  // the sections follow the index in order, each one starts 8-byte aligned so
+  // its records can be read in place, the last offset is the end of the file
+  if (sectionOffsets[header.shardsCount] != size) {
+    throw std::runtime_error("invalid snapshot " + path + ": truncated");
+  }
+  for (size_t i = 0; i < header.shardsCount; ++i) {
+    if (sectionOffsets[i] < sizeof(header) + indexSize ||
+        sectionOffsets[i] > sectionOffsets[i + 1] ||
+        sectionOffsets[i] % 8 != 0) {
+      throw std::runtime_error("invalid snapshot " + path + ": bad index");
+    }
+  }
+
+  // runs the function for every section, spread over a few threads, and
+  // rethrows the first error once they are all done
+  const size_t threadsCount = std::max<size_t>(
+      1,
+      std::min<size_t>(
+          std::thread::hardware_concurrency(), header.shardsCount));
+  auto forEachSection = [&header,
+                         threadsCount](const std::function<void(size_t)> &f) {
+    std::vector<std::exception_ptr> errors(threadsCount);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < threadsCount; ++t) {
+      threads.emplace_back([&, t]() {
+        try {
+          for (size_t i = t; i < header.shardsCount; i += threadsCount) {
+            f(i);
+          }
+        } catch (...) {
+          errors[t] = std::current_exception();
+        }
+      });
+    }
+    for (std::thread &thread : threads) {
+      thread.join();
+    }
+    for (const std::exception_ptr &error : errors) {
+      if (error) {
+        std::rethrow_exception(error);
+      }
+    }
+  };
+
+  // the whole file is validated before any device is inserted so a damaged
+  // snapshot leaves the registry untouched
+  std::vector<SnapshotSectionHeader> sectionHeaders(header.shardsCount);
+  forEachSection([data, sectionOffsets, &sectionHeaders, &path](size_t i) {
+    const uint64_t begin = sectionOffsets[i];
+    const uint64_t end = sectionOffsets[i + 1];
+    SnapshotSectionHeader &sectionHeader = sectionHeaders[i];
+    if (end - begin < sizeof(sectionHeader)) {
+      throw std::runtime_error("invalid snapshot " + path + ": bad section");
+    }
+    std::memcpy(&sectionHeader, data + begin, sizeof(sectionHeader));
+    const uint64_t available = end - begin - sizeof(sectionHeader);
+    if (sectionHeader.recordsCount > available / sizeof(SnapshotRecord) ||
+        sectionHeader.stringsSize >
+            available - sectionHeader.recordsCount * sizeof(SnapshotRecord)) {
+      throw std::runtime_error("invalid snapshot " + path + ": bad section");
+    }
+    const SnapshotRecord *records = reinterpret_cast<const SnapshotRecord *>(
+        data + begin + sizeof(sectionHeader));
+    for (uint64_t j = 0; j < sectionHeader.recordsCount; ++j) {
+      const SnapshotRecord &record = records[j];
+      if (record.stringsOffset > sectionHeader.stringsSize ||
+          size_t(record.idLength) + record.deviceTokenLength >
+              sectionHeader.stringsSize - record.stringsOffset) {
+        throw std::runtime_error("invalid snapshot " + path + ": bad record");
+      }
+    }
+  });
+
+  // the shards are taken by the id so a snapshot written with another
+  // sharding still loads correctly
+  std::vector<size_t> restored(header.shardsCount, 0);
+  forEachSection([this, data, sectionOffsets, &sectionHeaders, &restored](
+                     size_t i) {
+    const SnapshotSectionHeader &sectionHeader = sectionHeaders[i];
+    const SnapshotRecord *records = reinterpret_cast<const SnapshotRecord *>(
+        data + sectionOffsets[i] + sizeof(sectionHeader));
+    const char *strings = reinterpret_cast<const char *>(
+        records + sectionHeader.recordsCount);
+
+    Shard *lockedShard = nullptr;
+    std::unique_lock<std::mutex> lock;
+    for (uint64_t j = 0; j < sectionHeader.recordsCount; ++j) {
+      const SnapshotRecord &record = records[j];
+      std::string id(strings + record.stringsOffset, record.idLength);
+      Shard &shard = this->getShard(id);
+      // the records of a section normally all belong to the same shard
+      if (&shard != lockedShard) {
+        lock = std::unique_lock<std::mutex>(shard.mutex);
+        lockedShard = &shard;
+        shard.devices.reserve(
+            shard.devices.size() + sectionHeader.recordsCount - j);
+      }
+      auto inserted = shard.devices.emplace(std::move(id), PrimaryDevice());
+      if (!inserted.second) {
+        continue;
+      }
+      PrimaryDevice &device = inserted.first->second;
+      device.deviceToken.assign(
+          strings + record.stringsOffset + record.idLength,
+          record.deviceTokenLength);
+      device.lastActive = record.lastActive;
+      device.lastState = (record.lastState ==
+                          static_cast<uint8_t>(ping::ClientState::OFFLINE))
+          ? ping::ClientState::OFFLINE
+          : ping::ClientState::ONLINE;
+      ++restored[i];
+    }
+  });
+
+  size_t result = 0;
+  for (const size_t count : restored) {
+    result += count;
+  }
+  return result;
+}
+
+} // namespace network
+} // namespace comm
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "Tools.h"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace comm {
+namespace network {
+
+class DeviceChannel;
+
+enum class PrimaryStatus {
+  DOESNT_EXIST,
+  CURRENT_IS_PRIMARY,
+  ONLINE,
+  // the check got registered and will be answered by a pong or the timeout
+  WAITING,
+};
+
+struct PrimaryCheck {
+  PrimaryStatus status;
+  // the check started a new ping, the caller has to send it (through the
+  // channel if there's one) and schedule expirePing
+  bool startPing = false;
+  uint64_t pingId = 0;
+  std::shared_ptr<DeviceChannel> channel;
+};
+
+/**
+ * Keeps the primary device of every user. The users are spread over shards,
+ * each guarded by its own mutex, everything below is only touched with the
+ * shard's mutex held.
+ *
+ * An idle device only costs its map entry, the state needed for pinging it
+ * is allocated when it's checked for the first time or opens a channel. The
+ * devices silent for too long get evicted so the memory stays bounded.
+ */
+class PrimariesRegistry {
+public:
+  using Answer = std::function<void(ping::ClientState)>;
+
+private:
+  struct PingState {
+    // the checks waiting for the pong, they all share a single ping
+    std::vector<Answer> waiters;
+    // identifies the ping in flight so a stale timeout doesn't expire a newer
+    // one, unique within the shard
+    uint64_t pingId = 0;
+    // the channel opened by the device, if any, pings are pushed through it
+    std::weak_ptr<DeviceChannel> channel;
+  };
+
+  struct PrimaryDevice {
+    std::string deviceToken;
+    // the default (epoch) value means the device hasn't been seen yet
+    std::chrono::steady_clock::time_point lastSeen;
+    ping::ClientState lastState = ping::ClientState::ONLINE;
+    // unix time in seconds of the last registration or sign of life, used
+    // for eviction, it survives restarts unlike lastSeen
+    uint32_t lastActive = 0;
+    std::unique_ptr<PingState> ping;
+  };
+
+  struct Shard {
+    std::mutex mutex;
+    std::unordered_map<std::string, PrimaryDevice> devices;
+    uint64_t lastPingId = 0;
+  };
+
+  std::array<Shard, PRIMARIES_SHARDS> shards;
+
+  Shard &getShard(const std::string &id);
+  // returns the waiters the caller has to answer once the lock is released
+  static std::vector<Answer> recordSeen(PrimaryDevice &device);
+
+public:
+  PrimaryCheck check(
+      const std::string &id,
+      const std::string &deviceToken,
+      const std::chrono::milliseconds livenessTtl,
+      Answer answer);
+  bool becomePrimary(const std::string &id, const std::string &deviceToken);
+  // a pong or any other sign of life of the device, answers every check
+  // waiting at the moment, returns false if the device isn't the primary
+  bool markSeen(const std::string &id, const std::string &deviceToken);
+  bool attachChannel(
+      const std::string &id,
+      const std::string &deviceToken,
+      std::weak_ptr<DeviceChannel> channel);
+  void expirePing(const std::string &id, const uint64_t pingId);
+  // removes the devices that haven't been active for the given time, unless
+  // they have checks waiting or a channel open, returns the number removed
+  size_t evictIdle(const std::chrono::seconds idleTtl);
+  size_t size();
+
+  // the snapshot keeps the devices with their last state and activity, it's
+  // written atomically, one section per shard so a shard is only locked while
+  // its own section is written
+  void saveSnapshot(const std::string &path);
+  // the snapshot is mapped and its shards are restored in parallel, devices
+  // already present are kept, returns the number of devices restored
+  size_t loadSnapshot(const std::string &path);
+};
+
+} // namespace network
+} // namespace comm
@@ -0,0 +1,57 @@
+#include "Timer.h"
+
+namespace comm {
+namespace network {
+
+Timer::Timer() : thread([this]() { this->run(); }) {
+}
+
+Timer::~Timer() {
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->stopped = true;
+  }
+  this->condition.notify_one();
+  this->thread.join();
+}
+
+void Timer::schedule(
+    const std::chrono::steady_clock::duration delay,
+    std::function<void()> task) {
+  const std::chrono::steady_clock::time_point deadline =
+      std::chrono::steady_clock::now() + delay;
+  bool earliest;
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    earliest = this->tasks.empty() || deadline < this->tasks.begin()->first;
+    this->tasks.emplace(deadline, std::move(task));
+  }
+  // the thread sleeps until the earliest deadline, only a new earliest task
+  // has to wake it up
+  if (earliest) {
+    this->condition.notify_one();
+  }
+}
+
+void Timer::run() {
+  std::unique_lock<std::mutex> lock(this->mutex);
+  while (!this->stopped) {
+    if (this->tasks.empty()) {
+      this->condition.wait(lock);
+      continue;
+    }
+    auto first = this->tasks.begin();
+    if (first->first > std::chrono::steady_clock::now()) {
+      this->condition.wait_until(lock, first->first);
+      continue;
+    }
+    std::function<void()> task = std::move(first->second);
+    this->tasks.erase(first);
+    lock.unlock();
+    task();
+    lock.lock();
+  }
+}
+
+} // namespace network
+} // namespace comm
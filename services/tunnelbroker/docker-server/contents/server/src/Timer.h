@@ -0,0 +1,40 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace comm {
+namespace network {
+
+/**
+ * Runs scheduled tasks on a single background thread. Pending operations
+ * (like waiting for a pong) cost only an entry here instead of a blocked
+ * thread, the tasks are expected to be short.
+ */
+class Timer {
+  std::mutex mutex;
+  std::condition_variable condition;
+  std::multimap<std::chrono::steady_clock::time_point, std::function<void()>>
+      tasks;
+  bool stopped = false;
+  std::thread thread;
+
+  void run();
+
+public:
+  Timer();
+  ~Timer();
+  Timer(const Timer &) = delete;
+  Timer &operator=(const Timer &) = delete;
+
+  void schedule(
+      const std::chrono::steady_clock::duration delay,
+      std::function<void()> task);
+};
+
+} // namespace network
+} // namespace comm
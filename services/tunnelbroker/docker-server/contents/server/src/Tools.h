@@ -1,29 +1,30 @@
 #pragma once
 
-#include <string>
-
-#include <folly/MPMCQueue.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 
 namespace comm {
 namespace network {
-namespace ping {
 
-enum class ClientState {
-  ONLINE,
-  OFFLINE,
-};
+// TODO: timeout currently set for 3s, to be changed
+const std::chrono::milliseconds PING_TIMEOUT = std::chrono::seconds(3);
+// a device seen within this window is reported online without pinging it
+const std::chrono::milliseconds DEFAULT_LIVENESS_TTL = std::chrono::seconds(2);
+// a primary silent for this long is forgotten
+const std::chrono::seconds DEFAULT_IDLE_TTL = std::chrono::hours(24 * 30);
+// how often the idle devices are evicted and the snapshot is taken
+const std::chrono::seconds DEFAULT_MAINTENANCE_INTERVAL =
+    std::chrono::seconds(60);
 
-struct ClientData {
-  const std::string id;
-  const std::string deviceToken;
+// power of two so the shard can be picked with a mask
+const size_t PRIMARIES_SHARDS = 64;
 
-  folly::MPMCQueue<bool> pingRequests = folly::MPMCQueue<bool>(10);
-  folly::MPMCQueue<bool> pingResponses = folly::MPMCQueue<bool>(10);
-  ClientState lastState = ClientState::ONLINE;
+namespace ping {
 
-  ClientData(const std::string id, const std::string deviceToken)
-      : id(id), deviceToken(deviceToken) {
-  }
+enum class ClientState : uint8_t {
+  ONLINE,
+  OFFLINE,
 };
 
 } // namespace ping
@@ -1,103 +1,235 @@
 #include "TunnelBrokerServiceImpl.h"
-
-#include <folly/stop_watch.h>
-#include <chrono>
+#include "Logger.h"
 
 namespace comm {
 namespace network {
 
-using namespace std::chrono_literals;
+TunnelBrokerServiceImpl::TunnelBrokerServiceImpl(
+    const std::chrono::milliseconds livenessTtl,
+    const std::string &selfAddress,
+    const std::vector<std::string> &peers,
+    const std::string &clusterSecret)
+    : livenessTtl(livenessTtl),
+      cluster(selfAddress, peers, clusterSecret),
+      checkMetrics("tunnelbroker", "CheckIfPrimaryDeviceOnline"),
+      becomePrimaryMetrics("tunnelbroker", "BecomeNewPrimaryDevice"),
+      pongMetrics("tunnelbroker", "SendPong"),
+      waitingChecks(MetricsRegistry::getInstance().getGauge(
+          "tunnelbroker_waiting_checks",
+          "The checks waiting for a pong of the primary device.")),
+      pingWait(MetricsRegistry::getInstance().getHistogram(
+          "tunnelbroker_ping_wait_microseconds",
+          "How long the checks waited for a pong or the ping timeout.")),
+      forwardedRequests(MetricsRegistry::getInstance().getCounter(
+          "tunnelbroker_forwarded_requests_total",
+          "The requests forwarded to the instances owning their users.")) {
+}
+
+template <class Request, class Response>
+bool TunnelBrokerServiceImpl::forward(
+    grpc::CallbackServerContext *context,
+    grpc::ServerUnaryReactor *reactor,
+    const Request *request,
+    Response *response,
+    void (tunnelbroker::TunnelBrokerService::Stub::async::*method)(
+        grpc::ClientContext *,
+        const Request *,
+        Response *,
+        std::function<void(grpc::Status)>),
+    RpcMetrics &metrics) {
+  const std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  const std::string &userId = request->userid();
+  const auto forwarded = context->client_metadata().find(FORWARDED_METADATA);
+  if (forwarded != context->client_metadata().end()) {
+    if (this->cluster.isForwardedByPeer(forwarded->second)) {
+      return false;
+    }
+    // a client could make an instance serve a user it doesn't own
+    Logger::getInstance().warning(
+        "forged forwarded request", {{"user_id", userId}});
+    metrics.record(start, false);
+    reactor->Finish(grpc::Status(
+        grpc::StatusCode::PERMISSION_DENIED, "invalid forwarded request"));
+    return true;
+  }
+  if (this->cluster.isLocal(userId)) {
+    return false;
+  }
+  // the client's cancellation is propagated to the owner
+  std::shared_ptr<grpc::ClientContext> forwardContext =
+      grpc::ClientContext::FromCallbackServerContext(*context);
+  forwardContext->AddMetadata(FORWARDED_METADATA, this->cluster.getSecret());
+  this->forwardedRequests.increment();
+  forwardContext->set_deadline(
+      std::chrono::system_clock::now() + FORWARD_TIMEOUT);
+  const std::string owner = this->cluster.getOwner(userId);
+  tunnelbroker::TunnelBrokerService::Stub &stub = this->cluster.getStub(owner);
+  (stub.async()->*method)(
+      forwardContext.get(),
+      request,
+      response,
+      [forwardContext, reactor, &metrics, start, userId, owner](
+          grpc::Status status) {
+        if (!status.ok()) {
+          Logger::getInstance().warning(
+              "forwarding failed",
+              {{"user_id", userId},
+               {"owner", owner},
+               {"error", status.error_message()}});
+        }
+        metrics.record(start, status.ok());
+        reactor->Finish(status);
+      });
+  return true;
+}
 
-grpc::Status TunnelBrokerServiceImpl::CheckIfPrimaryDeviceOnline(
-    grpc::ServerContext *context,
+PrimariesRegistry &TunnelBrokerServiceImpl::getPrimaries() {
+  return this->primaries;
+}
+
+grpc::ServerUnaryReactor *TunnelBrokerServiceImpl::CheckIfPrimaryDeviceOnline(
+    grpc::CallbackServerContext *context,
     const tunnelbroker::CheckRequest *request,
     tunnelbroker::CheckResponse *response) {
+  const std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  grpc::ServerUnaryReactor *reactor = context->DefaultReactor();
+  if (this->forward(
+          context,
+          reactor,
+          request,
+          response,
+          &tunnelbroker::TunnelBrokerService::Stub::async::
+              CheckIfPrimaryDeviceOnline,
+          this->checkMetrics)) {
+    return reactor;
+  }
   const std::string id = request->userid();
   const std::string deviceToken = request->devicetoken();
 
-  auto iterator = primaries.find(id);
-
-  if (iterator == primaries.end()) {
-    response->set_checkresponsetype(
-        tunnelbroker::CheckResponseType::PRIMARY_DOESNT_EXIST);
-  } else if (deviceToken == iterator->second->deviceToken) {
-    response->set_checkresponsetype(
-        tunnelbroker::CheckResponseType::CURRENT_IS_PRIMARY);
-  } else {
-    // TODO: the background notif should be sent what cannot be really
-    // simulated here I believe
-    iterator->second->pingRequests.blockingWrite(true);
-    // TODO: timeout currently set for 3s, to be changed
-    const auto wait = std::chrono::seconds(3);
-    folly::stop_watch<> watch;
-    bool isActive;
-    bool responseReceived = iterator->second->pingResponses.tryReadUntil(
-        watch.getCheckpoint() + wait, isActive);
-    if (responseReceived) {
-      iterator->second->lastState = ping::ClientState::ONLINE;
-      response->set_checkresponsetype(
-          tunnelbroker::CheckResponseType::PRIMARY_ONLINE);
-    } else {
-      iterator->second->lastState = ping::ClientState::OFFLINE;
-      response->set_checkresponsetype(
-          tunnelbroker::CheckResponseType::PRIMARY_OFFLINE);
+  auto answer = [this, response, reactor, start, id](
+                    const tunnelbroker::CheckResponseType type) {
+    // the checks are frequent, they're only logged for debugging
+    Logger &logger = Logger::getInstance();
+    if (logger.isEnabled(LOG_LEVEL::DEBUG)) {
+      logger.debug(
+          "CheckIfPrimaryDeviceOnline",
+          {{"user_id", id},
+           {"response", tunnelbroker::CheckResponseType_Name(type)}});
     }
+    response->set_checkresponsetype(type);
+    this->checkMetrics.record(start, true);
+    reactor->Finish(grpc::Status::OK);
+  };
+  // counted before the check as the pong may answer it right away
+  this->waitingChecks.add(1);
+  const PrimaryCheck check = this->primaries.check(
+      id,
+      deviceToken,
+      this->livenessTtl,
+      [this, answer, start](ping::ClientState state) {
+        this->waitingChecks.add(-1);
+        this->pingWait.observeSince(start);
+        answer(
+            (state == ping::ClientState::ONLINE)
+                ? tunnelbroker::CheckResponseType::PRIMARY_ONLINE
+                : tunnelbroker::CheckResponseType::PRIMARY_OFFLINE);
+      });
+  if (check.status != PrimaryStatus::WAITING) {
+    this->waitingChecks.add(-1);
   }
 
-  return grpc::Status::OK;
+  switch (check.status) {
+    case PrimaryStatus::DOESNT_EXIST:
+      answer(tunnelbroker::CheckResponseType::PRIMARY_DOESNT_EXIST);
+      return reactor;
+    case PrimaryStatus::CURRENT_IS_PRIMARY:
+      answer(tunnelbroker::CheckResponseType::CURRENT_IS_PRIMARY);
+      return reactor;
+    case PrimaryStatus::ONLINE:
+      answer(tunnelbroker::CheckResponseType::PRIMARY_ONLINE);
+      return reactor;
+    case PrimaryStatus::WAITING:
+      break;
+  }
+  if (!check.startPing) {
+    return reactor;
+  }
+  // a device with an open channel gets pinged right away, otherwise the
+  // check waits for a pong sent with SendPong
+  // TODO: the background notif should be sent what cannot be really
+  // simulated here I believe
+  if (check.channel != nullptr) {
+    check.channel->ping();
+  }
+  const uint64_t pingId = check.pingId;
+  this->timer.schedule(PING_TIMEOUT, [this, id, pingId]() {
+    this->primaries.expirePing(id, pingId);
+  });
+  return reactor;
 }
 
-grpc::Status TunnelBrokerServiceImpl::BecomeNewPrimaryDevice(
-    grpc::ServerContext *context,
+grpc::ServerUnaryReactor *TunnelBrokerServiceImpl::BecomeNewPrimaryDevice(
+    grpc::CallbackServerContext *context,
     const tunnelbroker::NewPrimaryRequest *request,
     tunnelbroker::NewPrimaryResponse *response) {
+  const std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  grpc::ServerUnaryReactor *reactor = context->DefaultReactor();
+  if (this->forward(
+          context,
+          reactor,
+          request,
+          response,
+          &tunnelbroker::TunnelBrokerService::Stub::async::
+              BecomeNewPrimaryDevice,
+          this->becomePrimaryMetrics)) {
+    return reactor;
+  }
   const std::string id = request->userid();
   const std::string deviceToken = request->devicetoken();
 
-  std::shared_ptr<ping::ClientData> clientData =
-      std::make_shared<ping::ClientData>(id, deviceToken);
-  auto iterator = primaries.find(id);
-  if (iterator == primaries.end()) {
-    primaries.insert_or_assign(id, clientData);
-    response->set_success(true);
-    return grpc::Status::OK;
-  }
-  if (iterator->second->deviceToken == deviceToken) {
-    response->set_success(true);
-    return grpc::Status::OK;
-  }
-
-  if (iterator->second->lastState == ping::ClientState::ONLINE) {
-    response->set_success(false);
-  } else {
-    primaries.insert_or_assign(id, clientData);
-    response->set_success(true);
-  }
-
-  return grpc::Status::OK;
+  const bool success = this->primaries.becomePrimary(id, deviceToken);
+  Logger::getInstance().info(
+      "BecomeNewPrimaryDevice", {{"user_id", id}, {"success", success}});
+  response->set_success(success);
+  this->becomePrimaryMetrics.record(start, true);
+  reactor->Finish(grpc::Status::OK);
+  return reactor;
 }
 
-grpc::Status TunnelBrokerServiceImpl::SendPong(
-    grpc::ServerContext *context,
+grpc::ServerUnaryReactor *TunnelBrokerServiceImpl::SendPong(
+    grpc::CallbackServerContext *context,
     const tunnelbroker::PongRequest *request,
     google::protobuf::Empty *response) {
+  const std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  grpc::ServerUnaryReactor *reactor = context->DefaultReactor();
+  if (this->forward(
+          context,
+          reactor,
+          request,
+          response,
+          &tunnelbroker::TunnelBrokerService::Stub::async::SendPong,
+          this->pongMetrics)) {
+    return reactor;
+  }
   const std::string id = request->userid();
   const std::string deviceToken = request->devicetoken();
 
-  auto iterator = primaries.find(id);
-
-  if (iterator == primaries.end() ||
-      iterator->second->deviceToken != deviceToken) {
-    return grpc::Status::OK;
-  }
-
-  if (!iterator->second->pingRequests.isEmpty()) {
-    bool value;
-    iterator->second->pingRequests.blockingRead(value);
-    iterator->second->pingResponses.write(true);
-  }
+  this->primaries.markSeen(id, deviceToken);
+  this->pongMetrics.record(start, true);
+  reactor->Finish(grpc::Status::OK);
+  return reactor;
+}
 
-  return grpc::Status::OK;
+grpc::ServerBidiReactor<
+    tunnelbroker::DeviceMessage,
+    tunnelbroker::ServerMessage> *
+TunnelBrokerServiceImpl::OpenDeviceChannel(
+    grpc::CallbackServerContext *context) {
+  return DeviceChannel::create(context, this->primaries, this->cluster);
 }
 
 } // namespace network
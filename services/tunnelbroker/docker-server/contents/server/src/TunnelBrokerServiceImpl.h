@@ -1,38 +1,92 @@
 #pragma once
 
+#include <chrono>
+#include <functional>
 #include <memory>
 #include <string>
-
-#include <folly/concurrency/ConcurrentHashMap.h>
+#include <vector>
 
 #include <grpcpp/grpcpp.h>
 
 #include "../_generated/tunnelbroker.grpc.pb.h"
 #include "../_generated/tunnelbroker.pb.h"
 
+#include "Cluster.h"
+#include "DeviceChannel.h"
+#include "Metrics.h"
+#include "PrimariesRegistry.h"
+#include "Timer.h"
 #include "Tools.h"
 
 namespace comm {
 namespace network {
 
+/**
+ * The RPCs are served with the callback API. A check of an online primary
+ * waits for the pong without holding any thread, it's completed by a pong
+ * (sent on the device channel or with SendPong) or by the timer when the ping
+ * times out.
+ *
+ * With peers configured, the requests for the users owned by other instances
+ * are forwarded to them (the device channels are redirected instead).
+ */
 class TunnelBrokerServiceImpl final
-    : public tunnelbroker::TunnelBrokerService::Service {
-  folly::ConcurrentHashMap<std::string, std::shared_ptr<ping::ClientData>>
-      primaries;
+    : public tunnelbroker::TunnelBrokerService::CallbackService {
+  PrimariesRegistry primaries;
+  // checks of a device seen within this window don't ping it
+  const std::chrono::milliseconds livenessTtl;
+  Timer timer;
+  Cluster cluster;
+
+  RpcMetrics checkMetrics;
+  RpcMetrics becomePrimaryMetrics;
+  RpcMetrics pongMetrics;
+  // the checks waiting for a pong and how long they waited
+  Gauge &waitingChecks;
+  Histogram &pingWait;
+  Counter &forwardedRequests;
+
+  // returns false if the request should be served here, otherwise the owner's
+  // response finishes the reactor, forwarded requests without the cluster's
+  // secret are rejected
+  template <class Request, class Response>
+  bool forward(
+      grpc::CallbackServerContext *context,
+      grpc::ServerUnaryReactor *reactor,
+      const Request *request,
+      Response *response,
+      void (tunnelbroker::TunnelBrokerService::Stub::async::*method)(
+          grpc::ClientContext *,
+          const Request *,
+          Response *,
+          std::function<void(grpc::Status)>),
+      RpcMetrics &metrics);
 
 public:
-  grpc::Status CheckIfPrimaryDeviceOnline(
-      grpc::ServerContext *context,
+  TunnelBrokerServiceImpl(
+      const std::chrono::milliseconds livenessTtl = DEFAULT_LIVENESS_TTL,
+      const std::string &selfAddress = "",
+      const std::vector<std::string> &peers = {},
+      const std::string &clusterSecret = "");
+
+  PrimariesRegistry &getPrimaries();
+
+  grpc::ServerUnaryReactor *CheckIfPrimaryDeviceOnline(
+      grpc::CallbackServerContext *context,
       const tunnelbroker::CheckRequest *request,
       tunnelbroker::CheckResponse *response) override;
-  grpc::Status BecomeNewPrimaryDevice(
-      grpc::ServerContext *context,
+  grpc::ServerUnaryReactor *BecomeNewPrimaryDevice(
+      grpc::CallbackServerContext *context,
       const tunnelbroker::NewPrimaryRequest *request,
       tunnelbroker::NewPrimaryResponse *response) override;
-  grpc::Status SendPong(
-      grpc::ServerContext *context,
+  grpc::ServerUnaryReactor *SendPong(
+      grpc::CallbackServerContext *context,
       const tunnelbroker::PongRequest *request,
       google::protobuf::Empty *response) override;
+  grpc::ServerBidiReactor<
+      tunnelbroker::DeviceMessage,
+      tunnelbroker::ServerMessage> *
+  OpenDeviceChannel(grpc::CallbackServerContext *context) override;
 };
 
 } // namespace network
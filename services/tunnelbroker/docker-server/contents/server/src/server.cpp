@@ -1,28 +1,162 @@
+#include "Logger.h"
+#include "Metrics.h"
+#include "MetricsServer.h"
 #include "TunnelBrokerServiceImpl.h"
 
 #include <grpcpp/grpcpp.h>
 
-#include <iostream>
+#include <sys/stat.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
 #include <memory>
+#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <thread>
+#include <vector>
 
 namespace comm {
 namespace network {
 
+uint64_t getEnvNumber(const char *name, const uint64_t defaultValue) {
+  const char *value = std::getenv(name);
+  if (value == nullptr || *value == '\0') {
+    return defaultValue;
+  }
+  return std::stoull(value);
+}
+
+std::string getEnvString(const char *name, const std::string &defaultValue) {
+  const char *value = std::getenv(name);
+  if (value == nullptr || *value == '\0') {
+    return defaultValue;
+  }
+  return value;
+}
+
+// the addresses of all the instances (this one included), comma separated
+std::vector<std::string> getPeers() {
+  std::vector<std::string> peers;
+  std::stringstream stream(getEnvString("COMM_TUNNELBROKER_PEERS", ""));
+  std::string peer;
+  while (std::getline(stream, peer, ',')) {
+    if (!peer.empty()) {
+      peers.push_back(peer);
+    }
+  }
+  return peers;
+}
+
+void restoreSnapshot(PrimariesRegistry &primaries, const std::string &path) {
+  struct stat fileStat;
+  // there's nothing to restore on the first start
+  if (stat(path.c_str(), &fileStat) != 0 && errno == ENOENT) {
+    return;
+  }
+  try {
+    const auto start = std::chrono::steady_clock::now();
+    const size_t restored = primaries.loadSnapshot(path);
+    const std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    Logger::getInstance().info(
+        "snapshot restored",
+        {{"primaries", restored}, {"elapsed_ms", elapsed.count()}});
+  } catch (std::runtime_error &e) {
+    Logger::getInstance().error(
+        "snapshot restore failed", {{"path", path}, {"error", e.what()}});
+  }
+}
+
+// evicts the idle devices and snapshots the rest periodically, it runs for
+// the whole lifetime of the server
+void startMaintenance(
+    PrimariesRegistry &primaries,
+    const std::chrono::seconds interval,
+    const std::chrono::seconds idleTtl,
+    const std::string snapshotPath) {
+  Gauge &primariesCount = MetricsRegistry::getInstance().getGauge(
+      "tunnelbroker_primaries",
+      "The primary devices registered, updated by the maintenance.");
+  std::thread([&primaries, &primariesCount, interval, idleTtl, snapshotPath]() {
+    while (true) {
+      std::this_thread::sleep_for(interval);
+      try {
+        primaries.evictIdle(idleTtl);
+        primariesCount.set(primaries.size());
+        if (!snapshotPath.empty()) {
+          primaries.saveSnapshot(snapshotPath);
+        }
+      } catch (std::runtime_error &e) {
+        Logger::getInstance().error(
+            "maintenance failed", {{"error", e.what()}});
+      }
+    }
+  }).detach();
+}
+
+// COMM_TUNNELBROKER_LOG_PAYLOADS set to 1 logs the data of the requests
+LoggerConfig getLoggerConfig() {
+  LoggerConfig config;
+  config.level =
+      parseLogLevel(getEnvString("COMM_TUNNELBROKER_LOG_LEVEL", "info"));
+  config.sampleEvery =
+      getEnvNumber("COMM_TUNNELBROKER_LOG_SAMPLE_EVERY", config.sampleEvery);
+  config.maxRecordsPerSecond = getEnvNumber(
+      "COMM_TUNNELBROKER_LOG_MAX_RECORDS_PER_SECOND",
+      config.maxRecordsPerSecond);
+  config.logPayloads = getEnvNumber("COMM_TUNNELBROKER_LOG_PAYLOADS", 0) != 0;
+  return config;
+}
+
 void RunServer() {
-  std::string server_address = "0.0.0.0:50051";
-  TunnelBrokerServiceImpl service;
+  Logger::getInstance().configure(getLoggerConfig());
+  std::string server_address =
+      getEnvString("COMM_TUNNELBROKER_LISTEN_ADDRESS", "0.0.0.0:50051");
+  // COMM_TUNNELBROKER_LIVENESS_TTL_MS set to 0 makes every check ping
+  TunnelBrokerServiceImpl service(
+      std::chrono::milliseconds(getEnvNumber(
+          "COMM_TUNNELBROKER_LIVENESS_TTL_MS", DEFAULT_LIVENESS_TTL.count())),
+      getEnvString("COMM_TUNNELBROKER_SELF_ADDRESS", ""),
+      getPeers(),
+      // required with peers, forwarded requests carry it
+      getEnvString("COMM_TUNNELBROKER_CLUSTER_SECRET", ""));
+
+  // the snapshots are disabled unless a path is given
+  const std::string snapshotPath =
+      getEnvString("COMM_TUNNELBROKER_SNAPSHOT_PATH", "");
+  if (!snapshotPath.empty()) {
+    restoreSnapshot(service.getPrimaries(), snapshotPath);
+  }
+  startMaintenance(
+      service.getPrimaries(),
+      std::chrono::seconds(getEnvNumber(
+          "COMM_TUNNELBROKER_MAINTENANCE_INTERVAL_S",
+          DEFAULT_MAINTENANCE_INTERVAL.count())),
+      std::chrono::seconds(getEnvNumber(
+          "COMM_TUNNELBROKER_IDLE_TTL_S", DEFAULT_IDLE_TTL.count())),
+      snapshotPath);
+
+  // the metrics are served over HTTP unless the port is 0
+  std::unique_ptr<MetricsServer> metricsServer;
+  const uint64_t metricsPort =
+      getEnvNumber("COMM_TUNNELBROKER_METRICS_PORT", 0);
+  if (metricsPort != 0) {
+    metricsServer = std::make_unique<MetricsServer>("0.0.0.0", metricsPort);
+  }
 
   grpc::EnableDefaultHealthCheckService(true);
   grpc::ServerBuilder builder;
   // Listen on the given address without any authentication mechanism.
   builder.AddListeningPort(server_address, grpc::InsecureServerCredentials());
   // Register "service" as the instance through which we'll communicate with
-  // clients. In this case it corresponds to an *synchronous* service.
+  // clients. In this case it corresponds to a *callback* service.
   builder.RegisterService(&service);
   // Finally assemble the server.
   std::unique_ptr<grpc::Server> server(builder.BuildAndStart());
-  std::cout << "Server listening" << std::endl;
+  Logger::getInstance().info(
+      "Server listening", {{"address", server_address}});
 
   // Wait for the server to shutdown. Note that some other thread must be
   // responsible for shutting down the server for this call to ever return.
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+
+#include "Cluster.h"
+#include "HashRing.h"
+#include "TunnelBrokerServiceImpl.h"
+
+#include <grpcpp/grpcpp.h>
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace comm::network;
+
+// three instances in the same process, each of them with its own server
+class ClusterTest : public testing::Test {
+protected:
+  const std::string secret = "cluster-test-secret";
+  const std::vector<std::string> peers = {
+      "127.0.0.1:50161",
+      "127.0.0.1:50162",
+      "127.0.0.1:50163",
+  };
+  std::vector<std::unique_ptr<TunnelBrokerServiceImpl>> services;
+  std::vector<std::unique_ptr<grpc::Server>> servers;
+
+  virtual void SetUp() {
+    for (const std::string &peer : peers) {
+      services.push_back(std::make_unique<TunnelBrokerServiceImpl>(
+          DEFAULT_LIVENESS_TTL, peer, peers, secret));
+      grpc::ServerBuilder builder;
+      builder.AddListeningPort(peer, grpc::InsecureServerCredentials());
+      builder.RegisterService(services.back().get());
+      servers.push_back(builder.BuildAndStart());
+      ASSERT_NE(servers.back(), nullptr);
+    }
+  }
+
+  virtual void TearDown() {
+    for (std::unique_ptr<grpc::Server> &server : servers) {
+      server->Shutdown();
+    }
+    servers.clear();
+    services.clear();
+  }
+
+  std::unique_ptr<tunnelbroker::TunnelBrokerService::Stub>
+  connect(const size_t instance) {
+    return tunnelbroker::TunnelBrokerService::NewStub(grpc::CreateChannel(
+        peers.at(instance), grpc::InsecureChannelCredentials()));
+  }
+
+  size_t getInstance(const std::string &address) {
+    return std::find(peers.begin(), peers.end(), address) - peers.begin();
+  }
+
+  grpc::Status becomePrimary(
+      const size_t instance,
+      const std::string &userId,
+      const std::string &forwarded = "") {
+    grpc::ClientContext context;
+    if (!forwarded.empty()) {
+      context.AddMetadata(FORWARDED_METADATA, forwarded);
+    }
+    tunnelbroker::NewPrimaryRequest request;
+    request.set_userid(userId);
+    request.set_devicetoken("device-" + userId);
+    tunnelbroker::NewPrimaryResponse response;
+    return connect(instance)->BecomeNewPrimaryDevice(
+        &context, request, &response);
+  }
+};
+
+TEST_F(ClusterTest, RequestsAreServedByTheOwner) {
+  HashRing ring(peers);
+  std::vector<size_t> owned(peers.size(), 0);
+  for (size_t i = 0; i < 30; ++i) {
+    const std::string userId = "user-" + std::to_string(i);
+    ++owned[getInstance(ring.getOwner(userId))];
+    EXPECT_TRUE(becomePrimary(i % peers.size(), userId).ok());
+  }
+  for (size_t i = 0; i < peers.size(); ++i) {
+    EXPECT_EQ(services[i]->getPrimaries().size(), owned[i]);
+  }
+
+  // a check sent to another instance reaches the same owner
+  const std::string userId = "user-0";
+  const size_t other =
+      (getInstance(ring.getOwner(userId)) + 1) % peers.size();
+  grpc::ClientContext context;
+  tunnelbroker::CheckRequest request;
+  request.set_userid(userId);
+  request.set_devicetoken("device-" + userId);
+  tunnelbroker::CheckResponse response;
+  ASSERT_TRUE(connect(other)
+                  ->CheckIfPrimaryDeviceOnline(&context, request, &response)
+                  .ok());
+  EXPECT_EQ(
+      response.checkresponsetype(),
+      tunnelbroker::CheckResponseType::CURRENT_IS_PRIMARY);
+}
+
+TEST_F(ClusterTest, ForgedForwardedRequestIsRejected) {
+  const std::string userId = "user-0";
+  const size_t other =
+      (getInstance(HashRing(peers).getOwner(userId)) + 1) % peers.size();
+
+  const grpc::Status status = becomePrimary(other, userId, "1");
+  EXPECT_EQ(status.error_code(), grpc::StatusCode::PERMISSION_DENIED);
+  for (const std::unique_ptr<TunnelBrokerServiceImpl> &service : services) {
+    EXPECT_EQ(service->getPrimaries().size(), 0);
+  }
+
+  // a request forwarded by an instance is served where it arrives
+  EXPECT_TRUE(becomePrimary(other, userId, secret).ok());
+  EXPECT_EQ(services[other]->getPrimaries().size(), 1);
+}
+
+TEST_F(ClusterTest, PeersRequireASecret) {
+  EXPECT_THROW(Cluster(peers[0], peers), std::runtime_error);
+  Cluster cluster(peers[0], peers, secret);
+  EXPECT_TRUE(cluster.isForwardedByPeer(secret));
+  EXPECT_FALSE(cluster.isForwardedByPeer("1"));
+  EXPECT_FALSE(cluster.isForwardedByPeer(""));
+  EXPECT_FALSE(Cluster().isForwardedByPeer(""));
+}
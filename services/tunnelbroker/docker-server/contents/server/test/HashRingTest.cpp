@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#include "HashRing.h"
+
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace comm::network;
+
+class HashRingTest : public testing::Test {
+protected:
+  const size_t keysCount = 100000;
+  const std::vector<std::string> nodes = {
+      "tunnelbroker-0:50051",
+      "tunnelbroker-1:50051",
+      "tunnelbroker-2:50051",
+  };
+
+  std::string getKey(const size_t i) {
+    return std::to_string(100000 + i);
+  }
+};
+
+TEST_F(HashRingTest, TheSameNodesGiveTheSameOwners) {
+  const HashRing ring(this->nodes);
+  const HashRing reordered({this->nodes[2], this->nodes[0], this->nodes[1]});
+  for (size_t i = 0; i < 1000; ++i) {
+    const std::string key = this->getKey(i);
+    EXPECT_EQ(ring.getOwner(key), reordered.getOwner(key));
+  }
+}
+
+TEST_F(HashRingTest, KeysAreSpreadEvenly) {
+  const HashRing ring(this->nodes);
+  std::map<std::string, size_t> counts;
+  for (size_t i = 0; i < this->keysCount; ++i) {
+    ++counts[ring.getOwner(this->getKey(i))];
+  }
+  ASSERT_EQ(counts.size(), this->nodes.size());
+  const size_t expected = this->keysCount / this->nodes.size();
+  for (const auto &count : counts) {
+    EXPECT_GT(count.second, expected * 8 / 10) << count.first;
+    EXPECT_LT(count.second, expected * 12 / 10) << count.first;
+  }
+}
+
+TEST_F(HashRingTest, AddingANodeOnlyMovesKeysToIt) {
+  const HashRing ring(this->nodes);
+  std::vector<std::string> grownNodes = this->nodes;
+  grownNodes.push_back("tunnelbroker-3:50051");
+  const HashRing grown(grownNodes);
+
+  size_t moved = 0;
+  for (size_t i = 0; i < this->keysCount; ++i) {
+    const std::string &before = ring.getOwner(this->getKey(i));
+    const std::string &after = grown.getOwner(this->getKey(i));
+    if (before != after) {
+      EXPECT_EQ(after, grownNodes.back());
+      ++moved;
+    }
+  }
+  const size_t expected = this->keysCount / grownNodes.size();
+  EXPECT_GT(moved, expected * 8 / 10);
+  EXPECT_LT(moved, expected * 12 / 10);
+}
+
+TEST_F(HashRingTest, NodesHaveToBeUnique) {
+  EXPECT_THROW(HashRing({}), std::runtime_error);
+  EXPECT_THROW(
+      HashRing({this->nodes[0], this->nodes[1], this->nodes[0]}),
+      std::runtime_error);
+}
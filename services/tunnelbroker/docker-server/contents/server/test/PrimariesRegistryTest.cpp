@@ -0,0 +1,321 @@
+#include <gtest/gtest.h>
+
+#include "PrimariesRegistry.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace comm::network;
+
+class PrimariesRegistryTest : public testing::Test {
+protected:
+  const std::chrono::milliseconds ttl = std::chrono::seconds(10);
+  PrimariesRegistry registry;
+  std::vector<ping::ClientState> answers;
+
+  const std::string snapshotPath = "/tmp/comm-primaries-test.snapshot";
+
+  void TearDown() override {
+    std::remove(this->snapshotPath.c_str());
+  }
+
+  PrimaryCheck check(
+      const std::string &deviceToken,
+      const std::chrono::milliseconds livenessTtl) {
+    return this->registry.check(
+        "user", deviceToken, livenessTtl, [this](ping::ClientState state) {
+          this->answers.push_back(state);
+        });
+  }
+
+  // all the devices try to become the primary of the user at once, returns
+  // the tokens of the winners
+  std::vector<std::string>
+  elect(const std::string &id, const size_t devicesCount) {
+    std::atomic<bool> started{false};
+    std::vector<char> won(devicesCount, false);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < devicesCount; ++i) {
+      threads.emplace_back([this, &id, &started, &won, i]() {
+        while (!started) {
+          std::this_thread::yield();
+        }
+        won[i] = this->registry.becomePrimary(id, std::to_string(i));
+      });
+    }
+    started = true;
+    for (std::thread &thread : threads) {
+      thread.join();
+    }
+    std::vector<std::string> winners;
+    for (size_t i = 0; i < devicesCount; ++i) {
+      if (won[i]) {
+        winners.push_back(std::to_string(i));
+      }
+    }
+    return winners;
+  }
+};
+
+TEST_F(PrimariesRegistryTest, FirstDeviceBecomesPrimary) {
+  EXPECT_EQ(this->check("device", ttl).status, PrimaryStatus::DOESNT_EXIST);
+  EXPECT_TRUE(this->registry.becomePrimary("user", "device"));
+  EXPECT_TRUE(this->registry.becomePrimary("user", "device"));
+  EXPECT_EQ(
+      this->check("device", ttl).status, PrimaryStatus::CURRENT_IS_PRIMARY);
+  EXPECT_EQ(this->registry.size(), 1);
+}
+
+TEST_F(PrimariesRegistryTest, FreshPrimaryIsOnlineWithoutPing) {
+  this->registry.becomePrimary("user", "primary");
+  this->registry.markSeen("user", "primary");
+
+  const PrimaryCheck check = this->check("other", ttl);
+  EXPECT_EQ(check.status, PrimaryStatus::ONLINE);
+  EXPECT_FALSE(check.startPing);
+  EXPECT_TRUE(this->answers.empty());
+}
+
+TEST_F(PrimariesRegistryTest, StalePrimaryGetsPinged) {
+  this->registry.becomePrimary("user", "primary");
+  this->registry.markSeen("user", "primary");
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+  const PrimaryCheck check =
+      this->check("other", std::chrono::milliseconds(10));
+  EXPECT_EQ(check.status, PrimaryStatus::WAITING);
+  EXPECT_TRUE(check.startPing);
+}
+
+TEST_F(PrimariesRegistryTest, ConcurrentChecksShareThePing) {
+  this->registry.becomePrimary("user", "primary");
+
+  const PrimaryCheck first = this->check("other", ttl);
+  const PrimaryCheck second = this->check("other", ttl);
+  EXPECT_TRUE(first.startPing);
+  EXPECT_FALSE(second.startPing);
+  EXPECT_TRUE(this->answers.empty());
+
+  EXPECT_TRUE(this->registry.markSeen("user", "primary"));
+  EXPECT_EQ(
+      this->answers,
+      std::vector<ping::ClientState>(2, ping::ClientState::ONLINE));
+}
+
+TEST_F(PrimariesRegistryTest, PongFromOtherDeviceIsIgnored) {
+  this->registry.becomePrimary("user", "primary");
+  this->check("other", ttl);
+
+  EXPECT_FALSE(this->registry.markSeen("user", "other"));
+  EXPECT_TRUE(this->answers.empty());
+}
+
+TEST_F(PrimariesRegistryTest, ExpiredPingLetsAnotherDeviceTakeOver) {
+  this->registry.becomePrimary("user", "primary");
+  const PrimaryCheck check = this->check("other", ttl);
+  EXPECT_FALSE(this->registry.becomePrimary("user", "other"));
+
+  this->registry.expirePing("user", check.pingId);
+  EXPECT_EQ(
+      this->answers,
+      std::vector<ping::ClientState>({ping::ClientState::OFFLINE}));
+  EXPECT_TRUE(this->registry.becomePrimary("user", "other"));
+  EXPECT_EQ(
+      this->check("other", ttl).status, PrimaryStatus::CURRENT_IS_PRIMARY);
+}
+
+TEST_F(PrimariesRegistryTest, StaleExpiryDoesNotTouchNewerPing) {
+  this->registry.becomePrimary("user", "primary");
+  const PrimaryCheck stale = this->check("other", ttl);
+  this->registry.markSeen("user", "primary");
+  this->answers.clear();
+
+  const PrimaryCheck fresh = this->check("other", std::chrono::milliseconds(0));
+  EXPECT_TRUE(fresh.startPing);
+  EXPECT_NE(fresh.pingId, stale.pingId);
+
+  this->registry.expirePing("user", stale.pingId);
+  EXPECT_TRUE(this->answers.empty());
+  EXPECT_FALSE(this->registry.becomePrimary("user", "other"));
+}
+
+TEST_F(PrimariesRegistryTest, ReplacedPrimaryAnswersItsWaitersOffline) {
+  this->registry.becomePrimary("user", "primary");
+  const PrimaryCheck first = this->check("other", ttl);
+  this->registry.expirePing("user", first.pingId);
+  this->answers.clear();
+
+  // a new ping is in flight when the primary gets replaced
+  this->check("third", ttl);
+  EXPECT_TRUE(this->registry.becomePrimary("user", "other"));
+  EXPECT_EQ(
+      this->answers,
+      std::vector<ping::ClientState>({ping::ClientState::OFFLINE}));
+}
+
+TEST_F(PrimariesRegistryTest, ConcurrentElectionHasExactlyOneWinner) {
+  for (size_t round = 0; round < 200; ++round) {
+    const std::string id = "user-" + std::to_string(round);
+    const std::vector<std::string> winners = this->elect(id, 16);
+    ASSERT_EQ(winners.size(), 1) << "round " << round;
+
+    const PrimaryCheck check =
+        this->registry.check(id, winners[0], ttl, [](ping::ClientState) {});
+    EXPECT_EQ(check.status, PrimaryStatus::CURRENT_IS_PRIMARY);
+  }
+}
+
+TEST_F(PrimariesRegistryTest, ConcurrentTakeoverHasExactlyOneWinner) {
+  for (size_t round = 0; round < 200; ++round) {
+    const std::string id = "user-" + std::to_string(round);
+    this->registry.becomePrimary(id, "primary");
+    const PrimaryCheck check =
+        this->registry.check(id, "other", ttl, [](ping::ClientState) {});
+    this->registry.expirePing(id, check.pingId);
+
+    const std::vector<std::string> winners = this->elect(id, 16);
+    ASSERT_EQ(winners.size(), 1) << "round " << round;
+    EXPECT_FALSE(this->registry.becomePrimary(id, "primary"));
+  }
+}
+
+TEST_F(PrimariesRegistryTest, EvictsIdleDevicesOnly) {
+  this->registry.becomePrimary("user", "primary");
+  this->registry.becomePrimary("other-user", "device");
+
+  EXPECT_EQ(this->registry.evictIdle(std::chrono::hours(1)), 0);
+  EXPECT_EQ(this->registry.size(), 2);
+
+  // the device with a check waiting is kept
+  this->check("other", ttl);
+  EXPECT_EQ(this->registry.evictIdle(std::chrono::seconds(0)), 1);
+  EXPECT_EQ(this->registry.size(), 1);
+  EXPECT_EQ(this->check("other", ttl).status, PrimaryStatus::WAITING);
+}
+
+TEST_F(PrimariesRegistryTest, SnapshotRestoresDevices) {
+  const size_t usersCount = 1000;
+  for (size_t i = 0; i < usersCount; ++i) {
+    this->registry.becomePrimary(
+        "user-" + std::to_string(i), "device-" + std::to_string(i));
+  }
+  // an offline primary has to stay replaceable after a restart
+  this->registry.becomePrimary("user", "primary");
+  this->registry.expirePing("user", this->check("other", ttl).pingId);
+  this->registry.saveSnapshot(this->snapshotPath);
+
+  PrimariesRegistry restored;
+  restored.becomePrimary("user-0", "newer-device");
+  EXPECT_EQ(restored.loadSnapshot(this->snapshotPath), usersCount);
+  EXPECT_EQ(restored.size(), usersCount + 1);
+
+  const PrimaryCheck restoredCheck = restored.check(
+      "user-1", "device-1", ttl, [](ping::ClientState) {});
+  EXPECT_EQ(restoredCheck.status, PrimaryStatus::CURRENT_IS_PRIMARY);
+  // the devices present before loading are kept
+  const PrimaryCheck keptCheck = restored.check(
+      "user-0", "newer-device", ttl, [](ping::ClientState) {});
+  EXPECT_EQ(keptCheck.status, PrimaryStatus::CURRENT_IS_PRIMARY);
+  EXPECT_TRUE(restored.becomePrimary("user", "other"));
+  EXPECT_FALSE(restored.becomePrimary("user-2", "other"));
+}
+
+TEST_F(PrimariesRegistryTest, EmptySnapshotRoundTrip) {
+  this->registry.saveSnapshot(this->snapshotPath);
+  PrimariesRegistry restored;
+  EXPECT_EQ(restored.loadSnapshot(this->snapshotPath), 0);
+  EXPECT_EQ(restored.size(), 0);
+}
+
+TEST_F(PrimariesRegistryTest, DamagedSnapshotIsRejected) {
+  this->registry.becomePrimary("user", "primary");
+  this->registry.saveSnapshot(this->snapshotPath);
+
+  std::string content;
+  {
+    std::ifstream file(this->snapshotPath, std::ios::binary);
+    content.assign(
+        std::istreambuf_iterator<char>(file),
+        std::istreambuf_iterator<char>());
+  }
+  {
+    std::ofstream file(this->snapshotPath, std::ios::binary);
+    file << content.substr(0, content.size() - 8);
+  }
+  PrimariesRegistry truncated;
+  EXPECT_THROW(
+      truncated.loadSnapshot(this->snapshotPath), std::runtime_error);
+
+  {
+    std::ofstream file(this->snapshotPath, std::ios::binary);
+    file << std::string(content.size(), 'x');
+  }
+  PrimariesRegistry garbage;
+  EXPECT_THROW(garbage.loadSnapshot(this->snapshotPath), std::runtime_error);
+
+  PrimariesRegistry missing;
+  EXPECT_THROW(
+      missing.loadSnapshot(this->snapshotPath + ".missing"),
+      std::runtime_error);
+}
+
+TEST_F(PrimariesRegistryTest, CraftedSnapshotIsRejectedWhole) {
+  const size_t usersCount = 1000;
+  for (size_t i = 0; i < usersCount; ++i) {
+    this->registry.becomePrimary(
+        "user-" + std::to_string(i), "device-" + std::to_string(i));
+  }
+  this->registry.saveSnapshot(this->snapshotPath);
+
+  std::string content;
+  {
+    std::ifstream file(this->snapshotPath, std::ios::binary);
+    content.assign(
+        std::istreambuf_iterator<char>(file),
+        std::istreambuf_iterator<char>());
+  }
+  // the header is the magic, the version and the shards count, followed by
+  // the index of the sections
+  const size_t indexOffset = 16;
+  uint32_t shardsCount;
+  std::memcpy(&shardsCount, &content[12], sizeof(shardsCount));
+  auto getOffset = [&content, indexOffset](const size_t i) {
+    uint64_t offset;
+    std::memcpy(&offset, &content[indexOffset + i * 8], sizeof(offset));
+    return offset;
+  };
+  // loads the snapshot changed at the position, nothing may be restored
+  auto expectRejected = [this, &content](size_t position, uint64_t value) {
+    std::string crafted = content;
+    std::memcpy(&crafted[position], &value, sizeof(value));
+    {
+      std::ofstream file(this->snapshotPath, std::ios::binary);
+      file << crafted;
+    }
+    PrimariesRegistry restored;
+    EXPECT_THROW(restored.loadSnapshot(this->snapshotPath), std::runtime_error);
+    EXPECT_EQ(restored.size(), 0);
+  };
+
+  // a section inside the header or the index
+  expectRejected(indexOffset, 0);
+  expectRejected(indexOffset, indexOffset);
+  // a misaligned section
+  expectRejected(indexOffset + 8, getOffset(1) + 4);
+  // sections out of order
+  expectRejected(indexOffset + 8, getOffset(2) + 8);
+  // a section past the end of the file
+  expectRejected(indexOffset + 8, content.size() + 8);
+  // a record pointing past the strings of the last section, the others are
+  // valid but none of them is restored
+  const uint64_t lastSection = getOffset(shardsCount - 1);
+  expectRejected(lastSection + 16, UINT32_MAX);
+}
@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+
+#include "Timer.h"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace comm::network;
+
+class TimerTest : public testing::Test {};
+
+TEST_F(TimerTest, RunsTasksInDeadlineOrder) {
+  Timer timer;
+  std::mutex mutex;
+  std::vector<int> order;
+  std::promise<void> done;
+
+  timer.schedule(std::chrono::milliseconds(60), [&]() {
+    std::lock_guard<std::mutex> lock(mutex);
+    order.push_back(3);
+    done.set_value();
+  });
+  timer.schedule(std::chrono::milliseconds(20), [&]() {
+    std::lock_guard<std::mutex> lock(mutex);
+    order.push_back(1);
+  });
+  timer.schedule(std::chrono::milliseconds(40), [&]() {
+    std::lock_guard<std::mutex> lock(mutex);
+    order.push_back(2);
+  });
+
+  ASSERT_EQ(
+      done.get_future().wait_for(std::chrono::seconds(5)),
+      std::future_status::ready);
+  std::lock_guard<std::mutex> lock(mutex);
+  EXPECT_EQ(order, std::vector<int>({1, 2, 3}));
+}
+
+TEST_F(TimerTest, DoesNotRunTasksBeforeTheirDeadline) {
+  Timer timer;
+  std::promise<std::chrono::steady_clock::time_point> fired;
+  const std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+
+  timer.schedule(std::chrono::milliseconds(50), [&]() {
+    fired.set_value(std::chrono::steady_clock::now());
+  });
+
+  EXPECT_GE(fired.get_future().get() - start, std::chrono::milliseconds(50));
+}
+
+TEST_F(TimerTest, DropsPendingTasksOnDestruction) {
+  std::atomic<bool> ran{false};
+  {
+    Timer timer;
+    timer.schedule(std::chrono::hours(1), [&]() { ran = true; });
+  }
+  EXPECT_FALSE(ran);
+}